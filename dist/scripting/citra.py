@@ -7,9 +7,13 @@ CURRENT_REQUEST_VERSION = 1
 MAX_REQUEST_DATA_SIZE = 32
 MAX_PACKET_SIZE = 48
 
+MAX_READ_COUNTERS = MAX_REQUEST_DATA_SIZE // 8 - 1
+
 class RequestType(enum.IntEnum):
     ReadMemory = 1,
-    WriteMemory = 2
+    WriteMemory = 2,
+    ReadCounters = 3,
+    ReadCounterName = 4
 
 CITRA_PORT = 45987
 
@@ -90,6 +94,51 @@ class Citra:
                 return False
         return True
 
+    def _request(self, request_type, request_data):
+        request, request_id = self._generate_header(request_type, len(request_data))
+        request += request_data
+        self.socket.sendto(request, (self.address, CITRA_PORT))
+
+        raw_reply = self.socket.recv(MAX_PACKET_SIZE)
+        return self._read_and_validate_header(raw_reply, request_id, request_type)
+
+    def counter_names(self):
+        """
+        Returns the names of the performance counters, in the order of their values.
+        >>> c.counter_names()[0]
+        'draw_calls'
+        """
+        names = []
+        while True:
+            reply_data = self._request(RequestType.ReadCounterName, struct.pack("II", len(names), 0))
+            if not reply_data:
+                return names
+            names.append(reply_data.decode("utf-8"))
+
+    def read_counters(self):
+        """
+        Returns the number of the last completed frame and the value of each performance counter
+        during it, or None if the frame changed while reading them.
+        >>> frame, counters = c.read_counters()
+        >>> len(counters) == len(c.counter_names())
+        True
+        """
+        num_counters = len(self.counter_names())
+        frame = None
+        counters = []
+        while len(counters) < num_counters:
+            count = min(num_counters - len(counters), MAX_READ_COUNTERS)
+            reply_data = self._request(RequestType.ReadCounters,
+                                       struct.pack("II", len(counters), count))
+            if not reply_data:
+                return None
+            values = struct.unpack("Q" * (len(reply_data) // 8), reply_data)
+            if frame is not None and values[0] != frame:
+                return None
+            frame = values[0]
+            counters.extend(values[1:])
+        return (frame, counters)
+
 if "__main__" == __name__:
     import doctest
     doctest.testmod(extraglobs={'c': Citra()})
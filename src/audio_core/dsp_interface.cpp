@@ -3,10 +3,12 @@
 // Refer to the license.txt file included.
 
 #include <cstddef>
+#include <cstring>
 #include "audio_core/dsp_interface.h"
 #include "audio_core/sink.h"
 #include "audio_core/sink_details.h"
 #include "common/assert.h"
+#include "common/perf_counters.h"
 #include "common/settings.h"
 #include "core/core.h"
 #include "core/dumping/backend.h"
@@ -41,7 +43,10 @@ void DspInterface::OutputFrame(StereoFrame16 frame) {
         return;
     }
 
-    fifo.Push(frame.data(), frame.size());
+    // Audio output is muted in turbo mode, only the video dumper gets the samples
+    if (!system.frame_limiter.IsTurbo()) {
+        fifo.Push(frame.data(), frame.size());
+    }
 
     auto video_dumper = system.GetVideoDumper();
     if (video_dumper && video_dumper->IsDumping()) {
@@ -54,7 +59,9 @@ void DspInterface::OutputSample(std::array<s16, 2> sample) {
         return;
     }
 
-    fifo.Push(&sample, 1);
+    if (!system.frame_limiter.IsTurbo()) {
+        fifo.Push(&sample, 1);
+    }
 
     auto video_dumper = system.GetVideoDumper();
     if (video_dumper && video_dumper->IsDumping()) {
@@ -63,6 +70,18 @@ void DspInterface::OutputSample(std::array<s16, 2> sample) {
 }
 
 void DspInterface::OutputCallback(s16* buffer, std::size_t num_frames) {
+    if (system.frame_limiter.IsTurbo()) {
+        // Drop the samples queued before turbo mode was enabled, they would play out of sync
+        fifo.Pop();
+        if (performing_time_stretching) {
+            time_stretcher.Clear();
+            performing_time_stretching = false;
+        }
+        last_frame = {};
+        std::memset(buffer, 0, num_frames * 2 * sizeof(s16));
+        return;
+    }
+
     // Determine if we should stretch based on the current emulation speed.
     const auto perf_stats = system.GetLastPerfStats();
     const auto should_stretch = enable_time_stretching && perf_stats.emulation_speed <= 95;
@@ -94,6 +113,10 @@ void DspInterface::OutputCallback(s16* buffer, std::size_t num_frames) {
         std::memcpy(&last_frame[0], buffer + 2 * (frames_written - 1), 2 * sizeof(s16));
     }
 
+    if (frames_written < num_frames) {
+        Common::PerfCounters::Add(Common::PerfCounters::Counter::AudioUnderruns);
+    }
+
     // Hold last emitted frame; this prevents popping.
     for (std::size_t i = frames_written; i < num_frames; i++) {
         std::memcpy(buffer + 2 * i, &last_frame[0], 2 * sizeof(s16));
@@ -0,0 +1,154 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <fmt/format.h>
+#include <json.hpp>
+#include "citra/benchmark.h"
+#include "common/file_util.h"
+#include "common/settings.h"
+#include "common/tracing.h"
+#include "core/core.h"
+#include "core/core_timing.h"
+
+Benchmark::Benchmark(Core::System& system_, u32 frames_, bool trace_scopes_)
+    : system{system_}, frames{frames_}, trace_scopes{trace_scopes_} {}
+
+Benchmark::~Benchmark() = default;
+
+u64 Benchmark::GetFrame() const {
+    return system.perf_stats->GetLastFrameCounters().frame;
+}
+
+void Benchmark::Start() {
+    previous_frame_limit = Settings::values.frame_limit.GetValue();
+    Settings::values.frame_limit.SetValue(0);
+
+    // Only the scopes recorded from now on are summed
+    if (trace_scopes) {
+        Common::Tracing::TakeEvents();
+        Common::Tracing::SetEnabled(true);
+    }
+
+    start_frame = last_frame = GetFrame();
+    start_ticks = system.CoreTiming().GetGlobalTicks();
+    start_time = last_frame_time = Clock::now();
+    start_counters = Common::PerfCounters::GetTotals();
+    frame_times.reserve(frames);
+}
+
+bool Benchmark::Update() {
+    const u64 frame = GetFrame();
+    if (frame == last_frame) {
+        return false;
+    }
+
+    // Several frames may complete within a slice of the run loop, share its time between them
+    const auto now = Clock::now();
+    const u64 new_frames = std::min<u64>(frame - last_frame, frames - frame_times.size());
+    const double frame_ms =
+        std::chrono::duration<double, std::milli>(now - last_frame_time).count() /
+        static_cast<double>(frame - last_frame);
+    frame_times.insert(frame_times.end(), new_frames, frame_ms);
+    last_frame = frame;
+    last_frame_time = now;
+    if (trace_scopes) {
+        CollectScopes();
+    }
+
+    if (!IsFinished()) {
+        return false;
+    }
+
+    end_ticks = system.CoreTiming().GetGlobalTicks();
+    end_time = now;
+    end_counters = Common::PerfCounters::GetTotals();
+    if (trace_scopes) {
+        Common::Tracing::SetEnabled(false);
+    }
+    Settings::values.frame_limit.SetValue(previous_frame_limit);
+    return true;
+}
+
+void Benchmark::CollectScopes() {
+    for (const auto& thread : Common::Tracing::TakeEvents()) {
+        for (const auto& event : thread.events) {
+            auto& total = scopes[{event.category, event.name}];
+            total.count++;
+            total.total_ns += event.end_ns - event.begin_ns;
+        }
+    }
+}
+
+bool Benchmark::WriteReport(const std::string& path, const Setup& setup) const {
+    const double seconds = std::chrono::duration<double>(end_time - start_time).count();
+    const double emulated_seconds = static_cast<double>(end_ticks - start_ticks) /
+                                    static_cast<double>(BASE_CLOCK_RATE_ARM11);
+    const double num_frames = static_cast<double>(frame_times.size());
+
+    std::vector<double> sorted_times = frame_times;
+    std::sort(sorted_times.begin(), sorted_times.end());
+    const std::size_t p99_index =
+        std::min(sorted_times.size() - 1, sorted_times.size() * 99 / 100);
+
+    nlohmann::json report;
+    report["title"] = setup.title;
+    report["state"] = setup.state;
+    report["movie"] = setup.movie;
+    report["graphics_api"] = static_cast<u32>(Settings::values.graphics_api.GetValue());
+    report["frames"] = frame_times.size();
+    report["wall_seconds"] = seconds;
+    report["emulated_seconds"] = emulated_seconds;
+    report["fps"] = num_frames / seconds;
+    report["emulation_speed"] = emulated_seconds / seconds;
+    report["frame_time_ms"] = {
+        {"min", sorted_times.front()},
+        {"avg", std::accumulate(frame_times.begin(), frame_times.end(), 0.0) / num_frames},
+        {"max", sorted_times.back()},
+        {"p99", sorted_times[p99_index]},
+    };
+
+    auto& counters = report["counters"] = nlohmann::json::object();
+    for (std::size_t i = 0; i < Common::PerfCounters::NumCounters; i++) {
+        const u64 total = end_counters[i] - start_counters[i];
+        counters[Common::PerfCounters::GetName(static_cast<Common::PerfCounters::Counter>(i))] = {
+            {"total", total},
+            {"per_frame", static_cast<double>(total) / num_frames},
+        };
+    }
+
+    report["scopes_traced"] = trace_scopes;
+    auto& subsystems = report["subsystems"] = nlohmann::json::object();
+    for (const auto& [key, total] : scopes) {
+        const auto& [category, name] = key;
+        subsystems[category][name] = {
+            {"count", total.count},
+            {"total_ms", static_cast<double>(total.total_ns) / 1e6},
+            {"per_frame_ms", static_cast<double>(total.total_ns) / 1e6 / num_frames},
+        };
+    }
+
+    std::ofstream file;
+    OpenFStream(file, path, std::ios_base::out | std::ios_base::trunc);
+    if (!file) {
+        return false;
+    }
+    file << report.dump(4) << "\n";
+    return static_cast<bool>(file);
+}
+
+void Benchmark::PrintSummary() const {
+    const double seconds = std::chrono::duration<double>(end_time - start_time).count();
+    const double emulated_seconds = static_cast<double>(end_ticks - start_ticks) /
+                                    static_cast<double>(BASE_CLOCK_RATE_ARM11);
+    const auto [min, max] = std::minmax_element(frame_times.begin(), frame_times.end());
+    std::cout << fmt::format("Benchmark: {} frames in {:.3f} s, {:.2f} fps, {:.1f}% speed\n",
+                             frame_times.size(), seconds,
+                             static_cast<double>(frame_times.size()) / seconds,
+                             emulated_seconds / seconds * 100.0);
+    std::cout << fmt::format("Frame time: min {:.3f} ms, max {:.3f} ms\n", *min, *max);
+}
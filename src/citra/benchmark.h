@@ -0,0 +1,84 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include "common/common_types.h"
+#include "common/perf_counters.h"
+
+namespace Core {
+class System;
+}
+
+/**
+ * Measures the emulation of a fixed number of frames for --benchmark. The frame limiter is turned
+ * off while it runs. With --benchmark-scopes, tracing is also turned on and the time spent in the
+ * traced scopes is summed per subsystem (microprofile group) from the events of Common::Tracing,
+ * which the benchmark consumes. It is off by default as tracing slows down the measured frames.
+ */
+class Benchmark {
+public:
+    /// Description of the run, copied to the report
+    struct Setup {
+        std::string title;
+        std::string state;
+        std::string movie;
+    };
+
+    Benchmark(Core::System& system, u32 frames, bool trace_scopes);
+    ~Benchmark();
+
+    /// Starts measuring from the current frame.
+    void Start();
+
+    /// Called after each run loop slice. Returns true once the frames were emulated.
+    bool Update();
+
+    /// Returns whether the frames were emulated. Reports are only valid once finished.
+    bool IsFinished() const {
+        return frame_times.size() >= frames;
+    }
+
+    /// Writes the JSON report. Returns false on failure.
+    bool WriteReport(const std::string& path, const Setup& setup) const;
+
+    /// Prints a summary of the run.
+    void PrintSummary() const;
+
+private:
+    struct ScopeTotal {
+        u64 count{};
+        u64 total_ns{};
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    u64 GetFrame() const;
+    void CollectScopes();
+
+    Core::System& system;
+    u32 frames;
+    bool trace_scopes;
+    u16 previous_frame_limit{};
+
+    u64 start_frame{};
+    u64 last_frame{};
+    u64 start_ticks{};
+    u64 end_ticks{};
+    Clock::time_point start_time;
+    Clock::time_point last_frame_time;
+    Clock::time_point end_time;
+    Common::PerfCounters::Values start_counters{};
+    Common::PerfCounters::Values end_counters{};
+
+    /// Wall time of each emulated frame, in milliseconds
+    std::vector<double> frame_times;
+    /// Time spent in the traced scopes, by category and name
+    std::map<std::pair<std::string, std::string>, ScopeTotal> scopes;
+};
@@ -2,6 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <chrono>
 #include <iostream>
 #include <memory>
 #include <regex>
@@ -11,6 +12,7 @@
 // This needs to be included before getopt.h because the latter #defines symbols used by it
 #include "common/microprofile.h"
 
+#include "citra/benchmark.h"
 #include "citra/config.h"
 #include "citra/emu_window/emu_window_sdl2.h"
 #ifdef ENABLE_OPENGL
@@ -23,6 +25,7 @@
 #include "citra/emu_window/emu_window_sdl2_vk.h"
 #endif
 #include "common/common_paths.h"
+#include "common/compressed_file.h"
 #include "common/detached_tasks.h"
 #include "common/file_util.h"
 #include "common/logging/backend.h"
@@ -31,6 +34,7 @@
 #include "common/scope_exit.h"
 #include "common/settings.h"
 #include "common/string_util.h"
+#include "common/tracing.h"
 #include "core/core.h"
 #include "core/dumping/backend.h"
 #include "core/dumping/ffmpeg_backend.h"
@@ -72,12 +76,22 @@ static void PrintHelp(const char* argv0) {
               << " [options] <filename>\n"
                  "-g, --gdbport=NUMBER Enable gdb stub on port NUMBER\n"
                  "-i, --install=FILE    Installs a specified CIA file\n"
+                 "-z, --compress=FILE   Compresses a game image and exits\n"
                  "-m, --multiplayer=nick:password@address:port"
                  " Nickname, password, address and port for multiplayer\n"
                  "-r, --movie-record=[file]  Record a movie (game inputs) to the given file\n"
                  "-a, --movie-record-author=AUTHOR Sets the author of the movie to be recorded\n"
                  "-p, --movie-play=[file]    Playback the movie (game inputs) from the given file\n"
                  "-d, --dump-video=[file]    Dumps audio and video to the given video file\n"
+                 "-t, --trace=[file]   Trace hot paths and write a Chrome (.json) or Perfetto\n"
+                 "                     (.perfetto-trace) trace to the given file on exit\n"
+                 "-b, --benchmark=FRAMES Emulate FRAMES frames without frame limiting and exit\n"
+                 "-o, --benchmark-report=[file] Write the benchmark report to the given JSON file\n"
+                 "-c, --benchmark-scopes Trace hot paths during the benchmark and report the time\n"
+                 "                     spent per subsystem\n"
+                 "-s, --load-state=[file]    Load the given savestate before starting\n"
+                 "-n, --offscreen      Render to an offscreen window with the software renderer\n"
+                 "-u, --turbo          Run unthrottled and muted, presenting only some frames\n"
                  "-f, --fullscreen     Start in fullscreen mode\n"
                  "-h, --help           Display this help and exit\n"
                  "-v, --version        Output version information and exit\n";
@@ -196,6 +210,13 @@ int main(int argc, char** argv) {
     std::string movie_record_author;
     std::string movie_play;
     std::string dump_video;
+    std::string trace_file;
+    u32 benchmark_frames = 0;
+    std::string benchmark_report = "benchmark.json";
+    bool benchmark_scopes = false;
+    std::string load_state;
+    bool offscreen = false;
+    bool turbo = false;
 
     char* endarg;
 #ifdef _WIN32
@@ -219,11 +240,19 @@ int main(int argc, char** argv) {
     static struct option long_options[] = {
         {"gdbport", required_argument, 0, 'g'},
         {"install", required_argument, 0, 'i'},
+        {"compress", required_argument, 0, 'z'},
         {"multiplayer", required_argument, 0, 'm'},
         {"movie-record", required_argument, 0, 'r'},
         {"movie-record-author", required_argument, 0, 'a'},
         {"movie-play", required_argument, 0, 'p'},
         {"dump-video", required_argument, 0, 'd'},
+        {"trace", required_argument, 0, 't'},
+        {"benchmark", required_argument, 0, 'b'},
+        {"benchmark-report", required_argument, 0, 'o'},
+        {"benchmark-scopes", no_argument, 0, 'c'},
+        {"load-state", required_argument, 0, 's'},
+        {"offscreen", no_argument, 0, 'n'},
+        {"turbo", no_argument, 0, 'u'},
         {"fullscreen", no_argument, 0, 'f'},
         {"help", no_argument, 0, 'h'},
         {"version", no_argument, 0, 'v'},
@@ -231,7 +260,8 @@ int main(int argc, char** argv) {
     };
 
     while (optind < argc) {
-        int arg = getopt_long(argc, argv, "g:i:m:r:p:fhv", long_options, &option_index);
+        int arg =
+            getopt_long(argc, argv, "g:i:z:m:r:p:t:b:o:cs:nufhv", long_options, &option_index);
         if (arg != -1) {
             switch (static_cast<char>(arg)) {
             case 'g':
@@ -246,16 +276,32 @@ int main(int argc, char** argv) {
                 }
                 break;
             case 'i': {
-                const auto cia_progress = [](std::size_t written, std::size_t total) {
+                std::size_t cia_size = 0;
+                const auto cia_progress = [&cia_size](std::size_t written, std::size_t total) {
                     LOG_INFO(Frontend, "{:02d}%", (written * 100 / total));
+                    cia_size = total;
                 };
+                const auto install_start = std::chrono::steady_clock::now();
                 if (Service::AM::InstallCIA(std::string(optarg), cia_progress) !=
                     Service::AM::InstallStatus::Success)
                     errno = EINVAL;
                 if (errno != 0)
                     exit(1);
+                const std::chrono::duration<double> install_time =
+                    std::chrono::steady_clock::now() - install_start;
+                LOG_INFO(Frontend, "Installed {} bytes in {:.2f}s ({:.2f} MB/s)", cia_size,
+                         install_time.count(),
+                         cia_size / (1024.0 * 1024.0) / install_time.count());
                 break;
             }
+            case 'z': {
+                const std::string source_path(optarg);
+                std::string directory, name, extension;
+                Common::SplitPath(source_path, &directory, &name, &extension);
+                const std::string dest_path =
+                    directory + name + FileUtil::GetCompressedExtension(extension);
+                return FileUtil::CompressFile(source_path, dest_path) ? 0 : 1;
+            }
             case 'm': {
                 use_multiplayer = true;
                 const std::string str_arg(optarg);
@@ -300,6 +346,34 @@ int main(int argc, char** argv) {
             case 'd':
                 dump_video = optarg;
                 break;
+            case 't':
+                trace_file = optarg;
+                break;
+            case 'b':
+                errno = 0;
+                benchmark_frames = strtoul(optarg, &endarg, 0);
+                if (endarg == optarg || benchmark_frames == 0)
+                    errno = EINVAL;
+                if (errno != 0) {
+                    perror("--benchmark");
+                    exit(1);
+                }
+                break;
+            case 'o':
+                benchmark_report = optarg;
+                break;
+            case 'c':
+                benchmark_scopes = true;
+                break;
+            case 's':
+                load_state = optarg;
+                break;
+            case 'n':
+                offscreen = true;
+                break;
+            case 'u':
+                turbo = true;
+                break;
             case 'f':
                 fullscreen = true;
                 LOG_INFO(Frontend, "Starting in fullscreen mode...");
@@ -338,6 +412,16 @@ int main(int argc, char** argv) {
         return -1;
     }
 
+    // The benchmark consumes the traced events to sum the time spent per subsystem
+    if (!trace_file.empty() && benchmark_scopes) {
+        LOG_CRITICAL(Frontend, "Cannot both trace and report the benchmark scopes");
+        return -1;
+    }
+
+    if (!trace_file.empty()) {
+        Common::Tracing::SetEnabled(true);
+    }
+
     auto& system = Core::System::GetInstance();
     auto& movie = system.Movie();
 
@@ -351,12 +435,23 @@ int main(int argc, char** argv) {
     // Apply the command line arguments
     Settings::values.gdbstub_port = gdb_port;
     Settings::values.use_gdbstub = use_gdbstub;
+    if (offscreen) {
+        Settings::values.graphics_api = Settings::GraphicsAPI::Software;
+    }
+    if (benchmark_frames != 0 && movie_play.empty()) {
+        // Movies restore the clock they were recorded with, otherwise fix it so that runs with the
+        // same savestate are repeatable
+        Settings::values.init_clock = Settings::InitClock::FixedTime;
+        Settings::values.init_ticks_type = Settings::InitTicks::Fixed;
+    }
     system.ApplySettings();
 
     // Register frontend applets
     Frontend::RegisterDefaultApplets(system);
 
-    EmuWindow_SDL2::InitializeSDL2();
+    system.frame_limiter.SetTurbo(turbo);
+
+    EmuWindow_SDL2::InitializeSDL2(offscreen);
 
     const auto create_emu_window = [&](bool fullscreen,
                                        bool is_secondary) -> std::unique_ptr<EmuWindow_SDL2> {
@@ -492,6 +587,21 @@ int main(int argc, char** argv) {
                       total);
         });
 
+    if (!load_state.empty()) {
+        try {
+            system.LoadState(load_state);
+        } catch (const std::exception& e) {
+            LOG_CRITICAL(Frontend, "Failed to load savestate {}: {}", load_state, e.what());
+            return -1;
+        }
+    }
+
+    std::unique_ptr<Benchmark> benchmark;
+    if (benchmark_frames != 0) {
+        benchmark = std::make_unique<Benchmark>(system, benchmark_frames, benchmark_scopes);
+        benchmark->Start();
+    }
+
     const auto secondary_is_open = [&secondary_window] {
         // if the secondary window isn't created, it shouldn't affect the main loop
         return secondary_window ? secondary_window->IsOpen() : true;
@@ -509,6 +619,9 @@ int main(int argc, char** argv) {
             LOG_ERROR(Frontend, "Error in main run loop: {}", result, system.GetStatusDetails());
             break;
         }
+        if (benchmark && benchmark->Update()) {
+            emu_window->RequestClose();
+        }
     }
     emu_window->RequestClose();
     if (secondary_window) {
@@ -529,10 +642,32 @@ int main(int argc, char** argv) {
 
     system.Shutdown();
 
+    int exit_code = 0;
+    if (benchmark && !benchmark->IsFinished()) {
+        LOG_ERROR(Frontend, "Emulation stopped before the benchmark finished");
+        exit_code = 1;
+    } else if (benchmark) {
+        benchmark->PrintSummary();
+        const Benchmark::Setup setup{filepath, load_state, movie_play};
+        if (benchmark->WriteReport(benchmark_report, setup)) {
+            LOG_INFO(Frontend, "Benchmark report written to {}", benchmark_report);
+        } else {
+            LOG_ERROR(Frontend, "Could not write benchmark report to {}", benchmark_report);
+            exit_code = 1;
+        }
+    }
+
+    if (!trace_file.empty()) {
+        Common::Tracing::SetEnabled(false);
+        if (Common::Tracing::Export(trace_file)) {
+            LOG_INFO(Frontend, "Trace written to {}", trace_file);
+        }
+    }
+
 #ifdef __unix__
     Common::Linux::StopGamemode();
 #endif
 
     detached_tasks.WaitForAllTasks();
-    return 0;
+    return exit_code;
 }
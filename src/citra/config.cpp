@@ -2,6 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <iomanip>
 #include <memory>
 #include <sstream>
@@ -130,6 +131,8 @@ void Config::ReadValues() {
     // Core
     ReadSetting("Core", Settings::values.use_cpu_jit);
     ReadSetting("Core", Settings::values.cpu_clock_percentage);
+    ReadSetting("Core", Settings::values.rewind_seconds);
+    ReadSetting("Core", Settings::values.rewind_interval_frames);
 
     // Renderer
     ReadSetting("Renderer", Settings::values.graphics_api);
@@ -144,6 +147,7 @@ void Config::ReadValues() {
     ReadSetting("Renderer", Settings::values.resolution_factor);
     ReadSetting("Renderer", Settings::values.use_disk_shader_cache);
     ReadSetting("Renderer", Settings::values.frame_limit);
+    ReadSetting("Renderer", Settings::values.turbo_present_interval);
     ReadSetting("Renderer", Settings::values.use_vsync_new);
     ReadSetting("Renderer", Settings::values.texture_filter);
     ReadSetting("Renderer", Settings::values.texture_sampling);
@@ -352,6 +356,10 @@ void Config::ReadValues() {
         sdl2_config->GetString("Video Dumping", "video_encoder_options", default_video_options);
     Settings::values.video_bitrate =
         sdl2_config->GetInteger("Video Dumping", "video_bitrate", 2500000);
+    Settings::values.video_queue_size = static_cast<u32>(
+        std::max(sdl2_config->GetInteger("Video Dumping", "video_queue_size", 8), 1L));
+    Settings::values.drop_video_frames =
+        sdl2_config->GetBoolean("Video Dumping", "drop_video_frames", false);
 
     Settings::values.audio_encoder =
         sdl2_config->GetString("Video Dumping", "audio_encoder", "libvorbis");
@@ -97,6 +97,14 @@ use_cpu_jit =
 # Range is any positive integer (but we suspect 25 - 400 is a good idea) Default is 100
 cpu_clock_percentage =
 
+# Emulated seconds kept in memory to rewind to, which uses a few hundred megabytes
+# 0 (default): Rewinding is disabled
+rewind_seconds =
+
+# Emulated frames between two rewind snapshots, each of which hashes all of guest memory
+# 60 (default)
+rewind_interval_frames =
+
 [Renderer]
 # Whether to render using OpenGL or Software
 # 0: Software, 1: OpenGL (default), 2: Vulkan
@@ -149,6 +157,10 @@ use_frame_limit_alternate =
 # 5 - 995: Speed limit as a percentage of target game speed. 0 for unthrottled. 200 (default)
 frame_limit_alternate =
 
+# How often frames are presented in turbo mode, which runs unthrottled and without audio.
+# 0: At most 60 times per second, N: Every Nth emulated frame. 10 (default)
+turbo_present_interval =
+
 # The clear color for the renderer. What shows up on the sides of the bottom screen.
 # Must be in range of 0.0-1.0. Defaults to 0.0 for all.
 bg_red =
@@ -388,6 +400,13 @@ video_encoder_options =
 # Video bitrate, default: 2500000
 video_bitrate =
 
+# Number of frames that can wait to be encoded, default: 8
+video_queue_size =
+
+# What happens when the encoder falls behind and the queue is full
+# 0: Emulation waits for the encoder (default), 1: Frames are dropped
+drop_video_frames =
+
 # Audio encoder used, default: libvorbis
 audio_encoder =
 
@@ -20,8 +20,8 @@ public:
     explicit EmuWindow_SDL2(Core::System& system_, bool is_secondary);
     ~EmuWindow_SDL2();
 
-    /// Initializes SDL2
-    static void InitializeSDL2();
+    /// Initializes SDL2. Offscreen windows are never shown, which allows running without a display.
+    static void InitializeSDL2(bool offscreen = false);
 
     /// Presents the most recent frame from the video backend
     virtual void Present() {}
@@ -54,7 +54,7 @@ const std::array<std::array<int, 5>, Settings::NativeAnalog::NumAnalogs> Config:
 // This must be in alphabetical order according to action name as it must have the same order as
 // UISetting::values.shortcuts, which is alphabetically ordered.
 // clang-format off
-const std::array<UISettings::Shortcut, 35> Config::default_hotkeys {{
+const std::array<UISettings::Shortcut, 37> Config::default_hotkeys {{
      {QStringLiteral("Advance Frame"),            QStringLiteral("Main Window"), {QStringLiteral(""),       Qt::ApplicationShortcut}},
      {QStringLiteral("Audio Mute/Unmute"),        QStringLiteral("Main Window"), {QStringLiteral("Ctrl+M"), Qt::WindowShortcut}},
      {QStringLiteral("Audio Volume Down"),        QStringLiteral("Main Window"), {QStringLiteral(""),       Qt::WindowShortcut}},
@@ -78,6 +78,7 @@ const std::array<UISettings::Shortcut, 35> Config::default_hotkeys {{
      {QStringLiteral("Multiplayer Show Current Room"),        QStringLiteral("Main Window"), {QStringLiteral("Ctrl+R"), Qt::ApplicationShortcut}},
      {QStringLiteral("Remove Amiibo"),            QStringLiteral("Main Window"), {QStringLiteral("F3"),     Qt::ApplicationShortcut}},
      {QStringLiteral("Restart Emulation"),        QStringLiteral("Main Window"), {QStringLiteral("F6"),     Qt::WindowShortcut}},
+     {QStringLiteral("Rewind"),                   QStringLiteral("Main Window"), {QStringLiteral(""),       Qt::ApplicationShortcut}},
      {QStringLiteral("Rotate Screens Upright"),   QStringLiteral("Main Window"), {QStringLiteral("F8"),     Qt::WindowShortcut}},
      {QStringLiteral("Save to Oldest Slot"),      QStringLiteral("Main Window"), {QStringLiteral("Ctrl+C"), Qt::WindowShortcut}},
      {QStringLiteral("Stop Emulation"),           QStringLiteral("Main Window"), {QStringLiteral("F5"),     Qt::WindowShortcut}},
@@ -90,6 +91,7 @@ const std::array<UISettings::Shortcut, 35> Config::default_hotkeys {{
      {QStringLiteral("Toggle Screen Layout"),     QStringLiteral("Main Window"), {QStringLiteral("F10"),    Qt::WindowShortcut}},
      {QStringLiteral("Toggle Status Bar"),        QStringLiteral("Main Window"), {QStringLiteral("Ctrl+S"), Qt::WindowShortcut}},
      {QStringLiteral("Toggle Texture Dumping"),   QStringLiteral("Main Window"), {QStringLiteral(""),       Qt::ApplicationShortcut}},
+     {QStringLiteral("Toggle Turbo Mode"),        QStringLiteral("Main Window"), {QStringLiteral(""),       Qt::ApplicationShortcut}},
     }};
 // clang-format on
 
@@ -458,6 +460,8 @@ void Config::ReadCoreValues() {
     if (global) {
         ReadBasicSetting(Settings::values.use_cpu_jit);
         ReadBasicSetting(Settings::values.delay_start_for_lle_modules);
+        ReadBasicSetting(Settings::values.rewind_seconds);
+        ReadBasicSetting(Settings::values.rewind_interval_frames);
     }
 
     qt_config->endGroup();
@@ -666,6 +670,7 @@ void Config::ReadRendererValues() {
 
     if (global) {
         ReadBasicSetting(Settings::values.use_shader_jit);
+        ReadBasicSetting(Settings::values.turbo_present_interval);
     }
 
     qt_config->endGroup();
@@ -740,6 +745,10 @@ void Config::ReadVideoDumpingValues() {
 
     Settings::values.video_bitrate =
         ReadSetting(QStringLiteral("video_bitrate"), 2500000).toULongLong();
+    Settings::values.video_queue_size =
+        std::max(ReadSetting(QStringLiteral("video_queue_size"), 8).toUInt(), 1U);
+    Settings::values.drop_video_frames =
+        ReadSetting(QStringLiteral("drop_video_frames"), false).toBool();
 
     Settings::values.audio_encoder =
         ReadSetting(QStringLiteral("audio_encoder"), QStringLiteral("libvorbis"))
@@ -996,6 +1005,8 @@ void Config::SaveCoreValues() {
     if (global) {
         WriteBasicSetting(Settings::values.use_cpu_jit);
         WriteBasicSetting(Settings::values.delay_start_for_lle_modules);
+        WriteBasicSetting(Settings::values.rewind_seconds);
+        WriteBasicSetting(Settings::values.rewind_interval_frames);
     }
 
     qt_config->endGroup();
@@ -1167,6 +1178,7 @@ void Config::SaveRendererValues() {
     if (global) {
         WriteSetting(QStringLiteral("use_shader_jit"), Settings::values.use_shader_jit.GetValue(),
                      true);
+        WriteBasicSetting(Settings::values.turbo_present_interval);
     }
 
     qt_config->endGroup();
@@ -1227,6 +1239,8 @@ void Config::SaveVideoDumpingValues() {
                  DEFAULT_VIDEO_ENCODER_OPTIONS);
     WriteSetting(QStringLiteral("video_bitrate"),
                  static_cast<unsigned long long>(Settings::values.video_bitrate), 2500000);
+    WriteSetting(QStringLiteral("video_queue_size"), Settings::values.video_queue_size, 8);
+    WriteSetting(QStringLiteral("drop_video_frames"), Settings::values.drop_video_frames, false);
     WriteSetting(QStringLiteral("audio_encoder"),
                  QString::fromStdString(Settings::values.audio_encoder),
                  QStringLiteral("libvorbis"));
@@ -26,7 +26,7 @@ public:
 
     static const std::array<int, Settings::NativeButton::NumButtons> default_buttons;
     static const std::array<std::array<int, 5>, Settings::NativeAnalog::NumAnalogs> default_analogs;
-    static const std::array<UISettings::Shortcut, 35> default_hotkeys;
+    static const std::array<UISettings::Shortcut, 37> default_hotkeys;
 
 private:
     void Initialize(const std::string& config_name);
@@ -68,17 +68,17 @@ void GraphicsTracingWidget::StartRecording() {
 
     // Encode floating point numbers to 24-bit values
     // TODO: Drop this explicit conversion once we store float24 values bit-correctly internally.
-    std::array<u32, 4 * 16> default_attributes;
+    std::array<u32, 4 * 16> default_attributes{};
     for (u32 i = 0; i < 16; ++i) {
-        for (u32 comp = 0; comp < 3; ++comp) {
+        for (u32 comp = 0; comp < 4; ++comp) {
             default_attributes[4 * i + comp] =
                 nihstro::to_float24(pica.input_default_attributes[i][comp].ToFloat32());
         }
     }
 
-    std::array<u32, 4 * 96> vs_float_uniforms;
+    std::array<u32, 4 * 96> vs_float_uniforms{};
     for (u32 i = 0; i < 96; ++i) {
-        for (u32 comp = 0; comp < 3; ++comp) {
+        for (u32 comp = 0; comp < 4; ++comp) {
             vs_float_uniforms[4 * i + comp] =
                 nihstro::to_float24(pica.vs_setup.uniforms.f[i][comp].ToFloat32());
         }
@@ -87,7 +87,7 @@ void GraphicsTracingWidget::StartRecording() {
     CiTrace::Recorder::InitialState state;
 
     const auto copy = [&](std::vector<u32>& dest, auto& data) {
-        dest.resize(sizeof(data));
+        dest.resize(sizeof(data) / sizeof(u32));
         std::memcpy(dest.data(), std::addressof(data), sizeof(data));
     };
 
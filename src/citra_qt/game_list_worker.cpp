@@ -13,11 +13,11 @@
 #include "citra_qt/game_list_p.h"
 #include "citra_qt/game_list_worker.h"
 #include "citra_qt/uisettings.h"
-#include "common/common_paths.h"
 #include "common/file_util.h"
-#include "core/hle/service/am/am.h"
+#include "common/logging/log.h"
 #include "core/hle/service/fs/archive.h"
-#include "core/loader/loader.h"
+#include "core/loader/game_scanner.h"
+#include "core/loader/smdh.h"
 
 namespace {
 bool HasSupportedFileExtension(const std::string& file_name) {
@@ -35,99 +35,54 @@ GameListWorker::~GameListWorker() = default;
 void GameListWorker::AddFstEntriesToGameList(const std::string& dir_path, unsigned int recursion,
                                              GameListDir* parent_dir,
                                              Service::FS::MediaType media_type) {
-    const auto callback = [this, recursion, parent_dir,
-                           media_type](u64* num_entries_out, const std::string& directory,
-                                       const std::string& virtual_name) -> bool {
-        if (stop_processing) {
-            // Breaks the callback loop.
-            return false;
-        }
-
-        const std::string physical_name = directory + DIR_SEP + virtual_name;
-        const bool is_dir = FileUtil::IsDirectory(physical_name);
-        if (!is_dir && HasSupportedFileExtension(physical_name)) {
-            std::unique_ptr<Loader::AppLoader> loader = Loader::GetLoader(physical_name);
-            if (!loader) {
-                return true;
-            }
-
-            bool executable = false;
-            const auto res = loader->IsExecutable(executable);
-            if (!executable && res != Loader::ResultStatus::ErrorEncrypted) {
-                return true;
-            }
-
-            u64 program_id = 0;
-            loader->ReadProgramId(program_id);
-
-            u64 extdata_id = 0;
-            loader->ReadExtdataId(extdata_id);
-
-            std::vector<u8> smdh;
-            // Look for an update icon if available
-            if (!(program_id & ~0x00040000FFFFFFFF)) {
-                std::string update_path = Service::AM::GetTitleContentPath(
-                    Service::FS::MediaType::SDMC, program_id | 0x0000000E00000000);
-                if (FileUtil::Exists(update_path)) {
-                    std::unique_ptr<Loader::AppLoader> update_loader =
-                        Loader::GetLoader(update_path);
-                    if (update_loader) {
-                        update_loader->ReadIcon(smdh);
-                    }
+    const auto callback = [this, parent_dir, media_type](const Loader::GameEntry& game) {
+        const u64 program_id = game.program_id;
+        const auto system_title = ((program_id >> 32) & 0xFFFFFFFF) == 0x00040010;
+        if (Loader::IsValidSMDH(game.smdh)) {
+            if (system_title) {
+                auto smdh_struct = reinterpret_cast<const Loader::SMDH*>(game.smdh.data());
+                if (!(smdh_struct->flags & Loader::SMDH::Flags::Visible)) {
+                    // Skip system titles without the visible flag.
+                    return;
                 }
             }
-
-            if (!Loader::IsValidSMDH(smdh)) {
-                // Read the original smdh if there is no valid update smdh
-                loader->ReadIcon(smdh);
-            }
-
-            const auto system_title = ((program_id >> 32) & 0xFFFFFFFF) == 0x00040010;
-            if (Loader::IsValidSMDH(smdh)) {
-                if (system_title) {
-                    auto smdh_struct = reinterpret_cast<Loader::SMDH*>(smdh.data());
-                    if (!(smdh_struct->flags & Loader::SMDH::Flags::Visible)) {
-                        // Skip system titles without the visible flag.
-                        return true;
-                    }
-                }
-            } else if (UISettings::values.game_list_hide_no_icon || system_title) {
-                // Skip this invalid entry
-                return true;
-            }
-
-            auto it = FindMatchingCompatibilityEntry(compatibility_list, program_id);
-
-            // The game list uses this as compatibility number for untested games
-            QString compatibility(QStringLiteral("99"));
-            if (it != compatibility_list.end())
-                compatibility = it->second.first;
-
-            emit EntryReady(
-                {
-                    new GameListItemPath(QString::fromStdString(physical_name), smdh, program_id,
-                                         extdata_id, media_type),
-                    new GameListItemCompat(compatibility),
-                    new GameListItemRegion(smdh),
-                    new GameListItem(
-                        QString::fromStdString(Loader::GetFileTypeString(loader->GetFileType()))),
-                    new GameListItemSize(FileUtil::GetSize(physical_name)),
-                },
-                parent_dir);
-
-        } else if (is_dir && recursion > 0) {
-            watch_list.append(QString::fromStdString(physical_name));
-            AddFstEntriesToGameList(physical_name, recursion - 1, parent_dir, media_type);
+        } else if (UISettings::values.game_list_hide_no_icon || system_title) {
+            // Skip this invalid entry
+            return;
         }
 
-        return true;
+        auto it = FindMatchingCompatibilityEntry(compatibility_list, program_id);
+
+        // The game list uses this as compatibility number for untested games
+        QString compatibility(QStringLiteral("99"));
+        if (it != compatibility_list.end())
+            compatibility = it->second.first;
+
+        emit EntryReady(
+            {
+                new GameListItemPath(QString::fromStdString(game.path), game.smdh, program_id,
+                                     game.extdata_id, media_type),
+                new GameListItemCompat(compatibility),
+                new GameListItemRegion(game.smdh),
+                new GameListItem(
+                    QString::fromStdString(Loader::GetFileTypeString(game.file_type))),
+                new GameListItemSize(game.size),
+            },
+            parent_dir);
     };
 
-    FileUtil::ForeachDirectoryEntry(nullptr, dir_path, callback);
+    std::vector<std::string> scanned_dirs;
+    scanner->Scan(dir_path, recursion, HasSupportedFileExtension, callback, stop_processing,
+                  &scanned_dirs);
+    for (const auto& dir : scanned_dirs) {
+        watch_list.append(QString::fromStdString(dir));
+    }
 }
 
 void GameListWorker::run() {
     stop_processing = false;
+    scanner = std::make_unique<Loader::GameScanner>(
+        FileUtil::GetUserPath(FileUtil::UserPath::CacheDir) + "game_list_index.bin");
     for (UISettings::GameDir& game_dir : game_dirs) {
         if (game_dir.path == QStringLiteral("INSTALLED")) {
             QString games_path =
@@ -167,6 +122,11 @@ void GameListWorker::run() {
         }
     }
 
+    scanner->SaveIndex();
+    const auto stats = scanner->GetStats();
+    LOG_INFO(Frontend, "Scanned {} files, {} were not indexed yet", stats.files, stats.opened);
+    scanner.reset();
+
     emit Finished(watch_list);
 }
 
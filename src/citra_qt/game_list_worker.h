@@ -15,6 +15,10 @@
 #include "citra_qt/compatibility_list.h"
 #include "common/common_types.h"
 
+namespace Loader {
+class GameScanner;
+}
+
 namespace Service::FS {
 enum class MediaType : u32;
 }
@@ -63,4 +67,5 @@ private:
 
     QStringList watch_list;
     std::atomic_bool stop_processing;
+    std::unique_ptr<Loader::GameScanner> scanner;
 };
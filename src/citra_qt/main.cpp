@@ -700,6 +700,16 @@ void GMainWindow::InitializeHotkeys() {
                      [&] { Settings::values.dump_textures = !Settings::values.dump_textures; });
     connect_shortcut(QStringLiteral("Toggle Custom Textures"),
                      [&] { Settings::values.custom_textures = !Settings::values.custom_textures; });
+    connect_shortcut(QStringLiteral("Toggle Turbo Mode"), [&] {
+        system.frame_limiter.SetTurbo(!system.frame_limiter.IsTurbo());
+        UpdateStatusBar();
+    });
+    connect_shortcut(QStringLiteral("Rewind"), [&] {
+        // Goes back one emulated second, enabled by the rewind_seconds setting
+        if (emulation_running) {
+            system.SendSignal(Core::System::Signal::Rewind, 60);
+        }
+    });
     // We use "static" here in order to avoid capturing by lambda due to a MSVC bug, which makes
     // the variable hold a garbage value after this function exits
     static constexpr u16 SPEED_LIMIT_STEP = 5;
@@ -940,6 +950,7 @@ void GMainWindow::ConnectMenuEvents() {
     connect_menu(ui->action_Play_Movie, &GMainWindow::OnPlayMovie);
     connect_menu(ui->action_Close_Movie, &GMainWindow::OnCloseMovie);
     connect_menu(ui->action_Save_Movie, &GMainWindow::OnSaveMovie);
+    connect_menu(ui->action_Seek_Movie, &GMainWindow::OnSeekMovie);
     connect_menu(ui->action_Movie_Read_Only_Mode,
                  [this](bool checked) { movie.SetReadOnly(checked); });
     connect_menu(ui->action_Enable_Frame_Advancing, [this] {
@@ -1249,7 +1260,7 @@ bool GMainWindow::LoadROM(const QString& filename) {
 }
 
 void GMainWindow::BootGame(const QString& filename) {
-    if (filename.endsWith(QStringLiteral(".cia"))) {
+    if (filename.endsWith(QStringLiteral(".cia")) || filename.endsWith(QStringLiteral(".zcia"))) {
         const auto answer = QMessageBox::question(
             this, tr("CIA must be installed before usage"),
             tr("Before using this CIA, you must install it. Do you want to install it now?"),
@@ -1410,6 +1421,7 @@ void GMainWindow::ShutdownGame() {
 
     // Frame advancing must be cancelled in order to release the emu thread from waiting
     system.frame_limiter.SetFrameAdvancing(false);
+    system.frame_limiter.SetTurbo(false);
 
     emit EmulationStopping();
 
@@ -1775,7 +1787,7 @@ void GMainWindow::OnMenuLoadFile() {
 void GMainWindow::OnMenuInstallCIA() {
     QStringList filepaths = QFileDialog::getOpenFileNames(
         this, tr("Load Files"), UISettings::values.roms_path,
-        tr("3DS Installation File (*.CIA*)") + QStringLiteral(";;") + tr("All Files (*.*)"));
+        tr("3DS Installation File (*.CIA* *.ZCIA)") + QStringLiteral(";;") + tr("All Files (*.*)"));
 
     if (filepaths.isEmpty()) {
         return;
@@ -2370,6 +2382,7 @@ void GMainWindow::OnCloseMovie() {
 
     ui->action_Close_Movie->setEnabled(false);
     ui->action_Save_Movie->setEnabled(false);
+    ui->action_Seek_Movie->setEnabled(false);
 }
 
 void GMainWindow::OnSaveMovie() {
@@ -2390,6 +2403,21 @@ void GMainWindow::OnSaveMovie() {
     }
 }
 
+void GMainWindow::OnSeekMovie() {
+    if (!emulation_running) {
+        return;
+    }
+
+    // Seeking loads the savestate of the last keyframe at or before the frame
+    bool ok = false;
+    const int frame = QInputDialog::getInt(
+        this, tr("Seek Movie"), tr("Frame:"), static_cast<int>(movie.GetCurrentInputIndex()), 0,
+        static_cast<int>(movie.GetTotalInputCount()), 1, &ok);
+    if (ok) {
+        system.SendSignal(Core::System::Signal::SeekMovie, static_cast<u32>(frame));
+    }
+}
+
 void GMainWindow::OnCaptureScreenshot() {
     if (!emu_thread || !emu_thread->IsRunning()) [[unlikely]] {
         return;
@@ -2585,23 +2613,30 @@ void GMainWindow::UpdateStatusBar() {
         message_label->setText(tr("Recording %1").arg(current));
         message_label_used_for_movie = true;
         ui->action_Save_Movie->setEnabled(true);
+        ui->action_Seek_Movie->setEnabled(false);
     } else if (play_mode == Core::Movie::PlayMode::Playing) {
         message_label->setText(tr("Playing %1 / %2").arg(current).arg(total));
         message_label_used_for_movie = true;
         ui->action_Save_Movie->setEnabled(false);
+        ui->action_Seek_Movie->setEnabled(true);
     } else if (play_mode == Core::Movie::PlayMode::MovieFinished) {
         message_label->setText(tr("Movie Finished"));
         message_label_used_for_movie = true;
         ui->action_Save_Movie->setEnabled(false);
+        ui->action_Seek_Movie->setEnabled(true);
     } else if (message_label_used_for_movie) { // Clear the label if movie was just closed
         message_label->setText(QString{});
         message_label_used_for_movie = false;
         ui->action_Save_Movie->setEnabled(false);
+        ui->action_Seek_Movie->setEnabled(false);
     }
 
     auto results = system.GetAndResetPerfStats();
 
-    if (Settings::values.frame_limit.GetValue() == 0) {
+    if (system.frame_limiter.IsTurbo()) {
+        emu_speed_label->setText(
+            tr("Speed: %1% (Turbo)").arg(results.emulation_speed * 100.0, 0, 'f', 0));
+    } else if (Settings::values.frame_limit.GetValue() == 0) {
         emu_speed_label->setText(tr("Speed: %1%").arg(results.emulation_speed * 100.0, 0, 'f', 0));
     } else {
         emu_speed_label->setText(tr("Speed: %1% / %2%")
@@ -2867,8 +2902,9 @@ static bool IsSingleFileDropEvent(const QMimeData* mime) {
     return mime->hasUrls() && mime->urls().length() == 1;
 }
 
-static const std::array<std::string, 8> AcceptedExtensions = {"cci",  "3ds", "cxi", "bin",
-                                                              "3dsx", "app", "elf", "axf"};
+static const std::array<std::string, 13> AcceptedExtensions = {
+    "cci", "3ds", "cxi", "bin", "3dsx", "app", "elf", "axf", "zcci", "z3ds", "zcxi", "z3dsx",
+    "zapp"};
 
 static bool IsCorrectFileExtension(const QMimeData* mime) {
     const QString& filename = mime->urls().at(0).toLocalFile();
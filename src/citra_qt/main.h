@@ -246,6 +246,7 @@ private slots:
     void OnPlayMovie();
     void OnCloseMovie();
     void OnSaveMovie();
+    void OnSeekMovie();
     void OnCaptureScreenshot();
     void OnDumpVideo();
 #ifdef _WIN32
@@ -0,0 +1,248 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+#include <fmt/format.h>
+#include <json.hpp>
+#include "common/common_types.h"
+#include "common/file_util.h"
+#include "common/logging/backend.h"
+#include "common/scm_rev.h"
+#include "common/settings.h"
+#include "common/tracing.h"
+#include "core/core.h"
+#include "core/memory.h"
+#include "core/tracer/player.h"
+#include "video_core/pica/pica_core.h"
+#include "video_core/renderer_software/sw_rasterizer.h"
+
+#undef _UNICODE
+#include <getopt.h>
+#ifndef _MSC_VER
+#include <unistd.h>
+#endif
+
+static void PrintHelp(const char* argv0) {
+    std::cout << "Usage: " << argv0
+              << " [options] <filename>\n"
+                 "Replays a CiTrace with the software renderer and reports its timings.\n"
+                 "-n, --iterations   Number of times the trace is replayed (default 5)\n"
+                 "-i, --interpreter  Run shaders with the interpreter instead of the JIT\n"
+                 "-j, --json         Write the report to the given JSON file\n"
+                 "-l, --log-file     The file for storing the log\n"
+                 "-t, --trace        Write a Chrome (.json) or Perfetto trace of the replays\n"
+                 "-h, --help         Display this help and exit\n"
+                 "-v, --version      Output version information and exit\n";
+}
+
+static void PrintVersion() {
+    std::cout << "Citra trace player " << Common::g_scm_branch << " " << Common::g_scm_desc
+              << std::endl;
+}
+
+static void InitializeLogging(const std::string& log_file) {
+    Common::Log::Initialize(log_file);
+    Common::Log::SetColorConsoleBackendEnabled(true);
+    Common::Log::Start();
+}
+
+namespace {
+
+/// Minimum, average and maximum of a set of durations, in milliseconds
+struct Summary {
+    double min = std::numeric_limits<double>::max();
+    double max = 0.0;
+    double total = 0.0;
+    std::size_t count = 0;
+
+    void Add(std::chrono::nanoseconds duration) {
+        const double ms = std::chrono::duration<double, std::milli>(duration).count();
+        min = std::min(min, ms);
+        max = std::max(max, ms);
+        total += ms;
+        count++;
+    }
+
+    double Average() const {
+        return count ? total / static_cast<double>(count) : 0.0;
+    }
+
+    nlohmann::json ToJson() const {
+        return {{"count", count},
+                {"min_ms", count ? min : 0.0},
+                {"avg_ms", Average()},
+                {"max_ms", max}};
+    }
+
+    std::string ToString() const {
+        return fmt::format("min {:.3f} ms, avg {:.3f} ms, max {:.3f} ms", count ? min : 0.0,
+                           Average(), max);
+    }
+};
+
+} // Anonymous namespace
+
+/// Application entry point
+int main(int argc, char** argv) {
+    int option_index = 0;
+    char* endarg;
+
+    std::string filepath;
+    std::string json_file;
+    std::string trace_file;
+    std::string log_file = "citra-trace.log";
+    u32 iterations = 5;
+    bool use_interpreter = false;
+
+    static struct option long_options[] = {
+        {"iterations", required_argument, 0, 'n'},
+        {"interpreter", no_argument, 0, 'i'},
+        {"json", required_argument, 0, 'j'},
+        {"log-file", required_argument, 0, 'l'},
+        {"trace", required_argument, 0, 't'},
+        {"help", no_argument, 0, 'h'},
+        {"version", no_argument, 0, 'v'},
+        {0, 0, 0, 0},
+    };
+
+    while (optind < argc) {
+        int arg = getopt_long(argc, argv, "n:ij:l:t:hv", long_options, &option_index);
+        if (arg != -1) {
+            switch (static_cast<char>(arg)) {
+            case 'n':
+                iterations = strtoul(optarg, &endarg, 0);
+                break;
+            case 'i':
+                use_interpreter = true;
+                break;
+            case 'j':
+                json_file.assign(optarg);
+                break;
+            case 'l':
+                log_file.assign(optarg);
+                break;
+            case 't':
+                trace_file.assign(optarg);
+                break;
+            case 'h':
+                PrintHelp(argv[0]);
+                return 0;
+            case 'v':
+                PrintVersion();
+                return 0;
+            }
+        } else {
+            filepath = argv[optind];
+            optind++;
+        }
+    }
+
+    if (filepath.empty()) {
+        std::cout << "No trace given!\n\n";
+        PrintHelp(argv[0]);
+        return -1;
+    }
+    if (iterations == 0) {
+        std::cout << "The number of iterations must be at least 1!\n\n";
+        PrintHelp(argv[0]);
+        return -1;
+    }
+
+    InitializeLogging(log_file);
+    Settings::values.use_shader_jit = !use_interpreter;
+    Common::Tracing::SetEnabled(!trace_file.empty());
+
+    Memory::MemorySystem memory{Core::System::GetInstance()};
+    Pica::PicaCore pica{memory, nullptr};
+    SwRenderer::RasterizerSoftware rasterizer{memory, pica};
+    pica.BindRasterizer(&rasterizer);
+
+    CiTrace::Player player{memory, pica, rasterizer};
+    if (!player.Load(filepath)) {
+        std::cout << "Could not load trace " << filepath << "\n";
+        return -1;
+    }
+    const std::size_t frame_count = player.GetFrameCount();
+    std::cout << fmt::format("Replaying {} ({} frames) {} times\n", filepath, frame_count,
+                             iterations);
+
+    std::vector<Summary> frames(frame_count);
+    std::vector<std::size_t> draw_counts(frame_count);
+    Summary replays;
+    Summary draws;
+    u64 output_hash = 0;
+    bool deterministic = true;
+    for (u32 iteration = 0; iteration < iterations; iteration++) {
+        const auto timings = player.Replay();
+        replays.Add(timings.duration);
+        for (std::size_t i = 0; i < std::min(frames.size(), timings.frames.size()); i++) {
+            const auto& frame = timings.frames[i];
+            frames[i].Add(frame.duration);
+            draw_counts[i] = frame.draws.size();
+            for (const auto draw : frame.draws) {
+                draws.Add(draw);
+            }
+        }
+
+        if (iteration == 0) {
+            output_hash = timings.output_hash;
+        } else if (timings.output_hash != output_hash) {
+            deterministic = false;
+        }
+        const double ms = std::chrono::duration<double, std::milli>(timings.duration).count();
+        std::cout << fmt::format("Replay {}: {:.3f} ms, output {:016x}\n", iteration, ms,
+                                 timings.output_hash);
+    }
+
+    std::cout << fmt::format("Replays: {}\n", replays.ToString());
+    for (std::size_t i = 0; i < frames.size(); i++) {
+        std::cout << fmt::format("Frame {}: {} draws, {}\n", i, draw_counts[i],
+                                 frames[i].ToString());
+    }
+    std::cout << fmt::format("Draws: {}\n", draws.ToString());
+    if (!deterministic) {
+        std::cout << "The output differs between replays!\n";
+    }
+
+    if (!trace_file.empty()) {
+        Common::Tracing::SetEnabled(false);
+        if (!Common::Tracing::Export(trace_file)) {
+            std::cout << "Could not write trace to " << trace_file << "\n";
+            return -1;
+        }
+    }
+
+    if (!json_file.empty()) {
+        nlohmann::json report;
+        report["trace"] = filepath;
+        report["iterations"] = iterations;
+        report["shader_jit"] = !use_interpreter;
+        report["replays"] = replays.ToJson();
+        report["draws"] = draws.ToJson();
+        report["output_hash"] = fmt::format("{:016x}", output_hash);
+        report["deterministic"] = deterministic;
+        auto& frames_json = report["frames"] = nlohmann::json::array();
+        for (std::size_t i = 0; i < frames.size(); i++) {
+            auto frame_json = frames[i].ToJson();
+            frame_json["draws"] = draw_counts[i];
+            frames_json.push_back(std::move(frame_json));
+        }
+
+        std::ofstream file;
+        OpenFStream(file, json_file, std::ios_base::out | std::ios_base::trunc);
+        if (!file) {
+            std::cout << "Could not write report to " << json_file << "\n";
+            return -1;
+        }
+        file << report.dump(4) << "\n";
+    }
+
+    return deterministic ? 0 : 1;
+}
@@ -0,0 +1,261 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstring>
+#include <zstd.h>
+#include "common/compressed_file.h"
+#include "common/file_util.h"
+#include "common/logging/log.h"
+#include "common/string_util.h"
+#include "common/worker_pool.h"
+#include "common/zstd_compression.h"
+
+namespace FileUtil {
+
+namespace {
+
+// Upper bound of the block size, to avoid huge allocations on corrupted headers.
+constexpr u32 MaxBlockSize = 16 * 1024 * 1024;
+
+} // Anonymous namespace
+
+std::unique_ptr<CompressedFileReader> CompressedFileReader::Open(RawReader raw_reader) {
+    CompressedFileHeader header;
+    if (raw_reader(&header, sizeof(header), 0) != sizeof(header) ||
+        header.magic != CompressedFileHeader::MAGIC) {
+        return nullptr;
+    }
+    if (header.version != CompressedFileHeader::VERSION || header.block_size == 0 ||
+        header.block_size > MaxBlockSize ||
+        header.block_count !=
+            (header.uncompressed_size + header.block_size - 1) / header.block_size) {
+        LOG_ERROR(Common_Filesystem, "Invalid compressed image header");
+        return nullptr;
+    }
+
+    std::vector<u64_le> raw_index(header.block_count + 1);
+    const std::size_t index_size = raw_index.size() * sizeof(u64_le);
+    if (raw_reader(raw_index.data(), index_size, header.index_offset) != index_size) {
+        LOG_ERROR(Common_Filesystem, "Failed to read compressed image index");
+        return nullptr;
+    }
+    std::vector<u64> index(raw_index.begin(), raw_index.end());
+    if (!std::is_sorted(index.begin(), index.end()) || index.back() > header.index_offset) {
+        LOG_ERROR(Common_Filesystem, "Invalid compressed image index");
+        return nullptr;
+    }
+
+    return std::unique_ptr<CompressedFileReader>(
+        new CompressedFileReader(std::move(raw_reader), header, std::move(index)));
+}
+
+CompressedFileReader::CompressedFileReader(RawReader raw_reader_,
+                                           const CompressedFileHeader& header_,
+                                           std::vector<u64>&& index_)
+    : raw_reader(std::move(raw_reader_)), header(header_), index(std::move(index_)) {}
+
+std::size_t CompressedFileReader::GetBlockSize(std::size_t block) const {
+    const u64 block_offset = static_cast<u64>(block) * header.block_size;
+    return static_cast<std::size_t>(
+        std::min<u64>(header.block_size, header.uncompressed_size - block_offset));
+}
+
+bool CompressedFileReader::DecompressBlock(std::size_t block, std::vector<u8>& out) const {
+    std::vector<u8> compressed(index[block + 1] - index[block]);
+    if (raw_reader(compressed.data(), compressed.size(), index[block]) != compressed.size()) {
+        LOG_ERROR(Common_Filesystem, "Failed to read compressed block {}", block);
+        return false;
+    }
+    out.resize(GetBlockSize(block));
+    const std::size_t result =
+        ZSTD_decompress(out.data(), out.size(), compressed.data(), compressed.size());
+    if (ZSTD_isError(result) || result != out.size()) {
+        LOG_ERROR(Common_Filesystem, "Failed to decompress block {}", block);
+        return false;
+    }
+    return true;
+}
+
+std::size_t CompressedFileReader::ReadAt(void* data, std::size_t length, u64 offset) {
+    if (offset >= header.uncompressed_size) {
+        return 0;
+    }
+    length = static_cast<std::size_t>(std::min<u64>(length, header.uncompressed_size - offset));
+    if (length == 0) {
+        return 0;
+    }
+
+    const std::size_t first_block = static_cast<std::size_t>(offset / header.block_size);
+    const std::size_t last_block =
+        static_cast<std::size_t>((offset + length - 1) / header.block_size);
+    u8* const out = static_cast<u8*>(data);
+
+    // Copies the part of a block overlapping the requested range into the output.
+    const auto copy_block = [&](std::size_t block, const std::vector<u8>& block_data) {
+        const u64 block_start = static_cast<u64>(block) * header.block_size;
+        const u64 copy_start = std::max(offset, block_start);
+        const u64 copy_end = std::min<u64>(offset + length, block_start + block_data.size());
+        std::memcpy(out + (copy_start - offset), block_data.data() + (copy_start - block_start),
+                    static_cast<std::size_t>(copy_end - copy_start));
+    };
+
+    std::vector<std::size_t> missing;
+    {
+        std::scoped_lock lock{cache_mutex};
+        for (std::size_t block = first_block; block <= last_block; block++) {
+            if (cache.contains(block)) {
+                copy_block(block, cache.request(block).second);
+            } else {
+                missing.push_back(block);
+            }
+        }
+    }
+    if (missing.empty()) {
+        return length;
+    }
+
+    // Decompress the missing blocks without holding the cache lock, in parallel if needed.
+    std::vector<std::vector<u8>> decompressed(missing.size());
+    std::vector<u8> succeeded(missing.size());
+    Common::ParallelFor(missing.size(), [&](std::size_t i) {
+        succeeded[i] = DecompressBlock(missing[i], decompressed[i]);
+        if (succeeded[i]) {
+            copy_block(missing[i], decompressed[i]);
+        }
+    });
+
+    std::scoped_lock lock{cache_mutex};
+    for (std::size_t i = 0; i < missing.size(); i++) {
+        if (!succeeded[i]) {
+            // Only report the data up to the first block that failed to decompress.
+            const u64 block_start = static_cast<u64>(missing[i]) * header.block_size;
+            return static_cast<std::size_t>(std::max(offset, block_start) - offset);
+        }
+        cache.request(missing[i]).second = std::move(decompressed[i]);
+    }
+    return length;
+}
+
+namespace {
+
+/// Writes the compressed image of source to dest, returns whether it succeeded.
+bool WriteCompressedImage(IOFile& source, IOFile& dest, const std::string& source_path,
+                          const std::string& dest_path, s32 compression_level, u32 block_size) {
+    if (block_size == 0 || block_size > MaxBlockSize) {
+        LOG_ERROR(Common_Filesystem, "Invalid block size {}", block_size);
+        return false;
+    }
+
+    CompressedFileHeader header{};
+    header.magic = CompressedFileHeader::MAGIC;
+    header.version = CompressedFileHeader::VERSION;
+    header.uncompressed_size = source.GetSize();
+    header.block_size = block_size;
+    header.block_count =
+        static_cast<u32>((header.uncompressed_size + block_size - 1) / block_size);
+
+    std::vector<u64_le> index;
+    index.reserve(header.block_count + 1);
+    u64 write_offset = sizeof(CompressedFileHeader);
+    if (!dest.Seek(write_offset, SEEK_SET)) {
+        return false;
+    }
+
+    // Compress batches of blocks in parallel, writing them out in order.
+    const std::size_t batch_size = Common::TaskGroup::NumWorkers() + 1;
+    std::vector<std::vector<u8>> blocks(batch_size);
+    std::vector<std::vector<u8>> compressed(batch_size);
+    for (u32 batch_start = 0; batch_start < header.block_count; batch_start += batch_size) {
+        const std::size_t count =
+            std::min<std::size_t>(batch_size, header.block_count - batch_start);
+        for (std::size_t i = 0; i < count; i++) {
+            const u64 block_offset = static_cast<u64>(batch_start + i) * block_size;
+            blocks[i].resize(static_cast<std::size_t>(
+                std::min<u64>(block_size, header.uncompressed_size - block_offset)));
+            if (source.ReadBytes(blocks[i].data(), blocks[i].size()) != blocks[i].size()) {
+                LOG_ERROR(Common_Filesystem, "Failed to read {}", source_path);
+                return false;
+            }
+        }
+
+        Common::ParallelFor(count, [&](std::size_t i) {
+            compressed[i] = Common::Compression::CompressDataZSTD(blocks[i], compression_level);
+        });
+
+        for (std::size_t i = 0; i < count; i++) {
+            if (compressed[i].empty() ||
+                dest.WriteBytes(compressed[i].data(), compressed[i].size()) !=
+                    compressed[i].size()) {
+                LOG_ERROR(Common_Filesystem, "Failed to write {}", dest_path);
+                return false;
+            }
+            index.push_back(write_offset);
+            write_offset += compressed[i].size();
+        }
+    }
+    index.push_back(write_offset);
+
+    header.index_offset = write_offset;
+    const std::size_t index_size = index.size() * sizeof(u64_le);
+    if (dest.WriteBytes(index.data(), index_size) != index_size || !dest.Seek(0, SEEK_SET) ||
+        dest.WriteObject(header) != 1) {
+        LOG_ERROR(Common_Filesystem, "Failed to write {}", dest_path);
+        return false;
+    }
+
+    LOG_INFO(Common_Filesystem, "Compressed {} ({} bytes) to {} ({} bytes)", source_path,
+             header.uncompressed_size, dest_path, write_offset + index_size);
+    return true;
+}
+
+} // Anonymous namespace
+
+std::string GetCompressedExtension(std::string_view extension) {
+    // ".cia" -> ".zcia"
+    if (extension.starts_with('.')) {
+        extension.remove_prefix(1);
+    }
+    return ".z" + std::string{extension};
+}
+
+bool IsCompressedImagePath(std::string_view path) {
+    static constexpr std::array<std::string_view, 8> CompressedExtensions{
+        "zcci", "z3ds", "zcxi", "zapp", "z3dsx", "zcia", "zelf", "zaxf"};
+    const std::size_t dot = path.find_last_of('.');
+    if (dot == std::string_view::npos) {
+        return false;
+    }
+    const std::string extension = Common::ToLower(std::string{path.substr(dot + 1)});
+    return std::find(CompressedExtensions.begin(), CompressedExtensions.end(), extension) !=
+           CompressedExtensions.end();
+}
+
+bool CompressFile(const std::string& source_path, const std::string& dest_path,
+                  s32 compression_level, u32 block_size) {
+    IOFile source(source_path, "rb");
+    if (!source.IsOpen()) {
+        LOG_ERROR(Common_Filesystem, "Could not open {}", source_path);
+        return false;
+    }
+    if (source.IsCompressed()) {
+        LOG_ERROR(Common_Filesystem, "{} is already compressed", source_path);
+        return false;
+    }
+    IOFile dest(dest_path, "wb");
+    if (!dest.IsOpen()) {
+        LOG_ERROR(Common_Filesystem, "Could not create {}", dest_path);
+        return false;
+    }
+    if (!WriteCompressedImage(source, dest, source_path, dest_path, compression_level,
+                              block_size)) {
+        // Do not leave a truncated image behind, it would be listed as a game
+        dest.Close();
+        Delete(dest_path);
+        return false;
+    }
+    return true;
+}
+
+} // namespace FileUtil
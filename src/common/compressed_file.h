@@ -0,0 +1,97 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "common/common_types.h"
+#include "common/static_lru_cache.h"
+#include "common/swap.h"
+
+namespace FileUtil {
+
+/**
+ * Compressed images split the original file in fixed size blocks, each compressed as an
+ * independent zstd frame. An index of the frame offsets, stored after the frames, allows
+ * random access to any part of the uncompressed data.
+ *
+ * Layout: Header, frames, index (block_count + 1 little endian u64 offsets, the last one
+ * being the end of the last frame).
+ */
+struct CompressedFileHeader {
+    static constexpr std::array<char, 4> MAGIC{'C', 'Z', '3', 'D'};
+    static constexpr u32 VERSION = 1;
+
+    std::array<char, 4> magic;
+    u32_le version;
+    u64_le uncompressed_size;
+    u32_le block_size;
+    u32_le block_count;
+    u64_le index_offset;
+};
+static_assert(sizeof(CompressedFileHeader) == 0x20, "CompressedFileHeader has incorrect size");
+
+/**
+ * Random access reader of compressed images. Reads spanning several blocks decompress them in
+ * parallel, and recently used blocks are kept decompressed in a cache.
+ */
+class CompressedFileReader {
+public:
+    /// Reads length bytes at offset from the underlying (compressed) file, returns bytes read.
+    using RawReader = std::function<std::size_t(void* data, std::size_t length, u64 offset)>;
+
+    /// Returns a reader if the file read by raw_reader is a valid compressed image.
+    static std::unique_ptr<CompressedFileReader> Open(RawReader raw_reader);
+
+    [[nodiscard]] u64 GetSize() const {
+        return header.uncompressed_size;
+    }
+
+    /// Reads uncompressed data, returns the amount of bytes read. Thread safe.
+    std::size_t ReadAt(void* data, std::size_t length, u64 offset);
+
+private:
+    CompressedFileReader(RawReader raw_reader, const CompressedFileHeader& header,
+                         std::vector<u64>&& index);
+
+    std::size_t GetBlockSize(std::size_t block) const;
+    bool DecompressBlock(std::size_t block, std::vector<u8>& out) const;
+
+    static constexpr std::size_t CacheBlockCount = 16;
+
+    RawReader raw_reader;
+    CompressedFileHeader header;
+    std::vector<u64> index;
+
+    std::mutex cache_mutex;
+    Common::StaticLRUCache<std::size_t, std::vector<u8>, CacheBlockCount> cache;
+};
+
+/// Returns the extension used by compressed images of files with the given extension.
+[[nodiscard]] std::string GetCompressedExtension(std::string_view extension);
+
+/**
+ * Returns whether the path has the extension of a compressed image. Only those files are probed
+ * for the compressed format when opened, other files are always read as they are.
+ */
+[[nodiscard]] bool IsCompressedImagePath(std::string_view path);
+
+/**
+ * Compresses a file into a compressed image.
+ * @param source_path Path of the file to compress
+ * @param dest_path Path of the compressed image to create
+ * @param compression_level zstd compression level, between 1 and 22
+ * @param block_size Size of the independently compressed blocks
+ * @returns whether the file was compressed successfully
+ */
+bool CompressFile(const std::string& source_path, const std::string& dest_path,
+                  s32 compression_level = 19, u32 block_size = 256 * 1024);
+
+} // namespace FileUtil
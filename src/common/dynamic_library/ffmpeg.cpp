@@ -11,6 +11,7 @@
 namespace DynamicLibrary::FFmpeg {
 
 // avutil
+av_buffer_create_func av_buffer_create;
 av_buffer_ref_func av_buffer_ref;
 av_buffer_unref_func av_buffer_unref;
 av_d2q_func av_d2q;
@@ -146,6 +147,7 @@ static bool LoadAVUtil() {
         return false;
     }
 
+    LOAD_SYMBOL(avutil, av_buffer_create);
     LOAD_SYMBOL(avutil, av_buffer_ref);
     LOAD_SYMBOL(avutil, av_buffer_unref);
     LOAD_SYMBOL(avutil, av_d2q);
@@ -18,6 +18,12 @@ extern "C" {
 namespace DynamicLibrary::FFmpeg {
 
 // avutil
+#if LIBAVUTIL_VERSION_MAJOR >= 57
+typedef AVBufferRef* (*av_buffer_create_func)(uint8_t*, size_t, void (*)(void*, uint8_t*), void*,
+                                              int);
+#else
+typedef AVBufferRef* (*av_buffer_create_func)(uint8_t*, int, void (*)(void*, uint8_t*), void*, int);
+#endif
 typedef AVBufferRef* (*av_buffer_ref_func)(const AVBufferRef*);
 typedef void (*av_buffer_unref_func)(AVBufferRef**);
 typedef AVRational (*av_d2q_func)(double d, int max);
@@ -59,6 +65,7 @@ typedef int (*av_samples_alloc_array_and_samples_func)(uint8_t***, int*, int, in
 typedef char* (*av_strdup_func)(const char*);
 typedef unsigned (*avutil_version_func)();
 
+extern av_buffer_create_func av_buffer_create;
 extern av_buffer_ref_func av_buffer_ref;
 extern av_buffer_unref_func av_buffer_unref;
 extern av_d2q_func av_d2q;
@@ -14,6 +14,7 @@
 #include "common/assert.h"
 #include "common/common_funcs.h"
 #include "common/common_paths.h"
+#include "common/compressed_file.h"
 #include "common/error.h"
 #include "common/file_util.h"
 #include "common/logging/log.h"
@@ -315,6 +316,30 @@ bool Rename(const std::string& srcFilename, const std::string& destFilename) {
     return false;
 }
 
+bool RenameReplace(const std::string& srcFilename, const std::string& destFilename) {
+    LOG_TRACE(Common_Filesystem, "{} --> {}", srcFilename, destFilename);
+#ifdef _WIN32
+    if (MoveFileExW(Common::UTF8ToUTF16W(srcFilename).c_str(),
+                    Common::UTF8ToUTF16W(destFilename).c_str(),
+                    MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+        return true;
+#elif ANDROID
+    // Storage access framework renames can not replace a file
+    if (Exists(destFilename)) {
+        Delete(destFilename);
+    }
+    if (AndroidStorage::RenameFile(srcFilename, std::string(GetFilename(destFilename))))
+        return true;
+#else
+    // rename replaces the destination atomically
+    if (rename(srcFilename.c_str(), destFilename.c_str()) == 0)
+        return true;
+#endif
+    LOG_ERROR(Common_Filesystem, "failed {} --> {}: {}", srcFilename, destFilename,
+              GetLastErrorMsg());
+    return false;
+}
+
 bool Copy(const std::string& srcFilename, const std::string& destFilename) {
     LOG_TRACE(Common_Filesystem, "{} --> {}", srcFilename, destFilename);
 #ifdef _WIN32
@@ -404,6 +429,26 @@ u64 GetSize(const std::string& filename) {
     return 0;
 }
 
+s64 GetModificationTime(const std::string& filename) {
+#ifdef ANDROID
+    // Content URIs do not expose it
+    return 0;
+#else
+    struct stat buf;
+#ifdef _WIN32
+    if (_wstat64(Common::UTF8ToUTF16W(filename).c_str(), &buf) == 0)
+#else
+    if (stat(filename.c_str(), &buf) == 0)
+#endif
+    {
+        return static_cast<s64>(buf.st_mtime);
+    }
+
+    LOG_ERROR(Common_Filesystem, "Stat failed {}: {}", filename, GetLastErrorMsg());
+    return 0;
+#endif
+}
+
 u64 GetSize(const int fd) {
     struct stat buf;
     if (fstat(fd, &buf) != 0) {
@@ -1065,6 +1110,8 @@ void IOFile::Swap(IOFile& other) noexcept {
     std::swap(filename, other.filename);
     std::swap(openmode, other.openmode);
     std::swap(flags, other.flags);
+    std::swap(m_compressed, other.m_compressed);
+    std::swap(m_compressed_pos, other.m_compressed_pos);
 }
 
 bool IOFile::Open() {
@@ -1113,6 +1160,10 @@ bool IOFile::Open() {
     m_good = m_file != nullptr;
 #endif
 
+    if (m_good && openmode == "rb" && IsCompressedImagePath(filename)) {
+        DetectCompression();
+    }
+
     return m_good;
 }
 
@@ -1121,10 +1172,15 @@ bool IOFile::Close() {
         m_good = false;
 
     m_file = nullptr;
+    m_compressed.reset();
+    m_compressed_pos = 0;
     return m_good;
 }
 
 u64 IOFile::GetSize() const {
+    if (m_compressed)
+        return m_compressed->GetSize();
+
     if (IsOpen())
         return FileUtil::GetSize(m_file);
 
@@ -1132,6 +1188,21 @@ u64 IOFile::GetSize() const {
 }
 
 bool IOFile::Seek(s64 off, int origin) {
+    if (m_compressed) {
+        s64 base = 0;
+        if (origin == SEEK_CUR) {
+            base = static_cast<s64>(m_compressed_pos);
+        } else if (origin == SEEK_END) {
+            base = static_cast<s64>(m_compressed->GetSize());
+        }
+        if (base + off < 0) {
+            m_good = false;
+        } else {
+            m_compressed_pos = static_cast<u64>(base + off);
+        }
+        return m_good;
+    }
+
     if (!IsOpen() || 0 != fseeko(m_file, off, origin))
         m_good = false;
 
@@ -1139,6 +1210,9 @@ bool IOFile::Seek(s64 off, int origin) {
 }
 
 u64 IOFile::Tell() const {
+    if (m_compressed)
+        return m_compressed_pos;
+
     if (IsOpen())
         return ftello(m_file);
 
@@ -1164,6 +1238,13 @@ std::size_t IOFile::ReadImpl(void* data, std::size_t length, std::size_t data_si
 
     DEBUG_ASSERT(data != nullptr);
 
+    if (m_compressed) {
+        const std::size_t read =
+            m_compressed->ReadAt(data, data_size * length, m_compressed_pos) / data_size;
+        m_compressed_pos += read * data_size;
+        return read;
+    }
+
     return std::fread(data, data_size, length, m_file);
 }
 
@@ -1188,6 +1269,23 @@ static std::size_t pread(int fd, void* buf, std::size_t count, uint64_t offset)
 #define pread ::pread
 #endif
 
+std::size_t ReadAt(int fd, void* data, std::size_t length, u64 offset) {
+    return static_cast<std::size_t>(pread(fd, data, length, offset));
+}
+
+void IOFile::DetectCompression() {
+    const int fd = fileno(m_file);
+    m_compressed = CompressedFileReader::Open([fd](void* data, std::size_t length, u64 offset) {
+        return static_cast<std::size_t>(pread(fd, data, length, offset));
+    });
+    m_compressed_pos = 0;
+
+    // The pread emulation on Windows moves the file position, rewind for sequential reads
+    if (!m_compressed && 0 != fseeko(m_file, 0, SEEK_SET)) {
+        m_good = false;
+    }
+}
+
 std::size_t IOFile::ReadAtImpl(void* data, std::size_t length, std::size_t data_size,
                                std::size_t offset) {
     if (!IsOpen()) {
@@ -1201,6 +1299,10 @@ std::size_t IOFile::ReadAtImpl(void* data, std::size_t length, std::size_t data_
 
     DEBUG_ASSERT(data != nullptr);
 
+    if (m_compressed) {
+        return m_compressed->ReadAt(data, data_size * length, offset);
+    }
+
     return pread(fileno(m_file), data, data_size * length, offset);
 }
 
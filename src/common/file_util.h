@@ -9,6 +9,7 @@
 #include <functional>
 #include <ios>
 #include <limits>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -102,6 +103,9 @@ private:
 // Overloaded GetSize, accepts file descriptor
 [[nodiscard]] u64 GetSize(int fd);
 
+// Returns the last modification time of filename in seconds since the epoch, 0 if unknown
+[[nodiscard]] s64 GetModificationTime(const std::string& filename);
+
 // Overloaded GetSize, accepts FILE*
 [[nodiscard]] u64 GetSize(FILE* f);
 
@@ -121,6 +125,10 @@ bool DeleteDir(const std::string& filename);
 // renames file srcFilename to destFilename, returns true on success
 bool Rename(const std::string& srcFilename, const std::string& destFilename);
 
+// renames file srcFilename to destFilename, atomically replacing destFilename if it exists, so
+// that destFilename is never missing. Not atomic on Android. Returns true on success
+bool RenameReplace(const std::string& srcFilename, const std::string& destFilename);
+
 // copies file srcFilename to destFilename, returns true on success
 bool Copy(const std::string& srcFilename, const std::string& destFilename);
 
@@ -258,9 +266,17 @@ enum class DirectorySeparator {
     std::string_view path,
     DirectorySeparator directory_separator = DirectorySeparator::ForwardSlash);
 
+// Reads from a file descriptor at offset without moving its file position.
+// Returns the number of bytes read, or std::numeric_limits<std::size_t>::max() on error.
+std::size_t ReadAt(int fd, void* data, std::size_t length, u64 offset);
+
+class CompressedFileReader;
+
 // simple wrapper for cstdlib file functions to
 // hopefully will make error checking easier
 // and make forgetting an fclose() harder
+// Compressed images (see IsCompressedImagePath) opened in "rb" mode are transparently
+// decompressed.
 class IOFile : public NonCopyable {
 public:
     IOFile();
@@ -351,6 +367,15 @@ public:
     [[nodiscard]] bool IsGood() const {
         return m_good;
     }
+    // Path the file was opened with
+    [[nodiscard]] const std::string& GetPath() const {
+        return filename;
+    }
+    // Whether reads go through a compressed image. GetFd refers to the compressed data then.
+    [[nodiscard]] bool IsCompressed() const {
+        return m_compressed != nullptr;
+    }
+
     [[nodiscard]] int GetFd() const {
 #ifdef ANDROID
         return m_fd;
@@ -383,11 +408,15 @@ private:
     std::size_t WriteImpl(const void* data, std::size_t length, std::size_t data_size);
 
     bool Open();
+    void DetectCompression();
 
     std::FILE* m_file = nullptr;
     int m_fd = -1;
     bool m_good = true;
 
+    std::unique_ptr<CompressedFileReader> m_compressed;
+    u64 m_compressed_pos = 0;
+
     std::string filename;
     std::string openmode;
     u32 flags;
@@ -0,0 +1,564 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "common/file_util.h"
+#include "common/host_io.h"
+#include "common/logging/log.h"
+#include "common/polyfill_thread.h"
+#include "common/thread.h"
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/version.h>
+// IORING_OP_READ, an enumerator that cannot be tested by the preprocessor, came with the 5.6 kernel
+// headers. Older headers fall back to the thread pool.
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 6, 0)
+#define HAVE_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#endif
+
+namespace Common {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct {
+    std::atomic<u64> completed;
+    std::atomic<u64> total_latency_us;
+    std::atomic<u32> queue_depth;
+    std::atomic<u32> max_queue_depth;
+} g_stats;
+
+void OnSubmitted(std::size_t count) {
+    const u32 depth = g_stats.queue_depth.fetch_add(static_cast<u32>(count)) +
+                      static_cast<u32>(count);
+    u32 max_depth = g_stats.max_queue_depth.load(std::memory_order_relaxed);
+    while (depth > max_depth && !g_stats.max_queue_depth.compare_exchange_weak(max_depth, depth)) {
+    }
+}
+
+void OnCompleted(Clock::time_point submitted) {
+    const auto latency =
+        std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - submitted);
+    g_stats.queue_depth.fetch_sub(1);
+    g_stats.completed.fetch_add(1);
+    g_stats.total_latency_us.fetch_add(static_cast<u64>(latency.count()));
+}
+
+/// Reads a range, reading again after short reads until the end of the file is reached.
+s64 ReadRange(const HostIOEngine::ReadRequest& read) {
+    std::size_t total = 0;
+    while (total < read.buffer.size()) {
+        const std::size_t result =
+            FileUtil::ReadAt(read.fd, read.buffer.data() + total, read.buffer.size() - total,
+                             read.offset + total);
+        if (result == std::numeric_limits<std::size_t>::max()) {
+            return -EIO;
+        }
+        if (result == 0) {
+            break;
+        }
+        total += result;
+    }
+    return static_cast<s64>(total);
+}
+
+/**
+ * Operations submitted together, completed once all of them are. The reads of a batch cover
+ * contiguous ranges, so the batch result stops at the first read that came short: the buffers of
+ * the reads after it do not follow the data read.
+ */
+class Batch {
+public:
+    /// @param sizes Size of each operation, the maximum value for tasks
+    Batch(std::vector<u64> sizes_, HostIOEngine::Completion done_)
+        : sizes(std::move(sizes_)), results(sizes.size()), remaining(sizes.size()),
+          done(std::move(done_)) {}
+
+    void Complete(std::size_t index, s64 result) {
+        results[index] = result;
+        if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            done(GetResult());
+        }
+    }
+
+private:
+    s64 GetResult() const {
+        s64 total = 0;
+        for (std::size_t i = 0; i < results.size(); i++) {
+            if (results[i] < 0) {
+                return results[i];
+            }
+            total += results[i];
+            if (static_cast<u64>(results[i]) < sizes[i]) {
+                break;
+            }
+        }
+        return total;
+    }
+
+    const std::vector<u64> sizes;
+    std::vector<s64> results;
+    std::atomic<std::size_t> remaining;
+    HostIOEngine::Completion done;
+};
+
+/// Counts the operations of each owner which did not complete yet
+class OwnerTracker {
+public:
+    void Add(u64 owner, std::size_t count) {
+        std::scoped_lock lock{mutex};
+        active[owner] += count;
+    }
+
+    void Remove(u64 owner) {
+        std::scoped_lock lock{mutex};
+        const auto it = active.find(owner);
+        if (--it->second == 0) {
+            active.erase(it);
+            idle.notify_all();
+        }
+    }
+
+    void Wait(u64 owner) {
+        std::unique_lock lock{mutex};
+        idle.wait(lock, [this, owner] { return !active.contains(owner); });
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable idle;
+    std::unordered_map<u64, std::size_t> active;
+};
+
+class ThreadPoolIOEngine final : public HostIOEngine {
+public:
+    explicit ThreadPoolIOEngine(std::size_t num_threads) {
+        threads.reserve(num_threads);
+        for (std::size_t i = 0; i < num_threads; i++) {
+            threads.emplace_back([this](std::stop_token stop_token) { WorkerLoop(stop_token); });
+        }
+    }
+
+    ~ThreadPoolIOEngine() override {
+        for (auto& thread : threads) {
+            thread.request_stop();
+        }
+        condition.notify_all();
+    }
+
+    void SubmitReads(u64 owner, std::span<const ReadRequest> reads, Completion done) override {
+        std::vector<u64> sizes;
+        std::vector<Task> tasks;
+        sizes.reserve(reads.size());
+        tasks.reserve(reads.size());
+        for (const auto& read : reads) {
+            sizes.push_back(read.buffer.size());
+            tasks.emplace_back([read] { return ReadRange(read); });
+        }
+        Enqueue(owner, std::move(tasks),
+                std::make_shared<Batch>(std::move(sizes), std::move(done)));
+    }
+
+    void SubmitTask(u64 owner, Task task, Completion done) override {
+        std::vector<Task> tasks;
+        tasks.emplace_back(std::move(task));
+        Enqueue(owner, std::move(tasks),
+                std::make_shared<Batch>(std::vector{std::numeric_limits<u64>::max()},
+                                        std::move(done)));
+    }
+
+    void Cancel(u64 owner) override {
+        std::vector<Job> cancelled;
+        {
+            std::scoped_lock lock{queue_mutex};
+            const auto it = std::stable_partition(queue.begin(), queue.end(), [owner](auto& job) {
+                return job.owner != owner;
+            });
+            std::move(it, queue.end(), std::back_inserter(cancelled));
+            queue.erase(it, queue.end());
+        }
+        for (auto& job : cancelled) {
+            Finish(job, -ECANCELED);
+        }
+        tracker.Wait(owner);
+    }
+
+    const char* GetName() const override {
+        return "thread pool";
+    }
+
+private:
+    struct Job {
+        u64 owner;
+        Task task;
+        std::shared_ptr<Batch> batch;
+        std::size_t index; ///< Index of the operation in its batch
+        Clock::time_point submitted;
+    };
+
+    void Enqueue(u64 owner, std::vector<Task> tasks, std::shared_ptr<Batch> batch) {
+        const auto now = Clock::now();
+        tracker.Add(owner, tasks.size());
+        OnSubmitted(tasks.size());
+        {
+            std::scoped_lock lock{queue_mutex};
+            for (std::size_t i = 0; i < tasks.size(); i++) {
+                queue.push_back({owner, std::move(tasks[i]), batch, i, now});
+            }
+        }
+        condition.notify_all();
+    }
+
+    void Finish(Job& job, s64 result) {
+        OnCompleted(job.submitted);
+        job.batch->Complete(job.index, result);
+        tracker.Remove(job.owner);
+    }
+
+    void WorkerLoop(std::stop_token stop_token) {
+        SetCurrentThreadName("HostIO");
+        while (!stop_token.stop_requested()) {
+            Job job;
+            {
+                std::unique_lock lock{queue_mutex};
+                CondvarWait(condition, lock, stop_token, [this] { return !queue.empty(); });
+                if (stop_token.stop_requested()) {
+                    return;
+                }
+                job = std::move(queue.front());
+                queue.pop_front();
+            }
+            Finish(job, job.task());
+        }
+    }
+
+    std::mutex queue_mutex;
+    std::condition_variable_any condition;
+    std::deque<Job> queue;
+    OwnerTracker tracker;
+    std::vector<std::jthread> threads;
+};
+
+#ifdef HAVE_IO_URING
+
+int IoUringSetup(u32 entries, io_uring_params* params) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int IoUringEnter(int ring_fd, u32 to_submit, u32 min_complete, u32 flags) {
+    return static_cast<int>(
+        syscall(__NR_io_uring_enter, ring_fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+class IoUringEngine final : public HostIOEngine {
+public:
+    IoUringEngine(int ring_fd_, const io_uring_params& params)
+        : ring_fd(ring_fd_), task_pool(2) {
+        sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(u32);
+        cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single_mmap) {
+            sq_ring_size = cq_ring_size = std::max(sq_ring_size, cq_ring_size);
+        }
+
+        sq_ring = mmap(nullptr, sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                       ring_fd, IORING_OFF_SQ_RING);
+        cq_ring = single_mmap ? sq_ring
+                              : mmap(nullptr, cq_ring_size, PROT_READ | PROT_WRITE,
+                                     MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_CQ_RING);
+        sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqes_map = mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE,
+                              MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQES);
+        if (sq_ring == MAP_FAILED || cq_ring == MAP_FAILED || sqes_map == MAP_FAILED) {
+            return;
+        }
+
+        auto* sq = static_cast<u8*>(sq_ring);
+        sq_head = reinterpret_cast<u32*>(sq + params.sq_off.head);
+        sq_tail = reinterpret_cast<u32*>(sq + params.sq_off.tail);
+        sq_mask = *reinterpret_cast<u32*>(sq + params.sq_off.ring_mask);
+        sq_array = reinterpret_cast<u32*>(sq + params.sq_off.array);
+        sqes = static_cast<io_uring_sqe*>(sqes_map);
+        sq_entries = params.sq_entries;
+
+        auto* cq = static_cast<u8*>(cq_ring);
+        cq_head = reinterpret_cast<u32*>(cq + params.cq_off.head);
+        cq_tail = reinterpret_cast<u32*>(cq + params.cq_off.tail);
+        cq_mask = *reinterpret_cast<u32*>(cq + params.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+        completion_thread = std::thread([this] { CompletionLoop(); });
+    }
+
+    ~IoUringEngine() override {
+        if (completion_thread.joinable()) {
+            {
+                std::scoped_lock lock{submit_mutex};
+                PushSqe(IORING_OP_NOP, -1, 0, 0, 0, StopTag);
+                SubmitQueued(1);
+            }
+            completion_thread.join();
+        }
+        if (sqes) {
+            munmap(sqes, sqes_size);
+        }
+        if (cq_ring != MAP_FAILED && cq_ring != sq_ring) {
+            munmap(cq_ring, cq_ring_size);
+        }
+        if (sq_ring != MAP_FAILED) {
+            munmap(sq_ring, sq_ring_size);
+        }
+        close(ring_fd);
+    }
+
+    bool IsValid() const {
+        return completion_thread.joinable();
+    }
+
+    void SubmitReads(u64 owner, std::span<const ReadRequest> reads, Completion done) override {
+        std::vector<u64> sizes;
+        sizes.reserve(reads.size());
+        for (const auto& read : reads) {
+            sizes.push_back(read.buffer.size());
+        }
+        auto batch = std::make_shared<Batch>(std::move(sizes), std::move(done));
+        tracker.Add(owner, reads.size());
+        OnSubmitted(reads.size());
+
+        std::unique_lock lock{submit_mutex};
+        const auto now = Clock::now();
+        std::size_t queued = 0;
+        for (std::size_t i = 0; i < reads.size(); i++) {
+            const auto& read = reads[i];
+            // Keep the completion queue from overflowing
+            if (in_flight == sq_entries) {
+                SubmitQueued(queued);
+                queued = 0;
+                slot_free.wait(lock, [this] { return in_flight < sq_entries; });
+            }
+            const u64 id = next_id++;
+            operations.emplace(id, Operation{owner, read, batch, i, now});
+            PushSqe(IORING_OP_READ, read.fd, reinterpret_cast<u64>(read.buffer.data()),
+                    static_cast<u32>(read.buffer.size()), read.offset, id);
+            in_flight++;
+            queued++;
+        }
+        SubmitQueued(queued);
+    }
+
+    void SubmitTask(u64 owner, Task task, Completion done) override {
+        task_pool.SubmitTask(owner, std::move(task), std::move(done));
+    }
+
+    void Cancel(u64 owner) override {
+        task_pool.Cancel(owner);
+        {
+            std::scoped_lock lock{submit_mutex};
+            std::size_t queued = 0;
+            for (const auto& [id, operation] : operations) {
+                if (operation.owner == owner && queued < sq_entries) {
+                    PushSqe(IORING_OP_ASYNC_CANCEL, -1, id, 0, 0, CancelTag);
+                    queued++;
+                }
+            }
+            SubmitQueued(queued);
+        }
+        tracker.Wait(owner);
+    }
+
+    const char* GetName() const override {
+        return "io_uring";
+    }
+
+private:
+    static constexpr u64 StopTag = std::numeric_limits<u64>::max();
+    static constexpr u64 CancelTag = StopTag - 1;
+
+    struct Operation {
+        u64 owner;
+        ReadRequest read;
+        std::shared_ptr<Batch> batch;
+        std::size_t index; ///< Index of the read in its batch
+        Clock::time_point submitted;
+    };
+
+    /// Queues a submission, submit_mutex must be held
+    void PushSqe(u8 opcode, int fd, u64 addr, u32 length, u64 offset, u64 user_data) {
+        const u32 tail = *sq_tail;
+        const u32 index = tail & sq_mask;
+        io_uring_sqe& sqe = sqes[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = opcode;
+        sqe.fd = fd;
+        sqe.addr = addr;
+        sqe.len = length;
+        sqe.off = offset;
+        sqe.user_data = user_data;
+        sq_array[index] = index;
+        std::atomic_ref<u32>(*sq_tail).store(tail + 1, std::memory_order_release);
+    }
+
+    /// Hands the queued submissions to the kernel, submit_mutex must be held
+    void SubmitQueued(std::size_t count) {
+        while (count > 0) {
+            const int submitted = IoUringEnter(ring_fd, static_cast<u32>(count), 0, 0);
+            if (submitted < 0) {
+                if (errno == EINTR || errno == EAGAIN || errno == EBUSY) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                LOG_CRITICAL(Common_Filesystem, "io_uring submission failed: {}",
+                             std::strerror(errno));
+                return;
+            }
+            count -= static_cast<std::size_t>(submitted);
+        }
+    }
+
+    void CompletionLoop() {
+        SetCurrentThreadName("HostIO");
+        bool stopping = false;
+        while (!stopping) {
+            if (IoUringEnter(ring_fd, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR) {
+                LOG_CRITICAL(Common_Filesystem, "io_uring wait failed: {}", std::strerror(errno));
+                return;
+            }
+
+            u32 head = *cq_head;
+            const u32 tail = std::atomic_ref<u32>(*cq_tail).load(std::memory_order_acquire);
+            for (; head != tail; head++) {
+                const io_uring_cqe cqe = cqes[head & cq_mask];
+                std::atomic_ref<u32>(*cq_head).store(head + 1, std::memory_order_release);
+                if (cqe.user_data == StopTag) {
+                    stopping = true;
+                } else if (cqe.user_data != CancelTag) {
+                    Complete(cqe.user_data, cqe.res);
+                }
+            }
+        }
+    }
+
+    void Complete(u64 id, s32 result) {
+        Operation operation;
+        {
+            std::scoped_lock lock{submit_mutex};
+            const auto it = operations.find(id);
+            operation = std::move(it->second);
+            operations.erase(it);
+            in_flight--;
+        }
+        slot_free.notify_one();
+
+        // Kernels before 5.6 lack IORING_OP_READ. The rest of a short read is read here, the kernel
+        // may stop a read early, for example when a signal arrives.
+        s64 total = result;
+        if (result == -EINVAL || result == -EOPNOTSUPP) {
+            total = ReadRange(operation.read);
+        } else if (result > 0 && static_cast<std::size_t>(result) < operation.read.buffer.size()) {
+            const auto& read = operation.read;
+            const s64 rest = ReadRange(
+                {read.fd, read.offset + static_cast<u64>(result), read.buffer.subspan(result)});
+            total = rest < 0 ? rest : total + rest;
+        }
+
+        OnCompleted(operation.submitted);
+        operation.batch->Complete(operation.index, total);
+        tracker.Remove(operation.owner);
+    }
+
+    int ring_fd;
+    void* sq_ring = MAP_FAILED;
+    void* cq_ring = MAP_FAILED;
+    std::size_t sq_ring_size{};
+    std::size_t cq_ring_size{};
+    std::size_t sqes_size{};
+    u32* sq_head{};
+    u32* sq_tail{};
+    u32 sq_mask{};
+    u32* sq_array{};
+    io_uring_sqe* sqes{};
+    u32 sq_entries{};
+    u32* cq_head{};
+    u32* cq_tail{};
+    u32 cq_mask{};
+    io_uring_cqe* cqes{};
+
+    std::mutex submit_mutex;
+    std::condition_variable slot_free;
+    std::unordered_map<u64, Operation> operations;
+    u64 next_id{};
+    u32 in_flight{};
+
+    OwnerTracker tracker;
+    ThreadPoolIOEngine task_pool; // Runs the tasks, which are not plain reads
+    std::thread completion_thread;
+};
+
+#endif
+
+} // Anonymous namespace
+
+HostIOEngine::~HostIOEngine() = default;
+
+HostIOEngine& HostIOEngine::Get() {
+    static const std::unique_ptr<HostIOEngine> engine = [] {
+        auto io_uring = CreateIoUringEngine(64);
+        auto result = io_uring ? std::move(io_uring) : CreateThreadPoolIOEngine(4);
+        LOG_INFO(Common_Filesystem, "Using the {} host I/O engine", result->GetName());
+        return result;
+    }();
+    return *engine;
+}
+
+HostIOStats HostIOEngine::TakeStats() {
+    HostIOStats stats;
+    stats.completed = g_stats.completed.exchange(0);
+    stats.total_latency_us = g_stats.total_latency_us.exchange(0);
+    stats.queue_depth = g_stats.queue_depth.load();
+    stats.max_queue_depth = g_stats.max_queue_depth.exchange(stats.queue_depth);
+    return stats;
+}
+
+std::unique_ptr<HostIOEngine> CreateThreadPoolIOEngine(std::size_t num_threads) {
+    return std::make_unique<ThreadPoolIOEngine>(num_threads);
+}
+
+std::unique_ptr<HostIOEngine> CreateIoUringEngine(u32 queue_size) {
+#ifdef HAVE_IO_URING
+    io_uring_params params{};
+    const int ring_fd = IoUringSetup(queue_size, &params);
+    if (ring_fd < 0) {
+        LOG_INFO(Common_Filesystem, "io_uring is not available: {}", std::strerror(errno));
+        return nullptr;
+    }
+    auto engine = std::make_unique<IoUringEngine>(ring_fd, params);
+    if (!engine->IsValid()) {
+        LOG_WARNING(Common_Filesystem, "Could not map the io_uring queues");
+        return nullptr;
+    }
+    return engine;
+#else
+    return nullptr;
+#endif
+}
+
+} // namespace Common
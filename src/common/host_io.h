@@ -0,0 +1,76 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <span>
+#include "common/common_types.h"
+
+namespace Common {
+
+/// Statistics of the host I/O engine since they were last taken
+struct HostIOStats {
+    u64 completed{};        ///< Number of completed operations
+    u64 total_latency_us{}; ///< Sum of the submission to completion latencies
+    u32 queue_depth{};      ///< Operations currently in flight
+    u32 max_queue_depth{};  ///< Highest number of operations in flight
+};
+
+/**
+ * Performs host I/O asynchronously, so that emulation does not wait on it. Reads of host files go
+ * through io_uring on Linux when the kernel supports it, everything else runs on a pool of I/O
+ * threads. Operations are tagged with an owner, so that all the operations of an owner can be
+ * cancelled at once.
+ */
+class HostIOEngine {
+public:
+    /// Called from an engine thread once an operation completed, with the number of bytes
+    /// transferred or a negative errno value.
+    using Completion = std::function<void(s64 result)>;
+
+    /// Work run on an I/O thread, returning a result like the one given to completions
+    using Task = std::function<s64()>;
+
+    struct ReadRequest {
+        int fd;
+        u64 offset;
+        std::span<u8> buffer;
+    };
+
+    virtual ~HostIOEngine();
+
+    /**
+     * Submits a batch of reads of contiguous ranges of a file. The completion is called once
+     * every read finished, with the total number of bytes read or the first error.
+     */
+    virtual void SubmitReads(u64 owner, std::span<const ReadRequest> reads, Completion done) = 0;
+
+    /// Runs a task on an I/O thread
+    virtual void SubmitTask(u64 owner, Task task, Completion done) = 0;
+
+    /**
+     * Cancels the operations of an owner, completing the ones that did not start with
+     * -ECANCELED, then waits until all of them completed.
+     */
+    virtual void Cancel(u64 owner) = 0;
+
+    virtual const char* GetName() const = 0;
+
+    /// Returns the engine shared by the emulator, created on first use
+    static HostIOEngine& Get();
+
+    /// Returns the statistics accumulated since the last call and resets them
+    static HostIOStats TakeStats();
+};
+
+/// Creates an engine running every operation on a pool of I/O threads
+std::unique_ptr<HostIOEngine> CreateThreadPoolIOEngine(std::size_t num_threads);
+
+/// Creates an engine reading files through io_uring, nullptr if the host does not support it
+std::unique_ptr<HostIOEngine> CreateIoUringEngine(u32 queue_size);
+
+} // namespace Common
@@ -0,0 +1,176 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "common/alignment.h"
+#include "common/error.h"
+#include "common/file_util.h"
+#include "common/logging/log.h"
+#include "common/mapped_file.h"
+
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace FileUtil {
+
+namespace {
+
+std::size_t GetPageSize() {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwAllocationGranularity;
+#else
+    return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+} // Anonymous namespace
+
+MappedFile::MappedFile(const IOFile& file) {
+    const int fd = file.GetFd();
+    const u64 file_size = file.GetSize();
+    if (fd == -1 || file_size == 0 || file.IsCompressed()) {
+        return;
+    }
+    if (file_size > std::numeric_limits<std::size_t>::max()) {
+        LOG_WARNING(Common_Filesystem, "File too big to be mapped");
+        return;
+    }
+
+#ifdef _WIN32
+    const HANDLE file_handle = reinterpret_cast<HANDLE>(_get_osfhandle(fd));
+    if (file_handle == INVALID_HANDLE_VALUE) {
+        return;
+    }
+    mapping_handle = CreateFileMappingW(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping_handle == nullptr) {
+        LOG_WARNING(Common_Filesystem, "CreateFileMapping failed: {}", GetLastError());
+        return;
+    }
+    data = static_cast<u8*>(MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0));
+    if (data == nullptr) {
+        LOG_WARNING(Common_Filesystem, "MapViewOfFile failed: {}", GetLastError());
+        CloseHandle(mapping_handle);
+        mapping_handle = nullptr;
+        return;
+    }
+#else
+    void* ptr = mmap(nullptr, static_cast<std::size_t>(file_size), PROT_READ, MAP_SHARED, fd, 0);
+    if (ptr == MAP_FAILED) {
+        LOG_WARNING(Common_Filesystem, "mmap failed: {}", Common::GetLastErrorMsg());
+        return;
+    }
+    data = static_cast<u8*>(ptr);
+#endif
+    size = static_cast<std::size_t>(file_size);
+}
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        Close();
+        data = std::exchange(other.data, nullptr);
+        size = std::exchange(other.size, 0);
+#ifdef _WIN32
+        mapping_handle = std::exchange(other.mapping_handle, nullptr);
+#endif
+    }
+    return *this;
+}
+
+void MappedFile::Close() {
+    if (data == nullptr) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(data);
+    CloseHandle(mapping_handle);
+    mapping_handle = nullptr;
+#else
+    munmap(data, size);
+#endif
+    data = nullptr;
+    size = 0;
+}
+
+std::span<const u8> MappedFile::GetSpan(std::size_t offset, std::size_t length) const {
+    if (offset >= size) {
+        return {};
+    }
+    return {data + offset, std::min(length, size - offset)};
+}
+
+void MappedFile::AdviseSequential(std::size_t offset, std::size_t length) const {
+#ifndef _WIN32
+    const auto span = GetSpan(offset, length);
+    if (span.empty()) {
+        return;
+    }
+    const std::size_t page_size = GetPageSize();
+    const std::size_t begin = Common::AlignDown(offset, page_size);
+    const std::size_t end = offset + span.size();
+    madvise(data + begin, end - begin, MADV_SEQUENTIAL);
+    madvise(data + begin, end - begin, MADV_WILLNEED);
+#endif
+}
+
+bool MappedFile::IsResident(std::size_t offset, std::size_t length) const {
+    const auto span = GetSpan(offset, length);
+    if (span.empty()) {
+        return true;
+    }
+#ifdef _WIN32
+    // The allocation granularity is larger than a page, the working set is queried per page.
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    const std::size_t page_size = info.dwPageSize;
+#else
+    const std::size_t page_size = GetPageSize();
+#endif
+    const std::size_t begin = Common::AlignDown(offset, page_size);
+    const std::size_t end = offset + span.size();
+    const std::size_t page_count = (end - begin + page_size - 1) / page_size;
+#ifdef _WIN32
+    // Pages of the view that are in the working set of the process can be read without I/O.
+    std::vector<PSAPI_WORKING_SET_EX_INFORMATION> pages(page_count);
+    for (std::size_t i = 0; i < page_count; i++) {
+        pages[i].VirtualAddress = data + begin + i * page_size;
+    }
+    if (!QueryWorkingSetEx(GetCurrentProcess(), pages.data(),
+                           static_cast<DWORD>(pages.size() * sizeof(pages[0])))) {
+        return false;
+    }
+    return std::all_of(pages.begin(), pages.end(),
+                       [](const auto& page) { return page.VirtualAttributes.Valid != 0; });
+#else
+#ifdef __APPLE__
+    std::vector<char> residency(page_count);
+#else
+    std::vector<unsigned char> residency(page_count);
+#endif
+    if (mincore(data + begin, end - begin, residency.data()) != 0) {
+        return false;
+    }
+    return std::all_of(residency.begin(), residency.end(), [](auto page) { return page & 1; });
+#endif
+}
+
+} // namespace FileUtil
@@ -0,0 +1,60 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include "common/common_types.h"
+
+namespace FileUtil {
+
+class IOFile;
+
+/**
+ * Read-only memory mapping of a whole file. Reads through the mapping are served straight
+ * from the host page cache, without the seek+read copies of IOFile.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    /// Maps the file opened by the given IOFile. The IOFile may be closed afterwards.
+    explicit MappedFile(const IOFile& file);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    [[nodiscard]] bool IsOpen() const {
+        return data != nullptr;
+    }
+
+    [[nodiscard]] std::size_t GetSize() const {
+        return size;
+    }
+
+    /// Returns the mapped bytes in [offset, offset + length), clamped to the end of the file.
+    [[nodiscard]] std::span<const u8> GetSpan(std::size_t offset, std::size_t length) const;
+
+    /// Hints the OS that the given range is going to be read sequentially soon.
+    void AdviseSequential(std::size_t offset, std::size_t length) const;
+
+    /// Whether the given range is known to be resident in memory, so reading it won't block
+    /// on disk I/O. Returns false if this can't be determined.
+    [[nodiscard]] bool IsResident(std::size_t offset, std::size_t length) const;
+
+    void Close();
+
+private:
+    u8* data = nullptr;
+    std::size_t size = 0;
+#ifdef _WIN32
+    void* mapping_handle = nullptr;
+#endif
+};
+
+} // namespace FileUtil
@@ -21,5 +21,23 @@ typedef void* HANDLE;
 #endif
 
 #include <microprofile.h>
+#include "common/tracing.h"
 
 #define MP_RGB(r, g, b) ((r) << 16 | (g) << 8 | (b) << 0)
+
+#if MICROPROFILE_ENABLED
+// Every microprofile scope is also recorded by Common::Tracing, under its group and name.
+#undef MICROPROFILE_DECLARE
+#undef MICROPROFILE_DEFINE
+#undef MICROPROFILE_SCOPE
+#define MICROPROFILE_DECLARE(var)                                                                  \
+    extern MicroProfileToken g_mp_##var;                                                           \
+    extern Common::Tracing::Label g_trace_##var
+#define MICROPROFILE_DEFINE(var, group, name, color)                                               \
+    MicroProfileToken g_mp_##var =                                                                 \
+        MicroProfileGetToken(group, name, color, MicroProfileTokenTypeCpu);                        \
+    Common::Tracing::Label g_trace_##var{group, name}
+#define MICROPROFILE_SCOPE(var)                                                                    \
+    MicroProfileScopeHandler MICROPROFILE_TOKEN_PASTE(foo, __LINE__)(g_mp_##var);                  \
+    Common::Tracing::Scope MICROPROFILE_TOKEN_PASTE(trace_scope, __LINE__)(g_trace_##var)
+#endif
@@ -0,0 +1,79 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+#include "common/assert.h"
+#include "common/perf_counters.h"
+
+namespace Common::PerfCounters {
+
+namespace {
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<detail::ThreadCounters*> threads;
+    /// Counts of the threads that exited
+    Values retired{};
+};
+
+Registry& GetRegistry() {
+    static Registry registry;
+    return registry;
+}
+
+constexpr std::array<const char*, NumCounters> Names{
+    "draw_calls",
+    "vertices_shaded",
+    "shader_compiles",
+    "texture_uploads",
+    "texture_upload_bytes",
+    "surface_cache_hits",
+    "surface_cache_misses",
+    "svc_calls",
+    "audio_underruns",
+    "fs_bytes_read",
+};
+
+} // Anonymous namespace
+
+namespace detail {
+
+ThreadCounters::ThreadCounters() {
+    auto& registry = GetRegistry();
+    std::scoped_lock lock{registry.mutex};
+    registry.threads.push_back(this);
+}
+
+ThreadCounters::~ThreadCounters() {
+    auto& registry = GetRegistry();
+    std::scoped_lock lock{registry.mutex};
+    for (std::size_t i = 0; i < NumCounters; i++) {
+        registry.retired[i] += values[i].load(std::memory_order_relaxed);
+    }
+    std::erase(registry.threads, this);
+}
+
+} // namespace detail
+
+const char* GetName(Counter counter) {
+    const auto index = static_cast<std::size_t>(counter);
+    ASSERT(index < NumCounters);
+    return Names[index];
+}
+
+Values GetTotals() {
+    auto& registry = GetRegistry();
+    std::scoped_lock lock{registry.mutex};
+    Values totals = registry.retired;
+    for (const auto* thread : registry.threads) {
+        for (std::size_t i = 0; i < NumCounters; i++) {
+            totals[i] += thread->values[i].load(std::memory_order_relaxed);
+        }
+    }
+    return totals;
+}
+
+} // namespace Common::PerfCounters
@@ -0,0 +1,63 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include "common/common_types.h"
+
+/**
+ * Counters of the work done by the emulator, incremented from hot paths. Each thread increments
+ * its own copy of the counters without atomic read-modify-writes, the copies are summed when the
+ * totals are read. Core::PerfStats turns the totals into per frame values.
+ */
+namespace Common::PerfCounters {
+
+enum class Counter : u32 {
+    DrawCalls,          ///< Draws submitted by the PICA
+    VerticesShaded,     ///< Vertices processed by the vertex shader
+    ShaderCompiles,     ///< Shaders compiled by the shader JIT
+    TextureUploads,     ///< Surfaces uploaded by the rasterizer cache
+    TextureUploadBytes, ///< Bytes uploaded by the rasterizer cache
+    SurfaceCacheHits,   ///< Surface lookups served by an existing surface
+    SurfaceCacheMisses, ///< Surface lookups that created a surface
+    SVCCalls,           ///< Supervisor calls handled by the kernel
+    AudioUnderruns,     ///< Times the audio sink ran out of samples
+    FSBytesRead,        ///< Bytes read from files by the FS service
+    Count,
+};
+
+constexpr std::size_t NumCounters = static_cast<std::size_t>(Counter::Count);
+
+using Values = std::array<u64, NumCounters>;
+
+/// Returns the name of a counter, in snake case
+const char* GetName(Counter counter);
+
+namespace detail {
+/// Counters of one thread, only written by that thread
+struct ThreadCounters {
+    ThreadCounters();
+    ~ThreadCounters();
+
+    std::array<std::atomic<u64>, NumCounters> values{};
+};
+
+inline ThreadCounters& GetThreadCounters() {
+    thread_local ThreadCounters counters;
+    return counters;
+}
+} // namespace detail
+
+/// Adds to a counter of the current thread.
+inline void Add(Counter counter, u64 value = 1) {
+    auto& slot = detail::GetThreadCounters().values[static_cast<std::size_t>(counter)];
+    slot.store(slot.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+/// Returns the sum of each counter over every thread since the start of the process.
+Values GetTotals();
+
+} // namespace Common::PerfCounters
@@ -431,6 +431,8 @@ struct Values {
     // Core
     Setting<bool> use_cpu_jit{true, "use_cpu_jit"};
     SwitchableSetting<s32, true> cpu_clock_percentage{100, 5, 400, "cpu_clock_percentage"};
+    Setting<u32> rewind_seconds{0, "rewind_seconds"};
+    Setting<u32> rewind_interval_frames{60, "rewind_interval_frames"};
     SwitchableSetting<bool> is_new_3ds{true, "is_new_3ds"};
     SwitchableSetting<bool> lle_applets{false, "lle_applets"};
 
@@ -476,6 +478,7 @@ struct Values {
     Setting<bool> use_shader_jit{true, "use_shader_jit"};
     SwitchableSetting<u32, true> resolution_factor{1, 0, 10, "resolution_factor"};
     SwitchableSetting<u16, true> frame_limit{100, 0, 1000, "frame_limit"};
+    Setting<u32> turbo_present_interval{10, "turbo_present_interval"};
     SwitchableSetting<TextureFilter> texture_filter{TextureFilter::None, "texture_filter"};
     SwitchableSetting<TextureSampling> texture_sampling{TextureSampling::GameControlled,
                                                         "texture_sampling"};
@@ -550,6 +553,8 @@ struct Values {
     std::string video_encoder;
     std::string video_encoder_options;
     u64 video_bitrate;
+    u32 video_queue_size = 8;
+    bool drop_video_frames = false;
 
     std::string audio_encoder;
     std::string audio_encoder_options;
@@ -87,8 +87,12 @@ public:
         }
     }
 
+    // Removes every element, resetting them so that the resources they hold are released.
     void clear() {
         m_list.clear();
+        for (auto& value : m_array) {
+            value = value_type{};
+        }
     }
 
 private:
@@ -7,6 +7,7 @@
 #include "common/error.h"
 #include "common/logging/log.h"
 #include "common/thread.h"
+#include "common/tracing.h"
 #ifdef __APPLE__
 #include <mach/mach.h>
 #elif defined(_WIN32)
@@ -84,6 +85,7 @@ void SetCurrentThreadPriority(ThreadPriority new_priority) {
 
 // Sets the debugger-visible name of the current thread.
 void SetCurrentThreadName(const char* name) {
+    Tracing::SetThreadName(name);
     SetThreadDescription(GetCurrentThread(), UTF8ToUTF16W(name).data());
 }
 
@@ -92,6 +94,7 @@ void SetCurrentThreadName(const char* name) {
 // MinGW with the POSIX threading model does not support pthread_setname_np
 #if !defined(_WIN32) || defined(_MSC_VER)
 void SetCurrentThreadName(const char* name) {
+    Tracing::SetThreadName(name);
 #ifdef __APPLE__
     pthread_setname_np(name);
 #elif defined(__Bitrig__) || defined(__DragonFly__) || defined(__FreeBSD__) || defined(__OpenBSD__)
@@ -113,8 +116,9 @@ void SetCurrentThreadName(const char* name) {
 #endif
 
 #if defined(_WIN32)
-void SetCurrentThreadName(const char*) {
-    // Do Nothing on MingW
+void SetCurrentThreadName(const char* name) {
+    // Only named in traces on MingW
+    Tracing::SetThreadName(name);
 }
 #endif
 
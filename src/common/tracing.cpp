@@ -0,0 +1,378 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <unordered_set>
+#include <fmt/format.h>
+#include "common/file_util.h"
+#include "common/logging/log.h"
+#include "common/string_util.h"
+#include "common/tracing.h"
+
+namespace Common::Tracing {
+
+namespace detail {
+std::atomic_bool enabled{false};
+}
+
+namespace {
+
+const auto start_time = std::chrono::steady_clock::now();
+
+/// Ring buffer of the events of one thread. Only the owning thread writes to it.
+struct ThreadBuffer {
+    struct Slot {
+        std::atomic<const char*> category{};
+        std::atomic<const char*> name{};
+        std::atomic<u64> begin_ns{};
+        std::atomic<u64> end_ns{};
+    };
+
+    explicit ThreadBuffer(u32 thread_id_, std::string thread_name_)
+        : thread_id{thread_id_}, thread_name{std::move(thread_name_)},
+          slots{std::make_unique<Slot[]>(EventsPerThread)} {}
+
+    const u32 thread_id;
+    std::string thread_name; ///< Guarded by the registry mutex
+    std::atomic<u64> head{}; ///< Number of events written
+    std::atomic<u64> tail{}; ///< Index of the first event not cleared
+    std::unique_ptr<Slot[]> slots;
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+};
+
+Registry& GetRegistry() {
+    static Registry registry;
+    return registry;
+}
+
+// The registry keeps the buffers of threads that exited, so that their events are exported.
+thread_local std::shared_ptr<ThreadBuffer> current_buffer;
+thread_local std::string current_thread_name;
+
+ThreadBuffer& GetThreadBuffer() {
+    if (!current_buffer) [[unlikely]] {
+        auto& registry = GetRegistry();
+        std::scoped_lock lock{registry.mutex};
+        current_buffer = std::make_shared<ThreadBuffer>(static_cast<u32>(registry.buffers.size()),
+                                                        current_thread_name);
+        registry.buffers.push_back(current_buffer);
+    }
+    return *current_buffer;
+}
+
+std::string EscapeJson(std::string_view str) {
+    std::string escaped;
+    escaped.reserve(str.size());
+    for (const char c : str) {
+        if (c == '"' || c == '\\') {
+            escaped.push_back('\\');
+            escaped.push_back(c);
+        } else if (static_cast<u8>(c) < 0x20) {
+            escaped += fmt::format("\\u{:04x}", static_cast<u8>(c));
+        } else {
+            escaped.push_back(c);
+        }
+    }
+    return escaped;
+}
+
+/// Minimal protobuf encoder for the few Perfetto messages written
+class ProtoWriter {
+public:
+    void Varint(u32 field, u64 value) {
+        Key(field, 0);
+        AppendVarint(value);
+    }
+
+    void Bytes(u32 field, std::string_view value) {
+        Key(field, 2);
+        AppendVarint(value.size());
+        data.append(value);
+    }
+
+    void Message(u32 field, const ProtoWriter& message) {
+        Bytes(field, message.data);
+    }
+
+    const std::string& Data() const {
+        return data;
+    }
+
+private:
+    void Key(u32 field, u32 wire_type) {
+        AppendVarint((field << 3) | wire_type);
+    }
+
+    void AppendVarint(u64 value) {
+        while (value >= 0x80) {
+            data.push_back(static_cast<char>(value | 0x80));
+            value >>= 7;
+        }
+        data.push_back(static_cast<char>(value));
+    }
+
+    std::string data;
+};
+
+// Field numbers from perfetto/protos/perfetto/trace/
+namespace Perfetto {
+constexpr u32 TracePacket = 1;              // Trace
+constexpr u32 Timestamp = 8;                // TracePacket
+constexpr u32 TrustedPacketSequenceId = 10; // TracePacket
+constexpr u32 TrackEvent = 11;              // TracePacket
+constexpr u32 TrackDescriptor = 60;         // TracePacket
+constexpr u32 TrackUuid = 1;                // TrackDescriptor
+constexpr u32 TrackProcess = 3;             // TrackDescriptor
+constexpr u32 TrackThread = 4;              // TrackDescriptor
+constexpr u32 ProcessPid = 1;               // ProcessDescriptor
+constexpr u32 ProcessName = 6;              // ProcessDescriptor
+constexpr u32 ThreadPid = 1;                // ThreadDescriptor
+constexpr u32 ThreadTid = 2;                // ThreadDescriptor
+constexpr u32 ThreadName = 5;               // ThreadDescriptor
+constexpr u32 EventCategories = 22;         // TrackEvent
+constexpr u32 EventName = 23;               // TrackEvent
+constexpr u32 EventType = 9;                // TrackEvent
+constexpr u32 EventTrackUuid = 11;          // TrackEvent
+constexpr u64 SliceBegin = 1;               // TrackEvent::Type
+constexpr u64 SliceEnd = 2;                 // TrackEvent::Type
+} // namespace Perfetto
+
+// Traces describe a single process
+constexpr u32 ProcessId = 1;
+constexpr u64 ProcessTrackUuid = 1;
+constexpr u32 SequenceId = 1;
+
+bool WriteFile(const std::string& path, std::string_view contents) {
+    FileUtil::IOFile file{path, "wb"};
+    if (!file.IsOpen() || file.WriteString(contents) != contents.size()) {
+        LOG_ERROR(Common, "Could not write trace to {}", path);
+        return false;
+    }
+    return true;
+}
+
+} // Anonymous namespace
+
+void SetEnabled(bool enabled) {
+    detail::enabled.store(enabled, std::memory_order_relaxed);
+}
+
+u64 Now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                                start_time)
+        .count();
+}
+
+void Record(const char* category, const char* name, u64 begin_ns, u64 end_ns) {
+    auto& buffer = GetThreadBuffer();
+    const u64 index = buffer.head.load(std::memory_order_relaxed);
+    auto& slot = buffer.slots[index % EventsPerThread];
+    // Pairs with the fence in CollectEvents: a reader that sees any of these stores also sees
+    // head reach index, and drops the slot as possibly overwritten.
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.category.store(category, std::memory_order_relaxed);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.begin_ns.store(begin_ns, std::memory_order_relaxed);
+    slot.end_ns.store(end_ns, std::memory_order_relaxed);
+    buffer.head.store(index + 1, std::memory_order_release);
+}
+
+const char* Intern(std::string_view name) {
+    static std::mutex mutex;
+    static std::unordered_set<std::string> names;
+    std::scoped_lock lock{mutex};
+    return names.emplace(name).first->c_str();
+}
+
+void SetThreadName(const char* name) {
+    current_thread_name = name;
+    if (current_buffer) {
+        std::scoped_lock lock{GetRegistry().mutex};
+        current_buffer->thread_name = name;
+    }
+}
+
+namespace {
+
+std::vector<ThreadEvents> ReadEvents(bool consume) {
+    auto& registry = GetRegistry();
+    std::scoped_lock lock{registry.mutex};
+
+    std::vector<ThreadEvents> threads;
+    threads.reserve(registry.buffers.size());
+    for (const auto& buffer : registry.buffers) {
+        const u64 head = buffer->head.load(std::memory_order_acquire);
+        const u64 first =
+            std::max(buffer->tail.load(std::memory_order_relaxed),
+                     head > EventsPerThread ? head - EventsPerThread : u64{0});
+
+        std::vector<Event> events;
+        events.reserve(head - first);
+        for (u64 index = first; index < head; index++) {
+            const auto& slot = buffer->slots[index % EventsPerThread];
+            events.push_back({slot.category.load(std::memory_order_relaxed),
+                              slot.name.load(std::memory_order_relaxed),
+                              slot.begin_ns.load(std::memory_order_relaxed),
+                              slot.end_ns.load(std::memory_order_relaxed)});
+        }
+
+        // The thread kept recording while the slots were copied, drop the ones it may have
+        // overwritten in the meantime.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const u64 new_head = buffer->head.load(std::memory_order_relaxed);
+        if (new_head >= EventsPerThread && new_head - EventsPerThread + 1 > first) {
+            const u64 overwritten = new_head - EventsPerThread + 1 - first;
+            events.erase(events.begin(),
+                         events.begin() + std::min<u64>(overwritten, events.size()));
+        }
+        if (consume) {
+            buffer->tail.store(head, std::memory_order_relaxed);
+        }
+
+        threads.push_back({buffer->thread_id, buffer->thread_name, std::move(events)});
+    }
+    return threads;
+}
+
+} // Anonymous namespace
+
+std::vector<ThreadEvents> CollectEvents() {
+    return ReadEvents(false);
+}
+
+std::vector<ThreadEvents> TakeEvents() {
+    return ReadEvents(true);
+}
+
+void Clear() {
+    auto& registry = GetRegistry();
+    std::scoped_lock lock{registry.mutex};
+    for (const auto& buffer : registry.buffers) {
+        buffer->tail.store(buffer->head.load(std::memory_order_acquire),
+                           std::memory_order_relaxed);
+    }
+}
+
+bool ExportChromeTrace(const std::string& path) {
+    std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    const auto append = [&](std::string_view event) {
+        if (!first) {
+            json += ",\n";
+        }
+        json += event;
+        first = false;
+    };
+
+    for (const auto& thread : CollectEvents()) {
+        const u32 tid = thread.thread_id + 1;
+        const std::string thread_name =
+            thread.thread_name.empty() ? fmt::format("Thread {}", thread.thread_id)
+                                       : EscapeJson(thread.thread_name);
+        append(fmt::format("{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":{},\"tid\":{},"
+                           "\"args\":{{\"name\":\"{}\"}}}}",
+                           ProcessId, tid, thread_name));
+        for (const auto& event : thread.events) {
+            append(fmt::format("{{\"name\":\"{}\",\"cat\":\"{}\",\"ph\":\"X\",\"ts\":{:.3f},"
+                               "\"dur\":{:.3f},\"pid\":{},\"tid\":{}}}",
+                               EscapeJson(event.name), EscapeJson(event.category),
+                               event.begin_ns / 1000.0, (event.end_ns - event.begin_ns) / 1000.0,
+                               ProcessId, tid));
+        }
+    }
+    json += "\n]}\n";
+    return WriteFile(path, json);
+}
+
+bool ExportPerfettoTrace(const std::string& path) {
+    ProtoWriter trace;
+    const auto append_packet = [&trace](u32 field, const ProtoWriter& message,
+                                        std::optional<u64> timestamp = std::nullopt) {
+        ProtoWriter packet;
+        if (timestamp) {
+            packet.Varint(Perfetto::Timestamp, *timestamp);
+        }
+        packet.Varint(Perfetto::TrustedPacketSequenceId, SequenceId);
+        packet.Message(field, message);
+        trace.Message(Perfetto::TracePacket, packet);
+    };
+
+    {
+        ProtoWriter process;
+        process.Varint(Perfetto::ProcessPid, ProcessId);
+        process.Bytes(Perfetto::ProcessName, "citra");
+        ProtoWriter track;
+        track.Varint(Perfetto::TrackUuid, ProcessTrackUuid);
+        track.Message(Perfetto::TrackProcess, process);
+        append_packet(Perfetto::TrackDescriptor, track);
+    }
+
+    for (auto& thread : CollectEvents()) {
+        const u64 track_uuid = ProcessTrackUuid + 1 + thread.thread_id;
+        {
+            ProtoWriter thread_descriptor;
+            thread_descriptor.Varint(Perfetto::ThreadPid, ProcessId);
+            thread_descriptor.Varint(Perfetto::ThreadTid, thread.thread_id + 1);
+            if (!thread.thread_name.empty()) {
+                thread_descriptor.Bytes(Perfetto::ThreadName, thread.thread_name);
+            }
+            ProtoWriter track;
+            track.Varint(Perfetto::TrackUuid, track_uuid);
+            track.Message(Perfetto::TrackThread, thread_descriptor);
+            append_packet(Perfetto::TrackDescriptor, track);
+        }
+
+        // Perfetto slices are begin/end pairs, so replay the scopes in order while keeping track
+        // of the ones still open. Scopes are recorded when left, enclosing ones come last.
+        auto& events = thread.events;
+        std::stable_sort(events.begin(), events.end(), [](const Event& a, const Event& b) {
+            return a.begin_ns < b.begin_ns || (a.begin_ns == b.begin_ns && a.end_ns > b.end_ns);
+        });
+        const auto append_slice = [&](const Event* event, u64 timestamp) {
+            ProtoWriter track_event;
+            track_event.Varint(Perfetto::EventTrackUuid, track_uuid);
+            if (event) {
+                track_event.Varint(Perfetto::EventType, Perfetto::SliceBegin);
+                track_event.Bytes(Perfetto::EventCategories, event->category);
+                track_event.Bytes(Perfetto::EventName, event->name);
+            } else {
+                track_event.Varint(Perfetto::EventType, Perfetto::SliceEnd);
+            }
+            append_packet(Perfetto::TrackEvent, track_event, timestamp);
+        };
+        std::vector<u64> open_scopes;
+        for (const auto& event : events) {
+            while (!open_scopes.empty() && open_scopes.back() <= event.begin_ns) {
+                append_slice(nullptr, open_scopes.back());
+                open_scopes.pop_back();
+            }
+            append_slice(&event, event.begin_ns);
+            open_scopes.push_back(event.end_ns);
+        }
+        while (!open_scopes.empty()) {
+            append_slice(nullptr, open_scopes.back());
+            open_scopes.pop_back();
+        }
+    }
+
+    return WriteFile(path, trace.Data());
+}
+
+bool Export(const std::string& path) {
+    if (Common::EndsWith(Common::ToLower(path), ".json")) {
+        return ExportChromeTrace(path);
+    }
+    return ExportPerfettoTrace(path);
+}
+
+} // namespace Common::Tracing
@@ -0,0 +1,121 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "common/common_types.h"
+
+/**
+ * Low overhead tracing of the time spent in scopes, meant to find the cause of frame time spikes
+ * without an attached profiler. Each thread records the scopes it leaves into its own ring buffer
+ * without taking any lock, so only the most recent events of each thread are kept. The events are
+ * exported as a Chrome trace (JSON) or a Perfetto trace (protobuf), which both open in
+ * ui.perfetto.dev.
+ *
+ * Every MICROPROFILE_SCOPE is traced as well, under its microprofile group and name.
+ */
+namespace Common::Tracing {
+
+/// Number of events kept per thread
+constexpr std::size_t EventsPerThread = 1 << 16;
+
+/// A scope left by a thread, the strings have static storage duration
+struct Event {
+    const char* category;
+    const char* name;
+    u64 begin_ns; ///< Time the scope was entered, relative to the start of the process
+    u64 end_ns;   ///< Time the scope was left, relative to the start of the process
+};
+
+/// The events recorded by a thread, from the oldest to the newest
+struct ThreadEvents {
+    u32 thread_id; ///< Identifier of the thread, in order of their first event
+    std::string thread_name;
+    std::vector<Event> events;
+};
+
+/// Category and name of a traced scope, both must have static storage duration.
+struct Label {
+    const char* category;
+    const char* name;
+};
+
+namespace detail {
+extern std::atomic_bool enabled;
+}
+
+/// Returns whether scopes are being recorded
+inline bool IsEnabled() {
+    return detail::enabled.load(std::memory_order_relaxed);
+}
+
+/// Starts or stops recording scopes. Events recorded before stopping are kept.
+void SetEnabled(bool enabled);
+
+/// Returns the current time used by events, in nanoseconds since the start of the process.
+u64 Now();
+
+/// Records a scope left by the current thread.
+void Record(const char* category, const char* name, u64 begin_ns, u64 end_ns);
+
+/// Returns a copy of a name built at runtime that lives until the end of the process.
+const char* Intern(std::string_view name);
+
+/// Names the current thread in exported traces. Called by Common::SetCurrentThreadName.
+void SetThreadName(const char* name);
+
+/// Returns the events recorded by every thread that recorded one.
+std::vector<ThreadEvents> CollectEvents();
+
+/// Returns the events recorded since the last call, and drops them from later collections.
+std::vector<ThreadEvents> TakeEvents();
+
+/// Drops the events recorded so far.
+void Clear();
+
+/// Writes the recorded events as a Chrome trace JSON file. Returns false on failure.
+bool ExportChromeTrace(const std::string& path);
+
+/// Writes the recorded events as a Perfetto protobuf trace. Returns false on failure.
+bool ExportPerfettoTrace(const std::string& path);
+
+/**
+ * Writes the recorded events in the format chosen by the extension of the path: a Chrome trace for
+ * ".json", a Perfetto trace otherwise (".perfetto-trace", ".pftrace"). Returns false on failure.
+ */
+bool Export(const std::string& path);
+
+/// Records the time between its construction and destruction, if tracing is enabled.
+class Scope {
+public:
+    Scope(const char* category_, const char* name_) {
+        if (IsEnabled()) [[unlikely]] {
+            category = category_;
+            name = name_;
+            begin_ns = Now();
+        }
+    }
+
+    explicit Scope(const Label& label) : Scope(label.category, label.name) {}
+
+    ~Scope() {
+        if (name) [[unlikely]] {
+            Record(category, name, begin_ns, Now());
+        }
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+private:
+    const char* category{};
+    const char* name{};
+    u64 begin_ns{};
+};
+
+} // namespace Common::Tracing
@@ -0,0 +1,79 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include "common/thread_worker.h"
+#include "common/worker_pool.h"
+
+namespace Common {
+
+namespace {
+
+ThreadWorker& GetPool() {
+    static ThreadWorker pool(std::max<std::size_t>(std::thread::hardware_concurrency(), 2) - 1,
+                             "Worker");
+    return pool;
+}
+
+} // Anonymous namespace
+
+struct TaskGroup::State {
+    std::mutex mutex;
+    std::condition_variable done_cv;
+    std::deque<std::function<void()>> tasks;
+    /// Tasks queued and not finished yet, including the ones being run
+    std::size_t pending = 0;
+
+    /// Runs the oldest task that was not picked up yet, returns false if there is none.
+    bool RunOne() {
+        std::function<void()> task;
+        {
+            std::scoped_lock lock{mutex};
+            if (tasks.empty()) {
+                return false;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+        std::scoped_lock lock{mutex};
+        if (--pending == 0) {
+            done_cv.notify_all();
+        }
+        return true;
+    }
+};
+
+TaskGroup::TaskGroup() : state(std::make_shared<State>()) {}
+
+TaskGroup::~TaskGroup() {
+    Wait();
+}
+
+void TaskGroup::Run(std::function<void()> task) {
+    {
+        std::scoped_lock lock{state->mutex};
+        state->tasks.push_back(std::move(task));
+        ++state->pending;
+    }
+    // The pool entry may run after the caller took the task over, hence the shared state.
+    GetPool().QueueWork([state = state] { state->RunOne(); });
+}
+
+void TaskGroup::Wait() {
+    while (state->RunOne()) {
+    }
+    std::unique_lock lock{state->mutex};
+    state->done_cv.wait(lock, [this] { return state->pending == 0; });
+}
+
+std::size_t TaskGroup::NumWorkers() {
+    return GetPool().NumWorkers();
+}
+
+} // namespace Common
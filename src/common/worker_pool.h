@@ -0,0 +1,56 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace Common {
+
+/**
+ * A set of tasks run on the worker pool shared by the whole emulator, which can be waited on
+ * independently of the tasks of other groups.
+ *
+ * Waiting runs the tasks of the group that no worker picked up yet on the calling thread, so
+ * groups can be used from within the tasks of another group without starving the pool.
+ */
+class TaskGroup {
+public:
+    TaskGroup();
+    /// Waits for the remaining tasks.
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    /// Queues a task. It may only reference data that outlives the next call to Wait.
+    void Run(std::function<void()> task);
+
+    /// Waits until every task queued so far is done.
+    void Wait();
+
+    /// Returns the number of threads of the shared pool.
+    static std::size_t NumWorkers();
+
+private:
+    struct State;
+    std::shared_ptr<State> state;
+};
+
+/// Runs func(i) for every i in [0, count) on the shared pool and the calling thread.
+template <typename Func>
+void ParallelFor(std::size_t count, Func&& func) {
+    TaskGroup group;
+    for (std::size_t i = 1; i < count; i++) {
+        group.Run([&func, i] { func(i); });
+    }
+    if (count != 0) {
+        func(0);
+    }
+    group.Wait();
+}
+
+} // namespace Common
@@ -70,4 +70,20 @@ std::vector<u8> DecompressDataZSTD(std::span<const u8> compressed) {
     return decompressed;
 }
 
+bool DecompressDataZSTD(std::span<const u8> compressed, std::span<u8> destination) {
+    const std::size_t result_size = ZSTD_decompress(destination.data(), destination.size(),
+                                                    compressed.data(), compressed.size());
+    if (ZSTD_isError(result_size)) {
+        LOG_ERROR(Common, "Error decompressing ZSTD data: {} ({})", ZSTD_getErrorName(result_size),
+                  result_size);
+        return false;
+    }
+    if (result_size != destination.size()) {
+        LOG_ERROR(Common, "ZSTD decompression expected {} bytes, got {}", destination.size(),
+                  result_size);
+        return false;
+    }
+    return true;
+}
+
 } // namespace Common::Compression
@@ -40,4 +40,15 @@ namespace Common::Compression {
  */
 [[nodiscard]] std::vector<u8> DecompressDataZSTD(std::span<const u8> compressed);
 
+/**
+ * Decompresses a source memory region with Zstandard into a destination of the exact uncompressed
+ * size.
+ *
+ * @param compressed the compressed source memory region.
+ * @param destination the memory region receiving the uncompressed data.
+ *
+ * @return whether the data decompressed to exactly the size of the destination.
+ */
+[[nodiscard]] bool DecompressDataZSTD(std::span<const u8> compressed, std::span<u8> destination);
+
 } // namespace Common::Compression
@@ -44,6 +44,8 @@
 #include "core/hw/aes/key.h"
 #include "core/loader/loader.h"
 #include "core/movie.h"
+#include "core/rewind_buffer.h"
+#include "core/savestate.h"
 #ifdef ENABLE_SCRIPTING
 #include "core/rpc/server.h"
 #endif
@@ -135,7 +137,7 @@ System::ResultStatus System::RunLoop(bool tight_loop) {
         LOG_INFO(Core, "Begin save to slot {}", slot);
         try {
             System::SaveState(slot);
-            LOG_INFO(Core, "Save completed");
+            LOG_INFO(Core, "Save queued");
         } catch (const std::exception& e) {
             LOG_ERROR(Core, "Error saving: {}", e.what());
             status_details = e.what();
@@ -144,10 +146,68 @@ System::ResultStatus System::RunLoop(bool tight_loop) {
         frame_limiter.WaitOnce();
         return ResultStatus::Success;
     }
+    case Signal::Rewind: {
+        const u32 frames = param;
+        LOG_INFO(Core, "Begin rewind of {} frames", frames);
+        try {
+            if (!rewind_buffer) {
+                throw std::runtime_error("Rewinding is disabled");
+            }
+            rewind_buffer->Rewind(frames * VideoCore::FRAME_TICKS);
+            LOG_INFO(Core, "Rewind completed");
+        } catch (const std::exception& e) {
+            LOG_ERROR(Core, "Error rewinding: {}", e.what());
+            status_details = e.what();
+            return ResultStatus::ErrorSavestate;
+        }
+        frame_limiter.WaitOnce();
+        return ResultStatus::Success;
+    }
+    case Signal::SeekMovie: {
+        const u32 frame = param;
+        LOG_INFO(Core, "Begin seek to movie frame {}", frame);
+        try {
+            const auto path = movie.GetKeyframeState(frame);
+            if (path.empty()) {
+                throw std::runtime_error("No movie keyframe before this frame");
+            }
+            System::LoadState(path);
+            LOG_INFO(Core, "Seek completed");
+        } catch (const std::exception& e) {
+            LOG_ERROR(Core, "Error seeking: {}", e.what());
+            status_details = e.what();
+            return ResultStatus::ErrorSavestate;
+        }
+        frame_limiter.WaitOnce();
+        return ResultStatus::Success;
+    }
     default:
         break;
     }
 
+    // States are written in the background, their errors show up here
+    if (savestate_writer) {
+        if (const auto error = savestate_writer->TakeError()) {
+            status_details = *error;
+            return ResultStatus::ErrorSavestate;
+        }
+    }
+
+    try {
+        movie.UpdateKeyframes();
+    } catch (const std::exception& e) {
+        LOG_ERROR(Core, "Error saving movie keyframe: {}", e.what());
+    }
+
+    if (rewind_buffer) {
+        try {
+            rewind_buffer->Update();
+        } catch (const std::exception& e) {
+            LOG_ERROR(Core, "Error taking rewind snapshot, rewinding disabled: {}", e.what());
+            rewind_buffer.reset();
+        }
+    }
+
     // All cores should have executed the same amount of ticks. If this is not the case an event was
     // scheduled with a cycles_into_future smaller then the current downcount.
     // So we have to get those cores to the same global time first
@@ -580,11 +640,19 @@ void System::Shutdown(bool is_deserializing) {
     // Shutdown emulation session
     is_powered_on = false;
 
+    // Savestates being written must not outlive the session they belong to
+    if (savestate_writer) {
+        savestate_writer->Wait();
+    }
+
     gpu.reset();
     if (!is_deserializing) {
         GDBStub::Shutdown();
         perf_stats.reset();
         app_loader.reset();
+        if (rewind_buffer) {
+            rewind_buffer->Clear();
+        }
     }
     custom_tex_manager.reset();
     telemetry_session.reset();
@@ -617,6 +685,21 @@ void System::Shutdown(bool is_deserializing) {
     LOG_DEBUG(Core, "Shutdown OK");
 }
 
+void System::SetRewindBuffer(u32 seconds, u32 interval_frames) {
+    if (seconds == 0) {
+        rewind_buffer.reset();
+        return;
+    }
+    const u64 interval_ticks = std::max(interval_frames, 1U) * VideoCore::FRAME_TICKS;
+    const u64 capacity = seconds * BASE_CLOCK_RATE_ARM11 / interval_ticks;
+    // Settings are applied again on every change, which must not drop the snapshots
+    if (rewind_buffer && rewind_buffer->GetCapacity() == std::max<u64>(capacity, 1) &&
+        rewind_buffer->GetIntervalTicks() == interval_ticks) {
+        return;
+    }
+    rewind_buffer = std::make_unique<RewindBuffer>(*this, capacity, interval_ticks);
+}
+
 void System::Reset() {
     // This is NOT a proper reset, but a temporary workaround by shutting down the system and
     // reloading.
@@ -646,6 +729,8 @@ void System::Reset() {
 void System::ApplySettings() {
     GDBStub::SetServerPort(Settings::values.gdbstub_port.GetValue());
     GDBStub::ToggleServer(Settings::values.use_gdbstub.GetValue());
+    SetRewindBuffer(Settings::values.rewind_seconds.GetValue(),
+                    Settings::values.rewind_interval_frames.GetValue());
 
     if (gpu) {
 #ifndef ANDROID
@@ -74,6 +74,8 @@ namespace Core {
 class ARM_Interface;
 class TelemetrySession;
 class ExclusiveMonitor;
+class RewindBuffer;
+class SaveStateWriter;
 class Timing;
 
 class System {
@@ -131,7 +133,7 @@ public:
     /// Shutdown and then load again
     void Reset();
 
-    enum class Signal : u32 { None, Shutdown, Reset, Save, Load };
+    enum class Signal : u32 { None, Shutdown, Reset, Save, Load, Rewind, SeekMovie };
 
     bool SendSignal(Signal signal, u32 param = 0);
 
@@ -288,6 +290,20 @@ public:
         return video_dumper;
     }
 
+    /**
+     * Keeps snapshots of the last emulated seconds in memory, which Signal::Rewind goes back to
+     * with the number of frames to rewind as parameter. ApplySettings calls it with the
+     * rewind_seconds and rewind_interval_frames settings.
+     * @param seconds Emulated seconds covered by the snapshots, 0 to disable rewinding
+     * @param interval_frames Frames between two snapshots
+     */
+    void SetRewindBuffer(u32 seconds, u32 interval_frames);
+
+    /// Returns the rewind buffer, nullptr if rewinding is disabled
+    [[nodiscard]] RewindBuffer* GetRewindBuffer() const {
+        return rewind_buffer.get();
+    }
+
     std::unique_ptr<PerfStats> perf_stats;
     FrameLimiter frame_limiter;
 
@@ -341,8 +357,14 @@ public:
 
     void SaveState(u32 slot) const;
 
+    /// Saves a savestate of the running title to a file, which may not be in a savestate slot.
+    void SaveState(const std::string& path) const;
+
     void LoadState(u32 slot);
 
+    /// Loads a savestate file of the running title, which may not be in a savestate slot.
+    void LoadState(const std::string& path);
+
     /// Self delete ncch
     bool SetSelfDelete(const std::string& file) {
         if (m_filepath == file) {
@@ -412,6 +434,12 @@ private:
     /// Image interface
     std::shared_ptr<Frontend::ImageInterface> registered_image_interface;
 
+    /// Writes savestates in the background, created on the first save
+    mutable std::unique_ptr<SaveStateWriter> savestate_writer;
+
+    /// Snapshots to rewind to, null if rewinding is disabled
+    std::unique_ptr<RewindBuffer> rewind_buffer;
+
 #ifdef ENABLE_SCRIPTING
     /// RPC Server for scripting support
     std::unique_ptr<RPC::Server> rpc_server;
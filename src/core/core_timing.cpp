@@ -8,6 +8,7 @@
 #include "common/assert.h"
 #include "common/logging/log.h"
 #include "common/settings.h"
+#include "common/tracing.h"
 #include "core/core_timing.h"
 
 namespace Core {
@@ -55,6 +56,7 @@ TimingEventType* Timing::RegisterEvent(const std::string& name, TimedCallback ca
     auto info = event_types.emplace(name, TimingEventType{});
     TimingEventType* event_type = &info.first->second;
     event_type->name = &info.first->first;
+    event_type->trace_name = Common::Tracing::Intern(name);
     if (callback != nullptr) {
         event_type->callback = callback;
     }
@@ -224,6 +226,7 @@ void Timing::Timer::Advance() {
         std::pop_heap(event_queue.begin(), event_queue.end(), std::greater<>());
         event_queue.pop_back();
         if (evt.type->callback != nullptr) {
+            Common::Tracing::Scope trace_scope{"CoreTiming", evt.type->trace_name};
             evt.type->callback(evt.user_data, static_cast<int>(executed_ticks - evt.time));
         } else {
             LOG_ERROR(Core, "Event '{}' has no callback", *evt.type->name);
@@ -137,6 +137,7 @@ using TimedCallback = std::function<void(std::uintptr_t user_data, int cycles_la
 struct TimingEventType {
     TimedCallback callback;
     const std::string* name;
+    const char* trace_name; ///< Name of the event in Common::Tracing scopes
 };
 
 class Timing {
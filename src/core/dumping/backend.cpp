@@ -8,10 +8,19 @@
 namespace VideoDumper {
 
 VideoFrame::VideoFrame(std::size_t width_, std::size_t height_, u8* data_)
-    : width(width_), height(height_), stride(static_cast<u32>(width * 4)),
-      data(data_, data_ + width * height * 4) {}
+    : width(width_), height(height_), stride(static_cast<u32>(width * 4)) {
+    if (data_) {
+        data.assign(data_, data_ + width * height * 4);
+    } else {
+        data.resize(width * height * 4);
+    }
+}
 
 Backend::~Backend() = default;
+
+VideoFrame Backend::AcquireVideoFrame(std::size_t width, std::size_t height) {
+    return VideoFrame(width, height);
+}
 NullBackend::~NullBackend() = default;
 
 } // namespace VideoDumper
\ No newline at end of file
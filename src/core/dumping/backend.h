@@ -20,8 +20,11 @@ public:
     std::size_t width;
     std::size_t height;
     u32 stride;
+    /// Position of the frame in the dump. Frames dropped by the backend leave gaps.
+    u64 index{};
     std::vector<u8> data;
 
+    /// Creates a frame holding a copy of data, or an uninitialized frame if data is null
     VideoFrame(std::size_t width_ = 0, std::size_t height_ = 0, u8* data_ = nullptr);
 };
 
@@ -30,6 +33,8 @@ public:
     virtual ~Backend();
     virtual bool StartDumping(const std::string& path, const Layout::FramebufferLayout& layout) = 0;
     virtual void AddVideoFrame(VideoFrame frame) = 0;
+    /// Returns a frame to fill and pass to AddVideoFrame, whose storage may be reused
+    virtual VideoFrame AcquireVideoFrame(std::size_t width, std::size_t height);
     virtual void AddAudioFrame(AudioCore::StereoFrame16 frame) = 0;
     virtual void AddAudioSample(const std::array<s16, 2>& sample) = 0;
     virtual void StopDumping() = 0;
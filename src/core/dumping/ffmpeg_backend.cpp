@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <span>
+#include <thread>
 #include <unordered_map>
 #include "common/assert.h"
 #include "common/file_util.h"
@@ -39,6 +40,26 @@ AVDictionary* ToAVDictionary(const std::string& serialized) {
     return result;
 }
 
+std::vector<u8> VideoFramePool::Acquire(std::size_t size) {
+    std::vector<u8> buffer;
+    {
+        std::scoped_lock lock{mutex};
+        if (!buffers.empty()) {
+            buffer = std::move(buffers.back());
+            buffers.pop_back();
+        }
+    }
+    buffer.resize(size);
+    return buffer;
+}
+
+void VideoFramePool::Release(std::vector<u8> buffer) {
+    std::scoped_lock lock{mutex};
+    if (buffers.size() < MaxBuffers) {
+        buffers.push_back(std::move(buffer));
+    }
+}
+
 FFmpegStream::~FFmpegStream() {
     Free();
 }
@@ -149,7 +170,6 @@ bool FFmpegVideoStream::Init(FFmpegMuxer& muxer, const Layout::FramebufferLayout
     }
 
     layout = layout_;
-    frame_count = 0;
 
     // Initialize video codec
     const AVCodec* codec =
@@ -169,6 +189,8 @@ bool FFmpegVideoStream::Init(FFmpegMuxer& muxer, const Layout::FramebufferLayout
     codec_context->time_base.num = 1;
     codec_context->time_base.den = 60;
     codec_context->gop_size = 12;
+    // Let the encoder pick its thread count, the encoder options may still override it
+    codec_context->thread_count = 0;
 
     // Get pixel format for codec
     auto options = ToAVDictionary(Settings::values.video_encoder_options);
@@ -242,22 +264,47 @@ void FFmpegVideoStream::Free() {
     sink_context = nullptr;
 }
 
-void FFmpegVideoStream::ProcessFrame(VideoFrame& frame) {
+void FFmpegVideoStream::ProcessFrame(VideoFrame frame) {
     if (frame.width != layout.width || frame.height != layout.height) {
         LOG_ERROR(Render, "Frame dropped: resolution does not match");
+        frame_pool.Release(std::move(frame.data));
         return;
     }
+
+    // Hand the frame storage over to the filter graph, which releases it to the pool once the
+    // frame is converted. Unlike a frame without buffer, this does not copy the pixels.
+    struct PooledBuffer {
+        VideoFramePool& pool;
+        std::vector<u8> data;
+    };
+    auto* pooled = new PooledBuffer{frame_pool, std::move(frame.data)};
+    AVBufferRef* buffer = FFmpeg::av_buffer_create(
+        pooled->data.data(), pooled->data.size(),
+        [](void* opaque, u8*) {
+            auto* owner = static_cast<PooledBuffer*>(opaque);
+            owner->pool.Release(std::move(owner->data));
+            delete owner;
+        },
+        pooled, AV_BUFFER_FLAG_READONLY);
+    if (!buffer) {
+        LOG_ERROR(Render, "Video frame dropped: Could not create frame buffer");
+        delete pooled;
+        return;
+    }
+
     // Prepare frame
-    current_frame->data[0] = frame.data.data();
+    current_frame->buf[0] = buffer;
+    current_frame->data[0] = pooled->data.data();
     current_frame->linesize[0] = frame.stride;
     current_frame->format = pixel_format;
     current_frame->width = layout.width;
     current_frame->height = layout.height;
-    current_frame->pts = frame_count++;
+    current_frame->pts = static_cast<s64>(frame.index);
 
-    // Filter the frame
+    // Filter the frame. The graph takes the reference to the buffer.
     if (FFmpeg::av_buffersrc_add_frame(source_context, current_frame.get()) < 0) {
         LOG_ERROR(Render, "Video frame dropped: Could not add frame to filter graph");
+        FFmpeg::av_frame_unref(current_frame.get());
         return;
     }
     while (true) {
@@ -372,6 +419,12 @@ bool FFmpegVideoStream::InitHWContext(const AVCodec* codec) {
 
 bool FFmpegVideoStream::InitFilters() {
     filter_graph.reset(FFmpeg::avfilter_graph_alloc());
+    // Convert the frames to the encoder pixel format in parallel slices, on top of the SIMD
+    // conversion done by swscale
+    filter_graph->nb_threads = static_cast<int>(std::thread::hardware_concurrency());
+#if LIBAVFILTER_VERSION_MAJOR >= 8
+    filter_graph->scale_sws_opts = FFmpeg::av_strdup("threads=0");
+#endif
 
     const AVFilter* source = FFmpeg::avfilter_get_by_name("buffer");
     const AVFilter* sink = FFmpeg::avfilter_get_by_name("buffersink");
@@ -709,8 +762,8 @@ void FFmpegMuxer::Free() {
     format_context.reset();
 }
 
-void FFmpegMuxer::ProcessVideoFrame(VideoFrame& frame) {
-    video_stream.ProcessFrame(frame);
+void FFmpegMuxer::ProcessVideoFrame(VideoFrame frame) {
+    video_stream.ProcessFrame(std::move(frame));
 }
 
 void FFmpegMuxer::ProcessAudioFrame(const VariableAudioFrame& channel0,
@@ -718,6 +771,10 @@ void FFmpegMuxer::ProcessAudioFrame(const VariableAudioFrame& channel0,
     audio_stream.ProcessFrame(channel0, channel1);
 }
 
+VideoFramePool& FFmpegMuxer::GetVideoFramePool() {
+    return video_stream.GetFramePool();
+}
+
 void FFmpegMuxer::FlushVideo() {
     video_stream.Flush();
 }
@@ -757,21 +814,29 @@ bool FFmpegBackend::StartDumping(const std::string& path, const Layout::Framebuf
     if (video_processing_thread.joinable()) {
         video_processing_thread.join();
     }
+    {
+        std::scoped_lock lock{video_queue_mutex};
+        video_queue.clear();
+        next_video_frame_index = 0;
+        dropped_video_frames = 0;
+    }
     video_processing_thread = std::thread([&] {
-        event1.Set();
         while (true) {
-            event2.Wait();
-            current_buffer = (current_buffer + 1) % 2;
-            next_buffer = (current_buffer + 1) % 2;
-            event1.Set();
-            // Process this frame
-            auto& frame = video_frame_buffers[current_buffer];
+            VideoFrame frame;
+            {
+                std::unique_lock lock{video_queue_mutex};
+                video_queue_cv.wait(lock, [this] { return !video_queue.empty(); });
+                frame = std::move(video_queue.front());
+                video_queue.pop_front();
+            }
+            video_queue_cv.notify_all();
+
             if (frame.width == 0 && frame.height == 0) {
                 // An empty frame marks the end of frame data
                 ffmpeg.FlushVideo();
                 break;
             }
-            ffmpeg.ProcessVideoFrame(frame);
+            ffmpeg.ProcessVideoFrame(std::move(frame));
         }
         // Finish audio execution first if not done yet
         if (audio_processing_thread.joinable())
@@ -803,9 +868,35 @@ bool FFmpegBackend::StartDumping(const std::string& path, const Layout::Framebuf
 }
 
 void FFmpegBackend::AddVideoFrame(VideoFrame frame) {
-    event1.Wait();
-    video_frame_buffers[next_buffer] = std::move(frame);
-    event2.Set();
+    const bool is_end = frame.width == 0 && frame.height == 0;
+    std::unique_lock lock{video_queue_mutex};
+    if (!is_end) {
+        frame.index = next_video_frame_index++;
+        if (video_queue.size() >= Settings::values.video_queue_size) {
+            if (Settings::values.drop_video_frames) {
+                // The encoder duplicates the previous frame to fill the gap
+                dropped_video_frames++;
+                lock.unlock();
+                ffmpeg.GetVideoFramePool().Release(std::move(frame.data));
+                return;
+            }
+            video_queue_cv.wait(lock, [this] {
+                return video_queue.size() < Settings::values.video_queue_size;
+            });
+        }
+    }
+    video_queue.push_back(std::move(frame));
+    lock.unlock();
+    video_queue_cv.notify_all();
+}
+
+VideoFrame FFmpegBackend::AcquireVideoFrame(std::size_t width, std::size_t height) {
+    VideoFrame frame;
+    frame.width = width;
+    frame.height = height;
+    frame.stride = static_cast<u32>(width * 4);
+    frame.data = ffmpeg.GetVideoFramePool().Acquire(width * height * 4);
+    return frame;
 }
 
 void FFmpegBackend::AddAudioFrame(AudioCore::StereoFrame16 frame) {
@@ -851,6 +942,13 @@ Layout::FramebufferLayout FFmpegBackend::GetLayout() const {
 
 void FFmpegBackend::EndDumping() {
     LOG_INFO(Render, "Ending frame dumping");
+    {
+        std::scoped_lock lock{video_queue_mutex};
+        if (dropped_video_frames != 0) {
+            LOG_WARNING(Render, "Dropped {} of {} video frames as the encoder fell behind",
+                        dropped_video_frames, next_video_frame_index);
+        }
+    }
 
     ffmpeg.WriteTrailer();
     ffmpeg.Free();
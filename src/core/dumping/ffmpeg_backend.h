@@ -6,6 +6,7 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <limits>
 #include <memory>
 #include <mutex>
@@ -28,6 +29,26 @@ using VariableAudioFrame = std::vector<s16>;
 
 class FFmpegMuxer;
 
+/**
+ * Storage of video frames that finished encoding, reused by the next frames instead of allocating
+ * a new buffer for each of them.
+ */
+class VideoFramePool {
+public:
+    /// Returns a buffer of the given size, reusing a released one if possible.
+    std::vector<u8> Acquire(std::size_t size);
+
+    /// Gives back a buffer that is no longer used.
+    void Release(std::vector<u8> buffer);
+
+private:
+    /// Most buffers kept, enough for the frames in flight between the renderer and the encoder
+    static constexpr std::size_t MaxBuffers = 16;
+
+    std::mutex mutex;
+    std::vector<std::vector<u8>> buffers;
+};
+
 /**
  * Wrapper around FFmpeg AVCodecContext + AVStream.
  * Rescales/Resamples, encodes and writes a frame.
@@ -78,13 +99,19 @@ public:
 
     bool Init(FFmpegMuxer& muxer, const Layout::FramebufferLayout& layout);
     void Free();
-    void ProcessFrame(VideoFrame& frame);
+    void ProcessFrame(VideoFrame frame);
+
+    VideoFramePool& GetFramePool() {
+        return frame_pool;
+    }
 
 private:
     bool InitHWContext(const AVCodec* codec);
     bool InitFilters();
 
-    u64 frame_count{};
+    /// Frames are passed to the filter graph without copying, their storage returns to this pool
+    /// once the graph is done with them.
+    VideoFramePool frame_pool;
 
     std::unique_ptr<AVFrame, AVFrameDeleter> current_frame{};
     std::unique_ptr<AVFrame, AVFrameDeleter> filtered_frame{};
@@ -157,8 +184,9 @@ public:
 
     bool Init(const std::string& path, const Layout::FramebufferLayout& layout);
     void Free();
-    void ProcessVideoFrame(VideoFrame& frame);
+    void ProcessVideoFrame(VideoFrame frame);
     void ProcessAudioFrame(const VariableAudioFrame& channel0, const VariableAudioFrame& channel1);
+    VideoFramePool& GetVideoFramePool();
     void FlushVideo();
     void FlushAudio();
     void WriteTrailer();
@@ -181,7 +209,8 @@ private:
 
 /**
  * FFmpeg video dumping backend.
- * This class implements a double buffer.
+ * Video frames wait in a bounded queue for the encoding thread. When the queue is full, frames are
+ * either dropped or the caller waits, depending on Settings::values.drop_video_frames.
  */
 class FFmpegBackend : public Backend {
 public:
@@ -189,6 +218,7 @@ public:
     ~FFmpegBackend() override;
     bool StartDumping(const std::string& path, const Layout::FramebufferLayout& layout) override;
     void AddVideoFrame(VideoFrame frame) override;
+    VideoFrame AcquireVideoFrame(std::size_t width, std::size_t height) override;
     void AddAudioFrame(AudioCore::StereoFrame16 frame) override;
     void AddAudioSample(const std::array<s16, 2>& sample) override;
     void StopDumping() override;
@@ -204,9 +234,11 @@ private:
     FFmpegMuxer ffmpeg{};
 
     Layout::FramebufferLayout video_layout;
-    std::array<VideoFrame, 2> video_frame_buffers;
-    u32 current_buffer = 0, next_buffer = 1;
-    Common::Event event1, event2;
+    std::mutex video_queue_mutex;
+    std::condition_variable video_queue_cv;
+    std::deque<VideoFrame> video_queue;
+    u64 next_video_frame_index{}; ///< Guarded by video_queue_mutex
+    u64 dropped_video_frames{};   ///< Guarded by video_queue_mutex
     std::thread video_processing_thread;
 
     std::array<Common::SPSCQueue<VariableAudioFrame>, 2> audio_frame_queues;
@@ -5,6 +5,7 @@
 #include <cryptopp/sha.h>
 #include "common/alignment.h"
 #include "common/file_util.h"
+#include "common/mapped_file.h"
 #include "common/logging/log.h"
 #include "core/file_sys/cia_container.h"
 #include "core/file_sys/file_backend.h"
@@ -64,6 +65,12 @@ Loader::ResultStatus CIAContainer::Load(const std::string& filepath) {
     if (!file.IsOpen())
         return Loader::ResultStatus::Error;
 
+    // Parse the headers in place when the file can be mapped
+    const FileUtil::MappedFile mapping(file);
+    if (mapping.IsOpen()) {
+        return Load(mapping.GetSpan(0, mapping.GetSize()));
+    }
+
     // Load CIA Header
     std::vector<u8> header_data(sizeof(Header));
     if (file.ReadBytes(header_data.data(), sizeof(Header)) != sizeof(Header))
@@ -153,11 +160,11 @@ Loader::ResultStatus CIAContainer::LoadTitleMetadata(std::span<const u8> tmd_dat
 }
 
 Loader::ResultStatus CIAContainer::LoadMetadata(std::span<const u8> meta_data, std::size_t offset) {
-    if (meta_data.size() - offset < sizeof(Metadata)) {
+    if (meta_data.size() < offset + sizeof(Metadata)) {
         return Loader::ResultStatus::Error;
     }
 
-    std::memcpy(&cia_metadata, meta_data.data(), sizeof(Metadata));
+    std::memcpy(&cia_metadata, meta_data.data() + offset, sizeof(Metadata));
 
     return Loader::ResultStatus::Success;
 }
@@ -4,10 +4,13 @@
 
 #include <algorithm>
 #include <memory>
+#include <unordered_map>
+#include <utility>
 #include "common/archives.h"
 #include "common/common_types.h"
 #include "common/file_util.h"
 #include "common/logging/log.h"
+#include "common/thread_worker.h"
 #include "core/file_sys/disk_archive.h"
 #include "core/file_sys/errors.h"
 
@@ -16,11 +19,47 @@ SERIALIZE_EXPORT_IMPL(FileSys::DiskDirectory)
 
 namespace FileSys {
 
+namespace {
+// A single writer keeps the host writes in the order the guest issued them.
+Common::ThreadWorker& GetWriter() {
+    static Common::ThreadWorker writer(1, "DiskFileWriter");
+    return writer;
+}
+} // Anonymous namespace
+
+DiskFile::DiskFile(FileUtil::IOFile&& file_, const Mode& mode_,
+                   std::unique_ptr<DelayGenerator> delay_generator_)
+    : file(new FileUtil::IOFile(std::move(file_))),
+      host_state(GetHostFileState(file->GetPath())) {
+    delay_generator = std::move(delay_generator_);
+    mode.hex = mode_.hex;
+}
+
+DiskFile::~DiskFile() {
+    WaitForWrites();
+}
+
+std::shared_ptr<DiskFile::HostFileState> DiskFile::GetHostFileState(const std::string& path) {
+    static std::mutex states_mutex;
+    static std::unordered_map<std::string, std::weak_ptr<HostFileState>> states;
+
+    std::scoped_lock lock{states_mutex};
+    std::erase_if(states, [](const auto& entry) { return entry.second.expired(); });
+    auto& weak_state = states[path];
+    auto state = weak_state.lock();
+    if (!state) {
+        state = std::make_shared<HostFileState>();
+        weak_state = state;
+    }
+    return state;
+}
+
 ResultVal<std::size_t> DiskFile::Read(const u64 offset, const std::size_t length,
                                       u8* buffer) const {
     if (!mode.read_flag)
         return ResultInvalidOpenFlags;
 
+    WaitForWrites();
     file->Seek(offset, SEEK_SET);
     return file->ReadBytes(buffer, length);
 }
@@ -30,27 +69,142 @@ ResultVal<std::size_t> DiskFile::Write(const u64 offset, const std::size_t lengt
     if (!mode.write_flag)
         return ResultInvalidOpenFlags;
 
-    file->Seek(offset, SEEK_SET);
-    std::size_t written = file->WriteBytes(buffer, length);
-    if (flush)
-        file->Flush();
-    return written;
+    if (length == 0)
+        return std::size_t{0};
+
+    // The writer flushes the file every time it empties the queue. Durability is guaranteed when
+    // the file is closed or the archive committed, or right away when the flush flag is set.
+    bool start_writer = false;
+    {
+        std::unique_lock lock{host_state->mutex};
+        host_state->cv.wait(lock, [this] { return pending_bytes < MaxPendingBytes; });
+
+        // An earlier write failed after it was acknowledged, report it on the next one
+        if (write_result.IsError()) {
+            return std::exchange(write_result, ResultSuccess);
+        }
+
+        // The writer removes a write from the queue before writing it, so the last one can grow.
+        if (!pending_writes.empty() &&
+            pending_writes.back().offset + pending_writes.back().data.size() == offset &&
+            pending_writes.back().data.size() + length <= MaxCoalescedWrite) {
+            auto& data = pending_writes.back().data;
+            data.insert(data.end(), buffer, buffer + length);
+        } else {
+            pending_writes.push_back({offset, std::vector<u8>(buffer, buffer + length)});
+        }
+        pending_bytes += length;
+        start_writer = !std::exchange(writer_active, true);
+        if (start_writer) {
+            host_state->active_writers++;
+        }
+    }
+
+    if (start_writer) {
+        GetWriter().QueueWork([this] { WritePending(); });
+    }
+    if (flush) {
+        const Result result = TakeWriteResult();
+        if (result.IsError()) {
+            return result;
+        }
+    }
+    return length;
+}
+
+void DiskFile::WritePending() {
+    std::unique_lock lock{host_state->mutex};
+    while (true) {
+        if (pending_writes.empty()) {
+            lock.unlock();
+            const bool flushed = file->Flush();
+            lock.lock();
+            if (!flushed && write_result.IsSuccess()) {
+                LOG_ERROR(Service_FS, "Could not flush file");
+                write_result = ResultInsufficientSpace;
+            }
+            if (pending_writes.empty()) {
+                break;
+            }
+            continue;
+        }
+
+        PendingWrite write = std::move(pending_writes.front());
+        pending_writes.pop_front();
+        lock.unlock();
+
+        file->Seek(write.offset, SEEK_SET);
+        const bool written =
+            file->WriteBytes(write.data.data(), write.data.size()) == write.data.size();
+        if (!written) {
+            LOG_ERROR(Service_FS, "Could not write {} bytes at offset {:#x}", write.data.size(),
+                      write.offset);
+            file->Clear();
+        }
+
+        lock.lock();
+        // Running out of space is the most likely reason for a host write to fail
+        if (!written && write_result.IsSuccess()) {
+            write_result = ResultInsufficientSpace;
+        }
+        pending_bytes -= write.data.size();
+        host_state->cv.notify_all();
+    }
+    writer_active = false;
+    host_state->active_writers--;
+    host_state->cv.notify_all();
+}
+
+void DiskFile::WaitForWrites() const {
+    std::unique_lock lock{host_state->mutex};
+    host_state->cv.wait(lock, [this] { return host_state->active_writers == 0; });
+}
+
+Result DiskFile::TakeWriteResult() {
+    std::unique_lock lock{host_state->mutex};
+    host_state->cv.wait(lock, [this] { return !writer_active; });
+    return std::exchange(write_result, ResultSuccess);
+}
+
+void DiskFile::WaitForAllWrites() {
+    GetWriter().WaitForRequests();
 }
 
 u64 DiskFile::GetSize() const {
+    WaitForWrites();
     return file->GetSize();
 }
 
 bool DiskFile::SetSize(const u64 size) const {
+    WaitForWrites();
     file->Resize(size);
     file->Flush();
     return true;
 }
 
 bool DiskFile::Close() const {
+    WaitForWrites();
     return file->Close();
 }
 
+void DiskFile::Flush() const {
+    WaitForWrites();
+    file->Flush();
+}
+
+std::optional<HostFileRange> DiskFile::GetHostRange(u64 offset, std::size_t length) const {
+    if (!mode.read_flag || file->IsCompressed())
+        return std::nullopt;
+
+    // The writer flushes the file once done, so the host file is up to date after this
+    WaitForWrites();
+    // Reads past the end of the file are short, only the bytes that exist are read
+    const u64 size = file->GetSize();
+    const std::size_t available =
+        offset < size ? static_cast<std::size_t>(std::min<u64>(length, size - offset)) : 0;
+    return HostFileRange{file->GetFd(), offset, available};
+}
+
 DiskDirectory::DiskDirectory(const std::string& path) {
     directory.size = FileUtil::ScanDirectoryTree(path, directory);
     directory.isDirectory = true;
@@ -4,8 +4,11 @@
 
 #pragma once
 
+#include <condition_variable>
 #include <cstddef>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <boost/serialization/base_object.hpp>
@@ -20,14 +23,16 @@
 
 namespace FileSys {
 
+/**
+ * A file on the host file system. Writes are coalesced in memory and written back by a worker
+ * thread, every other operation first waiting for the queued writes to the same host file to
+ * complete, including the ones queued through other DiskFiles opened on it.
+ */
 class DiskFile : public FileBackend {
 public:
     DiskFile(FileUtil::IOFile&& file_, const Mode& mode_,
-             std::unique_ptr<DelayGenerator> delay_generator_)
-        : file(new FileUtil::IOFile(std::move(file_))) {
-        delay_generator = std::move(delay_generator_);
-        mode.hex = mode_.hex;
-    }
+             std::unique_ptr<DelayGenerator> delay_generator_);
+    ~DiskFile() override;
 
     ResultVal<std::size_t> Read(u64 offset, std::size_t length, u8* buffer) const override;
     ResultVal<std::size_t> Write(u64 offset, std::size_t length, bool flush,
@@ -35,23 +40,61 @@ public:
     u64 GetSize() const override;
     bool SetSize(u64 size) const override;
     bool Close() const override;
+    void Flush() const override;
+    Result TakeWriteResult() override;
+    std::optional<HostFileRange> GetHostRange(u64 offset, std::size_t length) const override;
 
-    void Flush() const override {
-        file->Flush();
-    }
+    /// Blocks until the writes queued by all files have reached the host file system
+    static void WaitForAllWrites();
 
 protected:
+    /// Blocks until the writes queued for the host file have reached the host file system
+    void WaitForWrites() const;
+
     Mode mode;
     std::unique_ptr<FileUtil::IOFile> file;
 
 private:
     DiskFile() = default;
 
+    /// Writes back the queued writes, run on the writer thread
+    void WritePending();
+
+    struct PendingWrite {
+        u64 offset;
+        std::vector<u8> data;
+    };
+
+    /// Write back state shared by every DiskFile opened on the same host file
+    struct HostFileState {
+        std::mutex mutex; ///< Guards this and the write back members of the DiskFiles
+        std::condition_variable cv;
+        std::size_t active_writers{}; ///< DiskFiles whose write back is queued or running
+    };
+
+    /// Returns the state of the host file at the path, created if no DiskFile has it open
+    static std::shared_ptr<HostFileState> GetHostFileState(const std::string& path);
+
+    static constexpr std::size_t MaxCoalescedWrite = 1024 * 1024;
+    static constexpr std::size_t MaxPendingBytes = 8 * 1024 * 1024;
+
+    std::shared_ptr<HostFileState> host_state;
+    std::deque<PendingWrite> pending_writes;
+    std::size_t pending_bytes{};
+    bool writer_active{}; // A write back is queued or running
+    Result write_result = ResultSuccess; ///< First failure of the write back, not yet reported
+
     template <class Archive>
     void serialize(Archive& ar, const unsigned int) {
+        if (Archive::is_saving::value) {
+            WaitForWrites();
+        }
         ar& boost::serialization::base_object<FileBackend>(*this);
         ar& mode.hex;
         ar& file;
+        if (Archive::is_loading::value) {
+            host_state = GetHostFileState(file->GetPath());
+        }
     }
     friend class boost::serialization::access;
 };
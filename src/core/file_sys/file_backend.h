@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <memory>
+#include <optional>
 #include <boost/serialization/unique_ptr.hpp>
 #include "common/common_types.h"
 #include "core/hle/result.h"
@@ -14,6 +15,13 @@
 
 namespace FileSys {
 
+/// A range of a host file holding file data as is
+struct HostFileRange {
+    int fd;
+    u64 offset;
+    std::size_t length;
+};
+
 class FileBackend : NonCopyable {
 public:
     FileBackend() {}
@@ -86,6 +94,15 @@ public:
      */
     virtual void Flush() const = 0;
 
+    /**
+     * Waits for the writes already acknowledged by Write and returns the error of the first one
+     * that failed since the last call, if any. Only backends writing in the background can fail
+     * after Write returned.
+     */
+    virtual Result TakeWriteResult() {
+        return ResultSuccess;
+    }
+
     /**
      * Whether the backend supports cached reads.
      */
@@ -100,6 +117,14 @@ public:
         return false;
     }
 
+    /**
+     * Gets the host file range holding the data at offset, when it can be read directly from the
+     * host file system instead of through Read. The range stops at the end of the file.
+     */
+    virtual std::optional<HostFileRange> GetHostRange(u64 offset, std::size_t length) const {
+        return std::nullopt;
+    }
+
 protected:
     std::unique_ptr<DelayGenerator> delay_generator;
 
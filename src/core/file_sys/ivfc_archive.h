@@ -139,6 +139,10 @@ public:
         return romfs_file->CacheReady(file_offset, length);
     }
 
+    std::optional<HostFileRange> GetHostRange(u64 offset, std::size_t length) const override {
+        return romfs_file->GetHostRange(offset, length);
+    }
+
 private:
     std::shared_ptr<RomFSReader> romfs_file;
 
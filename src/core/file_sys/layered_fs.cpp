@@ -68,24 +68,60 @@ void LayeredFS::Load() {
 
     ASSERT_MSG(header.header_length == sizeof(header), "Header size is incorrect");
 
+    // Read the metadata tables at once rather than entry by entry
+    const std::size_t metadata_end = std::max<std::size_t>(
+        header.directory_metadata_table.offset + header.directory_metadata_table.length,
+        header.file_metadata_table.offset + header.file_metadata_table.length);
+    original_metadata.resize(std::min(metadata_end, romfs->GetSize()));
+    romfs->ReadFile(0, original_metadata.size(), original_metadata.data());
+
     // TODO: is root always the first directory in table?
     root.parent = &root;
     LoadDirectory(root, 0);
 
+    original_metadata.clear();
+    original_metadata.shrink_to_fit();
+
     if (load_relocations) {
         LoadRelocations();
         LoadExtRelocations();
     }
 
+    {
+        std::scoped_lock lock{replace_file_mutex};
+        replace_files.clear();
+    }
+
+    // Without any relocation the original RomFS is already what we would build
+    passthrough = !relocated;
+    if (passthrough) {
+        return;
+    }
+
     RebuildMetadata();
 }
 
 LayeredFS::~LayeredFS() = default;
 
+bool LayeredFS::ReadMetadata(std::size_t offset, std::size_t size, void* dest) const {
+    if (size == 0) {
+        return true;
+    }
+    if (offset > original_metadata.size() || size > original_metadata.size() - offset) {
+        std::memset(dest, 0, size);
+        return false;
+    }
+    std::memcpy(dest, original_metadata.data() + offset, size);
+    return true;
+}
+
 u32 LayeredFS::LoadDirectory(Directory& current, u32 offset) {
     DirectoryMetadata metadata;
-    romfs->ReadFile(header.directory_metadata_table.offset + offset, sizeof(metadata),
-                    reinterpret_cast<u8*>(&metadata));
+    if (!ReadMetadata(header.directory_metadata_table.offset + offset, sizeof(metadata),
+                      &metadata)) {
+        LOG_ERROR(Service_FS, "LayeredFS directory metadata at {:#x} is out of bounds", offset);
+        return 0xFFFFFFFF;
+    }
 
     current.name = ReadName(header.directory_metadata_table.offset + offset + sizeof(metadata),
                             metadata.name_length);
@@ -111,8 +147,10 @@ u32 LayeredFS::LoadDirectory(Directory& current, u32 offset) {
 
 u32 LayeredFS::LoadFile(Directory& parent, u32 offset) {
     FileMetadata metadata;
-    romfs->ReadFile(header.file_metadata_table.offset + offset, sizeof(metadata),
-                    reinterpret_cast<u8*>(&metadata));
+    if (!ReadMetadata(header.file_metadata_table.offset + offset, sizeof(metadata), &metadata)) {
+        LOG_ERROR(Service_FS, "LayeredFS file metadata at {:#x} is out of bounds", offset);
+        return 0xFFFFFFFF;
+    }
 
     auto file = std::make_unique<File>();
     file->name = ReadName(header.file_metadata_table.offset + offset + sizeof(metadata),
@@ -130,7 +168,7 @@ u32 LayeredFS::LoadFile(Directory& parent, u32 offset) {
 
 std::string LayeredFS::ReadName(u32 offset, u32 name_length) {
     std::vector<u16_le> buffer(name_length / sizeof(u16_le));
-    romfs->ReadFile(offset, name_length, reinterpret_cast<u8*>(buffer.data()));
+    ReadMetadata(offset, buffer.size() * sizeof(u16_le), buffer.data());
 
     std::u16string name(buffer.size(), 0);
     std::transform(buffer.begin(), buffer.end(), name.begin(), [](u16_le character) {
@@ -159,6 +197,7 @@ void LayeredFS::LoadRelocations() {
                     child_dir->parent = parent;
                     directory_path_map.emplace(path, child_dir.get());
                     parent->directories.emplace_back(std::move(child_dir));
+                    relocated = true;
                     LOG_INFO(Service_FS, "LayeredFS created directory {}", path);
                 }
                 return FileUtil::ForeachDirectoryEntry(nullptr, directory + virtual_name + DIR_SEP,
@@ -180,6 +219,7 @@ void LayeredFS::LoadRelocations() {
             file->relocation.type = 1;
             file->relocation.replace_file_path = directory + virtual_name;
             file->relocation.size = FileUtil::GetSize(directory + virtual_name);
+            relocated = true;
             LOG_INFO(Service_FS, "LayeredFS replacement file in use for {}", path);
             return true;
         };
@@ -214,6 +254,7 @@ void LayeredFS::LoadExtRelocations() {
                 file.relocation.type = 3;
                 file.relocation.size = 0;
                 file_path_map.erase(file_path);
+                relocated = true;
                 LOG_INFO(Service_FS, "LayeredFS removed file {}", file_path);
             } else {
                 LOG_WARNING(Service_FS, "LayeredFS file for stub {} not found", path);
@@ -260,6 +301,7 @@ void LayeredFS::LoadExtRelocations() {
                 file.relocation.type = 2;
                 file.relocation.size = buffer.size();
                 file.relocation.patched_file = std::move(buffer);
+                relocated = true;
             } else {
                 LOG_ERROR(Service_FS, "LayeredFS failed to patch file {}", file_path);
             }
@@ -294,10 +336,26 @@ void LayeredFS::PrepareBuild(Directory& current) {
         PrepareBuildFile(*child);
     }
 
+    // Link siblings now that their offsets are known, removed files being skipped
+    u32 next_offset = 0xFFFFFFFF;
+    for (auto it = current.files.rbegin(); it != current.files.rend(); ++it) {
+        if ((*it)->relocation.type == 3) {
+            continue;
+        }
+        file_next_sibling_map.emplace(it->get(), next_offset);
+        next_offset = file_metadata_offset_map.at(it->get());
+    }
+
     for (const auto& child : current.directories) {
         PrepareBuildDirectory(*child);
     }
 
+    next_offset = 0xFFFFFFFF;
+    for (auto it = current.directories.rbegin(); it != current.directories.rend(); ++it) {
+        directory_next_sibling_map.emplace(it->get(), next_offset);
+        next_offset = directory_metadata_offset_map.at(it->get());
+    }
+
     for (const auto& child : current.directories) {
         PrepareBuild(*child);
     }
@@ -335,15 +393,7 @@ void LayeredFS::BuildDirectories() {
         metadata.parent_directory_offset = directory_metadata_offset_map.at(directory->parent);
 
         if (directory->parent != directory) {
-            bool flag = false;
-            for (const auto& sibling : directory->parent->directories) {
-                if (flag) {
-                    metadata.next_sibling_offset = directory_metadata_offset_map.at(sibling.get());
-                    break;
-                } else if (sibling.get() == directory) {
-                    flag = true;
-                }
-            }
+            metadata.next_sibling_offset = directory_next_sibling_map.at(directory);
         }
 
         if (!directory->directories.empty()) {
@@ -385,24 +435,13 @@ void LayeredFS::BuildFiles() {
 
         metadata.parent_directory_offset = directory_metadata_offset_map.at(file->parent);
 
-        bool flag = false;
-        for (const auto& sibling : file->parent->files) {
-            if (sibling->relocation.type == 3) { // removed file
-                continue;
-            }
-            if (flag) {
-                metadata.next_sibling_offset = file_metadata_offset_map.at(sibling.get());
-                break;
-            } else if (sibling.get() == file) {
-                flag = true;
-            }
-        }
+        metadata.next_sibling_offset = file_next_sibling_map.at(file);
 
         metadata.file_data_offset = current_data_offset;
         metadata.file_data_length = file->relocation.size;
         current_data_offset += Common::AlignUp(metadata.file_data_length, 16);
         if (metadata.file_data_length != 0) {
-            data_offset_map.emplace(metadata.file_data_offset, file);
+            data_extents.push_back({metadata.file_data_offset, current_data_offset, file});
         }
 
         const auto bucket =
@@ -484,10 +523,47 @@ void LayeredFS::RebuildMetadata() {
 }
 
 std::size_t LayeredFS::GetSize() const {
+    if (passthrough) {
+        return romfs->GetSize();
+    }
     return metadata.size() + current_data_offset;
 }
 
+std::size_t LayeredFS::ReadReplacement(const File& file, std::size_t offset, std::size_t length,
+                                       u8* buffer) {
+    // The lock only covers the cache, files are opened and read without it. Shared ownership keeps
+    // a file open for the readers still using it after it was evicted.
+    std::shared_ptr<FileUtil::IOFile> replace_file;
+    {
+        std::scoped_lock lock{replace_file_mutex};
+        if (replace_files.contains(&file)) {
+            replace_file = replace_files.request(&file).second;
+        }
+    }
+    if (!replace_file) {
+        replace_file =
+            std::make_shared<FileUtil::IOFile>(file.relocation.replace_file_path, "rb");
+        if (!replace_file->IsOpen()) {
+            LOG_ERROR(Service_FS, "Could not open replacement file for {}", file.path);
+            return 0;
+        }
+        std::scoped_lock lock{replace_file_mutex};
+        auto [cached, cached_file] = replace_files.request(&file);
+        if (cached) {
+            // Another reader opened it meanwhile
+            replace_file = cached_file;
+        } else {
+            cached_file = replace_file;
+        }
+    }
+    return replace_file->ReadAtBytes(buffer, length, offset);
+}
+
 std::size_t LayeredFS::ReadFile(std::size_t offset, std::size_t length, u8* buffer) {
+    if (passthrough) {
+        return romfs->ReadFile(offset, length, buffer);
+    }
+
     ASSERT_MSG(offset + length <= GetSize(), "Out of bound");
 
     std::size_t read_size = 0;
@@ -501,35 +577,34 @@ std::size_t LayeredFS::ReadFile(std::size_t offset, std::size_t length, u8* buff
         offset -= metadata.size();
     }
 
+    if (read_size == length) {
+        return read_size;
+    }
+
     // Read files
-    auto current = (--data_offset_map.upper_bound(offset));
+    auto current = std::upper_bound(
+        data_extents.begin(), data_extents.end(), offset,
+        [](std::size_t value, const DataExtent& extent) { return value < extent.offset; });
+    ASSERT_MSG(current != data_extents.begin(), "No file data at offset {:#x}", offset);
+    --current;
     while (read_size < length) {
-        const auto relative_offset = offset - current->first;
+        const auto relative_offset = offset - current->offset;
+        auto& relocation = current->file->relocation;
         std::size_t to_read{};
-        if (current->second->relocation.size > relative_offset) {
-            to_read = std::min<std::size_t>(current->second->relocation.size - relative_offset,
-                                            length - read_size);
+        if (relocation.size > relative_offset) {
+            to_read = std::min<std::size_t>(relocation.size - relative_offset, length - read_size);
         }
         const auto alignment =
-            std::min<std::size_t>(Common::AlignUp(current->second->relocation.size, 16) -
-                                      relative_offset,
+            std::min<std::size_t>(current->end - current->offset - relative_offset,
                                   length - read_size) -
             to_read;
 
         // Read the file in different ways depending on relocation type
-        auto& relocation = current->second->relocation;
         if (relocation.type == 0) { // none
             romfs->ReadFile(relocation.original_offset + relative_offset, to_read,
                             buffer + read_size);
         } else if (relocation.type == 1) { // replace
-            FileUtil::IOFile replace_file(relocation.replace_file_path, "rb");
-            if (replace_file) {
-                replace_file.Seek(relative_offset, SEEK_SET);
-                replace_file.ReadBytes(buffer + read_size, to_read);
-            } else {
-                LOG_ERROR(Service_FS, "Could not open replacement file for {}",
-                          current->second->path);
-            }
+            ReadReplacement(*current->file, relative_offset, to_read, buffer + read_size);
         } else if (relocation.type == 2) { // patch
             std::memcpy(buffer + read_size, relocation.patched_file.data() + relative_offset,
                         to_read);
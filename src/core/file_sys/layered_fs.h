@@ -4,8 +4,8 @@
 
 #pragma once
 
-#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -14,6 +14,8 @@
 #include <boost/serialization/shared_ptr.hpp>
 #include <boost/serialization/string.hpp>
 #include "common/common_types.h"
+#include "common/file_util.h"
+#include "common/static_lru_cache.h"
 #include "common/swap.h"
 #include "core/file_sys/romfs_reader.h"
 
@@ -41,6 +43,10 @@ static_assert(sizeof(RomFSHeader) == 0x28, "Size of RomFSHeader is not correct")
  * patch_ext_path: Path for RomFS extensions. Files present in this path:
  *  - When with an extension of ".stub", remove the corresponding file in the RomFS.
  *  - When with an extension of ".ips" or ".bps", patch the file in the RomFS.
+ *
+ * Only the metadata is rebuilt when loading. File data is mapped through a sorted extent index
+ * and replacement files are opened on first read. When no file is relocated, reads are passed
+ * through to the underlying RomFS unchanged.
  */
 class LayeredFS : public RomFSReader {
 public:
@@ -54,11 +60,19 @@ public:
     bool DumpRomFS(const std::string& target_path);
 
     bool AllowsCachedReads() const override {
-        return false;
+        return passthrough && romfs->AllowsCachedReads();
     }
 
     bool CacheReady(std::size_t file_offset, std::size_t length) override {
-        return false;
+        return passthrough && romfs->CacheReady(file_offset, length);
+    }
+
+    std::optional<HostFileRange> GetHostRange(std::size_t offset,
+                                              std::size_t length) const override {
+        if (!passthrough) {
+            return std::nullopt;
+        }
+        return romfs->GetHostRange(offset, length);
     }
 
 private:
@@ -71,6 +85,10 @@ private:
         Directory* parent;
     };
 
+    // Copies from the original metadata, zero-filling anything out of its bounds.
+    // Returns whether the range was in bounds.
+    bool ReadMetadata(std::size_t offset, std::size_t size, void* dest) const;
+
     std::string ReadName(u32 offset, u32 name_length);
 
     // Loads the current directory, then its children.
@@ -106,6 +124,10 @@ private:
 
     void RebuildMetadata();
 
+    // Reads from a replacement file, keeping it open for the next reads
+    std::size_t ReadReplacement(const File& file, std::size_t offset, std::size_t length,
+                                u8* buffer);
+
     void Load();
 
     std::shared_ptr<RomFSReader> romfs;
@@ -117,8 +139,23 @@ private:
     Directory root;
     std::unordered_map<std::string, File*> file_path_map;
     std::unordered_map<std::string, Directory*> directory_path_map;
-    std::map<u64, File*> data_offset_map; // assigned data offset -> file
-    std::vector<u8> metadata;             // Includes header, hash table and metadata
+    std::vector<u8> original_metadata; // Original metadata tables, only kept while loading
+    std::vector<u8> metadata;          // Includes header, hash table and metadata
+    bool relocated{}; // Whether any file or directory was created, replaced, patched or removed
+    bool passthrough{}; // Reads go straight to the original RomFS
+
+    struct DataExtent {
+        u64 offset; // assigned data offset
+        u64 end;    // end of the data, including alignment
+        File* file;
+    };
+    std::vector<DataExtent> data_extents; // sorted by offset
+
+    // Replacement files are opened on first read, a limited number of them being kept open.
+    static constexpr std::size_t replace_file_cache_size = 16;
+    std::mutex replace_file_mutex; // Guards the cache only, reads are done without it
+    Common::StaticLRUCache<const File*, std::shared_ptr<FileUtil::IOFile>, replace_file_cache_size>
+        replace_files;
 
     // Used for rebuilding header
     std::vector<u32_le> directory_hash_table;
@@ -126,11 +163,13 @@ private:
 
     std::unordered_map<Directory*, u32>
         directory_metadata_offset_map;        // directory -> metadata offset
+    std::unordered_map<Directory*, u32> directory_next_sibling_map; // directory -> next sibling
     std::vector<Directory*> directory_list;   // sequence of directories to be written to metadata
     u64 current_directory_offset{};           // current directory metadata offset
     std::vector<u8> directory_metadata_table; // rebuilt directory metadata table
 
     std::unordered_map<File*, u32> file_metadata_offset_map; // file -> metadata offset
+    std::unordered_map<File*, u32> file_next_sibling_map;    // file -> next sibling offset
     std::vector<File*> file_list;        // sequence of files to be written to metadata
     u64 current_file_offset{};           // current file metadata offset
     std::vector<u8> file_metadata_table; // rebuilt file metadata table
@@ -0,0 +1,106 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstring>
+
+#include "core/file_sys/lzss.h"
+
+namespace FileSys::LZSS {
+
+// The data is decompressed from the end of the buffer towards its beginning. The footer gives
+// the compressed region, which is made of a control byte followed by eight items, each one either
+// a literal byte or a back-reference to previously decompressed data (at higher addresses).
+
+std::size_t GetDecompressedSize(std::span<const u8> compressed) {
+    if (compressed.size() < 8) {
+        return 0;
+    }
+    u32 offset_size;
+    std::memcpy(&offset_size, compressed.data() + compressed.size() - sizeof(u32), sizeof(u32));
+    return offset_size + compressed.size();
+}
+
+bool Decompress(std::span<const u8> compressed, std::span<u8> decompressed) {
+    if (compressed.size() < 8 || decompressed.size() < compressed.size()) {
+        return false;
+    }
+    const u8* footer = compressed.data() + compressed.size() - 8;
+
+    u32 buffer_top_and_bottom;
+    std::memcpy(&buffer_top_and_bottom, footer, sizeof(u32));
+
+    const std::size_t top = (buffer_top_and_bottom >> 24) & 0xFF;
+    const std::size_t bottom = buffer_top_and_bottom & 0xFFFFFF;
+    if (top > compressed.size() || bottom > compressed.size()) {
+        return false;
+    }
+
+    std::size_t out = decompressed.size();
+    std::size_t index = compressed.size() - top;
+    const std::size_t stop_index = compressed.size() - bottom;
+
+    const u8* const in_data = compressed.data();
+    u8* const out_data = decompressed.data();
+
+    std::memcpy(out_data, in_data, compressed.size());
+    std::memset(out_data + compressed.size(), 0, decompressed.size() - compressed.size());
+
+    while (index > stop_index) {
+        u8 control = in_data[--index];
+
+        // Fast path for a full group of literals, they are copied in the same (descending)
+        // order on both sides, so this is a plain copy.
+        if (control == 0 && index >= stop_index + 8 && out >= 8) {
+            index -= 8;
+            out -= 8;
+            std::memcpy(out_data + out, in_data + index, 8);
+            continue;
+        }
+
+        for (unsigned i = 0; i < 8; i++) {
+            if (index <= stop_index || index == 0 || out == 0) {
+                break;
+            }
+
+            if (control & 0x80) {
+                // Check if compression is out of bounds
+                if (index < 2) {
+                    return false;
+                }
+                index -= 2;
+
+                const u32 segment = in_data[index] | (in_data[index + 1] << 8);
+                const std::size_t segment_size = ((segment >> 12) & 15) + 3;
+                const std::size_t segment_offset = (segment & 0x0FFF) + 2;
+
+                // Check if compression is out of bounds. The source is above the destination,
+                // so checking its highest address covers the whole segment.
+                if (out < segment_size || out + segment_offset >= decompressed.size()) {
+                    return false;
+                }
+
+                // Each output byte is read from segment_offset + 1 bytes above it.
+                out -= segment_size;
+                u8* const dest = out_data + out;
+                const u8* const src = dest + segment_offset + 1;
+                if (segment_offset + 1 >= segment_size) {
+                    // Non-overlapping, can copy the whole segment at once.
+                    std::memcpy(dest, src, segment_size);
+                } else {
+                    // Overlapping, bytes written are read again by the same segment.
+                    for (std::size_t j = segment_size; j-- > 0;) {
+                        dest[j] = src[j];
+                    }
+                }
+            } else {
+                out--;
+                out_data[out] = in_data[--index];
+            }
+            control <<= 1;
+        }
+    }
+    return true;
+}
+
+} // namespace FileSys::LZSS
@@ -0,0 +1,28 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <span>
+
+#include "common/common_types.h"
+
+namespace FileSys::LZSS {
+
+/**
+ * Get the decompressed size of an LZSS compressed ExeFS file
+ * @param compressed Buffer of compressed file
+ * @return Size of decompressed buffer, 0 if the buffer is too small to be valid
+ */
+std::size_t GetDecompressedSize(std::span<const u8> compressed);
+
+/**
+ * Decompress ExeFS file (compressed with backwards LZSS)
+ * @param compressed Compressed buffer
+ * @param decompressed Decompressed buffer, of the size returned by GetDecompressedSize
+ * @return True on success, otherwise false
+ */
+bool Decompress(std::span<const u8> compressed, std::span<u8> decompressed);
+
+} // namespace FileSys::LZSS
@@ -12,9 +12,11 @@
 #include "common/logging/log.h"
 #include "core/core.h"
 #include "core/file_sys/layered_fs.h"
+#include "core/file_sys/lzss.h"
 #include "core/file_sys/ncch_container.h"
 #include "core/file_sys/patch.h"
 #include "core/file_sys/seed_db.h"
+#include "core/hw/aes/ctr.h"
 #include "core/hw/aes/key.h"
 #include "core/loader/loader.h"
 
@@ -31,85 +33,6 @@ u64 GetModId(u64 program_id) {
     return program_id;
 }
 
-/**
- * Get the decompressed size of an LZSS compressed ExeFS file
- * @param buffer Buffer of compressed file
- * @param size Size of compressed buffer
- * @return Size of decompressed buffer
- */
-static std::size_t LZSS_GetDecompressedSize(std::span<const u8> buffer) {
-    u32 offset_size;
-    std::memcpy(&offset_size, buffer.data() + buffer.size() - sizeof(u32), sizeof(u32));
-    return offset_size + buffer.size();
-}
-
-/**
- * Decompress ExeFS file (compressed with LZSS)
- * @param compressed Compressed buffer
- * @param compressed_size Size of compressed buffer
- * @param decompressed Decompressed buffer
- * @param decompressed_size Size of decompressed buffer
- * @return True on success, otherwise false
- */
-static bool LZSS_Decompress(std::span<const u8> compressed, std::span<u8> decompressed) {
-    const u8* footer = compressed.data() + compressed.size() - 8;
-
-    u32 buffer_top_and_bottom;
-    std::memcpy(&buffer_top_and_bottom, footer, sizeof(u32));
-
-    std::size_t out = decompressed.size();
-    std::size_t index = compressed.size() - ((buffer_top_and_bottom >> 24) & 0xFF);
-    std::size_t stop_index = compressed.size() - (buffer_top_and_bottom & 0xFFFFFF);
-
-    std::memset(decompressed.data(), 0, decompressed.size());
-    std::memcpy(decompressed.data(), compressed.data(), compressed.size());
-
-    while (index > stop_index) {
-        u8 control = compressed[--index];
-
-        for (unsigned i = 0; i < 8; i++) {
-            if (index <= stop_index)
-                break;
-            if (index <= 0)
-                break;
-            if (out <= 0)
-                break;
-
-            if (control & 0x80) {
-                // Check if compression is out of bounds
-                if (index < 2)
-                    return false;
-                index -= 2;
-
-                u32 segment_offset = compressed[index] | (compressed[index + 1] << 8);
-                u32 segment_size = ((segment_offset >> 12) & 15) + 3;
-                segment_offset &= 0x0FFF;
-                segment_offset += 2;
-
-                // Check if compression is out of bounds
-                if (out < segment_size)
-                    return false;
-
-                for (unsigned j = 0; j < segment_size; j++) {
-                    // Check if compression is out of bounds
-                    if (out + segment_offset >= decompressed.size())
-                        return false;
-
-                    u8 data = decompressed[out + segment_offset];
-                    decompressed[--out] = data;
-                }
-            } else {
-                // Check if compression is out of bounds
-                if (out < 1)
-                    return false;
-                decompressed[--out] = compressed[--index];
-            }
-            control <<= 1;
-        }
-    }
-    return true;
-}
-
 NCCHContainer::NCCHContainer(const std::string& filepath, u32 ncch_offset, u32 partition)
     : ncch_offset(ncch_offset), partition(partition), filepath(filepath) {
     file = FileUtil::IOFile(filepath, "rb");
@@ -521,9 +444,8 @@ Loader::ResultStatus NCCHContainer::LoadSectionExeFS(const char* name, std::vect
             LOG_DEBUG(Service_FS, "{} - offset: 0x{:08X}, size: 0x{:08X}, name: {}", section_number,
                       section.offset, section.size, section.name);
 
-            s64 section_offset =
+            const std::size_t section_offset =
                 (section.offset + exefs_offset + sizeof(ExeFs_Header) + ncch_offset);
-            exefs_file.Seek(section_offset, SEEK_SET);
 
             std::array<u8, 16> key;
             if (strcmp(section.name, "icon") == 0 || strcmp(section.name, "banner") == 0) {
@@ -532,34 +454,40 @@ Loader::ResultStatus NCCHContainer::LoadSectionExeFS(const char* name, std::vect
                 key = secondary_key;
             }
 
-            CryptoPP::CTR_Mode<CryptoPP::AES>::Decryption dec(key.data(), key.size(),
-                                                              exefs_ctr.data());
-            dec.Seek(section.offset + sizeof(ExeFs_Header));
-
-            if (strcmp(section.name, ".code") == 0 && is_compressed) {
-                // Section is compressed, read compressed .code section...
-                std::vector<u8> temp_buffer(section.size);
-                if (exefs_file.ReadBytes(temp_buffer.data(), temp_buffer.size()) !=
-                    temp_buffer.size())
+            // Plaintext sections are used straight from the mapped file, others are copied out
+            // of it (or read, if the file couldn't be mapped) and decrypted.
+            if (!exefs_mapping.IsOpen()) {
+                exefs_mapping = FileUtil::MappedFile(exefs_file);
+            }
+            std::span<const u8> section_data = exefs_mapping.GetSpan(section_offset, section.size);
+            std::vector<u8> temp_buffer;
+            if (section_data.size() != section.size || is_encrypted) {
+                temp_buffer.resize(section.size);
+                if (section_data.size() == section.size) {
+                    std::memcpy(temp_buffer.data(), section_data.data(), section.size);
+                } else if (exefs_file.ReadAtBytes(temp_buffer.data(), temp_buffer.size(),
+                                                  section_offset) != temp_buffer.size()) {
                     return Loader::ResultStatus::Error;
+                }
 
                 if (is_encrypted) {
-                    dec.ProcessData(&temp_buffer[0], &temp_buffer[0], section.size);
+                    HW::AES::CTRCipher cipher(key, exefs_ctr);
+                    cipher.Process(section.offset + sizeof(ExeFs_Header), temp_buffer);
                 }
+                section_data = temp_buffer;
+            }
 
+            if (strcmp(section.name, ".code") == 0 && is_compressed) {
                 // Decompress .code section...
-                buffer.resize(LZSS_GetDecompressedSize(temp_buffer));
-                if (!LZSS_Decompress(temp_buffer, buffer)) {
+                buffer.resize(LZSS::GetDecompressedSize(section_data));
+                if (!LZSS::Decompress(section_data, buffer)) {
                     return Loader::ResultStatus::ErrorInvalidFormat;
                 }
-            } else {
+            } else if (temp_buffer.empty()) {
                 // Section is uncompressed...
-                buffer.resize(section.size);
-                if (exefs_file.ReadBytes(buffer.data(), section.size) != section.size)
-                    return Loader::ResultStatus::Error;
-                if (is_encrypted) {
-                    dec.ProcessData(buffer.data(), buffer.data(), section.size);
-                }
+                buffer.assign(section_data.begin(), section_data.end());
+            } else {
+                buffer = std::move(temp_buffer);
             }
 
             return Loader::ResultStatus::Success;
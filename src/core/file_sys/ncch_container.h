@@ -11,6 +11,7 @@
 #include "common/bit_field.h"
 #include "common/common_types.h"
 #include "common/file_util.h"
+#include "common/mapped_file.h"
 #include "common/swap.h"
 #include "core/file_sys/romfs_reader.h"
 #include "core/loader/loader.h"
@@ -362,6 +363,7 @@ private:
     std::string filepath;
     FileUtil::IOFile file;
     FileUtil::IOFile exefs_file;
+    FileUtil::MappedFile exefs_mapping;
 };
 
 } // namespace FileSys
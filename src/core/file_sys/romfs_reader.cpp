@@ -1,7 +1,6 @@
 #include <algorithm>
+#include <cstring>
 #include <vector>
-#include <cryptopp/aes.h>
-#include <cryptopp/modes.h>
 #include "common/archives.h"
 #include "common/logging/log.h"
 #include "core/file_sys/romfs_reader.h"
@@ -15,49 +14,50 @@ std::size_t DirectRomFSReader::ReadFile(std::size_t offset, std::size_t length,
     if (length == 0)
         return 0; // Crypto++ does not like zero size buffer
 
+    if (mapping.IsOpen()) {
+        const auto data = mapping.GetSpan(file_offset + offset, length);
+        if (last_read_end.exchange(offset + length) == offset) {
+            mapping.AdviseSequential(file_offset + offset + length,
+                                     readahead_pages * cache_line_size);
+        }
+        if (!data.empty()) {
+            std::memcpy(buffer, data.data(), data.size());
+        }
+        return data.size();
+    }
+
     const auto segments = BreakupRead(offset, length);
-    std::size_t read_progress = 0;
 
     // Skip cache if the read is too big
     if (segments.size() == 1 && segments[0].second > cache_line_size) {
-        length = file.ReadAtBytes(buffer, length, file_offset + offset);
-        if (is_encrypted) {
-            CryptoPP::CTR_Mode<CryptoPP::AES>::Decryption d(key.data(), key.size(), ctr.data());
-            d.Seek(crypto_offset + offset);
-            d.ProcessData(buffer, buffer, length);
-        }
+        length = ReadRaw(offset, length, buffer);
         LOG_TRACE(Service_FS, "RomFS Cache SKIP: offset={}, length={}", offset, length);
         return length;
     }
 
-    // TODO(PabloMK7): Make cache thread safe, read the comment in CacheReady function.
-    // std::unique_lock<std::shared_mutex> read_guard(cache_mutex);
+    // Reads that continue exactly where the previous one ended are likely part of a stream,
+    // so prefetch the next few pages on a miss.
+    const bool sequential = last_read_end.exchange(offset + length) == offset;
+
+    std::size_t read_progress = 0;
     for (const auto& seg : segments) {
-        std::size_t read_size = cache_line_size;
-        std::size_t page = OffsetToPage(seg.first);
-        // Check if segment is in cache
-        auto cache_entry = cache.request(page);
-        if (!cache_entry.first) {
-            // If not found, read from disk and cache the data
-            read_size = file.ReadAtBytes(cache_entry.second.data(), read_size, file_offset + page);
-            if (is_encrypted && read_size) {
-                CryptoPP::CTR_Mode<CryptoPP::AES>::Decryption d(key.data(), key.size(), ctr.data());
-                d.Seek(crypto_offset + page);
-                d.ProcessData(cache_entry.second.data(), cache_entry.second.data(), read_size);
-            }
-            LOG_TRACE(Service_FS, "RomFS Cache MISS: page={}, length={}, into={}", page, seg.second,
-                      (seg.first - page));
-        } else {
+        const std::size_t page = OffsetToPage(seg.first);
+        const std::size_t into = seg.first - page;
+        auto copied = CopyFromCache(page, into, seg.second, buffer + read_progress);
+        if (copied) {
             LOG_TRACE(Service_FS, "RomFS Cache HIT: page={}, length={}, into={}", page, seg.second,
-                      (seg.first - page));
+                      into);
+        } else {
+            LOG_TRACE(Service_FS, "RomFS Cache MISS: page={}, length={}, into={}", page,
+                      seg.second, into);
+            FillCache(page, sequential ? 1 + readahead_pages : 1);
+            copied = CopyFromCache(page, into, seg.second, buffer + read_progress);
+            if (!copied) {
+                // Another thread evicted the page before we could copy it, read it directly.
+                copied = ReadRaw(seg.first, seg.second, buffer + read_progress);
+            }
         }
-        std::size_t copy_amount =
-            (read_size > (seg.first - page))
-                ? std::min((seg.first - page) + seg.second, read_size) - (seg.first - page)
-                : 0;
-        std::memcpy(buffer + read_progress, cache_entry.second.data() + (seg.first - page),
-                    copy_amount);
-        read_progress += copy_amount;
+        read_progress += *copied;
     }
     return read_progress;
 }
@@ -67,23 +67,89 @@ bool DirectRomFSReader::AllowsCachedReads() const {
 }
 
 bool DirectRomFSReader::CacheReady(std::size_t file_offset, std::size_t length) {
+    if (mapping.IsOpen()) {
+        return mapping.IsResident(this->file_offset + file_offset, length);
+    }
+
     auto segments = BreakupRead(file_offset, length);
     if (segments.size() == 1 && segments[0].second > cache_line_size) {
         return false;
-    } else {
-        // TODO(PabloMK7): Since the LRU cache is not thread safe, a lock must be used.
-        // However, this completely breaks the point of using a cache, because
-        // smaller reads may be blocked by bigger reads. For now, always return
-        // data being in cache to prevent the need of a lock, and only read data
-        // asynchronously if it is too big to use the cache.
-        /*
-        std::shared_lock<std::shared_mutex> read_guard(cache_mutex);
-        for (auto it = segments.begin(); it != segments.end(); it++) {
-            if (!cache.contains(OffsetToPage(it->first)))
-                return false;
+    }
+    // The pages may still be evicted before the read happens, in which case ReadFile
+    // falls back to reading them synchronously.
+    for (const auto& seg : segments) {
+        const std::size_t page = OffsetToPage(seg.first);
+        auto& shard = ShardForPage(page);
+        std::scoped_lock lock(shard.mutex);
+        if (!shard.lines.contains(page)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::optional<HostFileRange> DirectRomFSReader::GetHostRange(std::size_t offset,
+                                                             std::size_t length) const {
+    // Encrypted and compressed data has to go through ReadFile
+    if (is_encrypted || file.IsCompressed() || offset > data_size) {
+        return std::nullopt;
+    }
+    return HostFileRange{file.GetFd(), file_offset + offset,
+                         std::min<std::size_t>(length, data_size - offset)};
+}
+
+std::size_t DirectRomFSReader::ReadRaw(std::size_t offset, std::size_t length, u8* buffer) {
+    length = file.ReadAtBytes(buffer, length, file_offset + offset);
+    if (is_encrypted && length) {
+        cipher.Process(crypto_offset + offset, {buffer, length});
+    }
+    return length;
+}
+
+std::optional<std::size_t> DirectRomFSReader::CopyFromCache(std::size_t page,
+                                                            std::size_t page_offset,
+                                                            std::size_t length, u8* buffer) {
+    auto& shard = ShardForPage(page);
+    std::scoped_lock lock(shard.mutex);
+    if (!shard.lines.contains(page)) {
+        return std::nullopt;
+    }
+    const auto& line = shard.lines.request(page).second;
+    const std::size_t copy_amount =
+        (line.size > page_offset) ? std::min(page_offset + length, line.size) - page_offset : 0;
+    std::memcpy(buffer, line.data.data() + page_offset, copy_amount);
+    return copy_amount;
+}
+
+void DirectRomFSReader::FillCache(std::size_t first_page, std::size_t page_count) {
+    const std::size_t last_page = OffsetToPage(static_cast<std::size_t>(data_size) - 1);
+    page_count = std::min(page_count, (last_page - first_page) / cache_line_size + 1);
+
+    // Stop the readahead at the first page that is already cached.
+    for (std::size_t i = 1; i < page_count; i++) {
+        const std::size_t page = first_page + i * cache_line_size;
+        auto& shard = ShardForPage(page);
+        std::scoped_lock lock(shard.mutex);
+        if (shard.lines.contains(page)) {
+            page_count = i;
+            break;
         }
-        */
-        return true;
+    }
+
+    // Read and decrypt all the pages at once, without holding any lock.
+    std::vector<u8> data(std::min(page_count * cache_line_size,
+                                  static_cast<std::size_t>(data_size) - first_page));
+    const std::size_t read_size =
+        std::min(ReadRaw(first_page, data.size(), data.data()), data.size());
+
+    for (std::size_t i = 0; i < page_count && i * cache_line_size < read_size; i++) {
+        const std::size_t page = first_page + i * cache_line_size;
+        const std::size_t size = std::min(cache_line_size, read_size - i * cache_line_size);
+        auto& shard = ShardForPage(page);
+        std::scoped_lock lock(shard.mutex);
+        auto& line = shard.lines.request(page).second;
+        std::memcpy(line.data.data(), data.data() + i * cache_line_size, size);
+        line.size = size;
     }
 }
 
@@ -1,14 +1,19 @@
 #pragma once
 
 #include <array>
-#include <shared_mutex>
+#include <atomic>
+#include <mutex>
+#include <optional>
 #include <boost/serialization/array.hpp>
 #include <boost/serialization/base_object.hpp>
 #include <boost/serialization/export.hpp>
 #include "common/alignment.h"
 #include "common/common_types.h"
 #include "common/file_util.h"
+#include "common/mapped_file.h"
 #include "common/static_lru_cache.h"
+#include "core/file_sys/file_backend.h"
+#include "core/hw/aes/ctr.h"
 
 namespace FileSys {
 
@@ -24,6 +29,12 @@ public:
     virtual bool AllowsCachedReads() const = 0;
     virtual bool CacheReady(std::size_t file_offset, std::size_t length) = 0;
 
+    /// Gets the host file range holding the data at offset, if it is stored as is
+    virtual std::optional<HostFileRange> GetHostRange(std::size_t offset,
+                                                      std::size_t length) const {
+        return std::nullopt;
+    }
+
 private:
     template <class Archive>
     void serialize(Archive& ar, const unsigned int file_version) {}
@@ -36,14 +47,14 @@ private:
 class DirectRomFSReader : public RomFSReader {
 public:
     DirectRomFSReader(FileUtil::IOFile&& file, std::size_t file_offset, std::size_t data_size)
-        : is_encrypted(false), file(std::move(file)), file_offset(file_offset),
-          data_size(data_size) {}
+        : is_encrypted(false), file(std::move(file)), mapping(this->file),
+          file_offset(file_offset), data_size(data_size) {}
 
     DirectRomFSReader(FileUtil::IOFile&& file, std::size_t file_offset, std::size_t data_size,
                       const std::array<u8, 16>& key, const std::array<u8, 16>& ctr,
                       std::size_t crypto_offset)
-        : is_encrypted(true), file(std::move(file)), key(key), ctr(ctr), file_offset(file_offset),
-          crypto_offset(crypto_offset), data_size(data_size) {}
+        : is_encrypted(true), file(std::move(file)), key(key), ctr(ctr), cipher(key, ctr),
+          file_offset(file_offset), crypto_offset(crypto_offset), data_size(data_size) {}
 
     ~DirectRomFSReader() override = default;
 
@@ -57,22 +68,45 @@ public:
 
     bool CacheReady(std::size_t file_offset, std::size_t length) override;
 
+    std::optional<HostFileRange> GetHostRange(std::size_t offset,
+                                              std::size_t length) const override;
+
 private:
     bool is_encrypted;
     FileUtil::IOFile file;
+    // Plaintext RomFS are read through a memory mapping, the host page cache being used instead
+    // of our own page cache.
+    FileUtil::MappedFile mapping;
     std::array<u8, 16> key;
     std::array<u8, 16> ctr;
+    HW::AES::CTRCipher cipher;
     u64 file_offset;
     u64 crypto_offset;
     u64 data_size;
 
-    // Total cache size: 128KB
+    // Total cache size: 256KB
     static constexpr std::size_t cache_line_size = (1 << 13); // About 8KB
-    static constexpr std::size_t cache_line_count = 16;
-
-    Common::StaticLRUCache<std::size_t, std::array<u8, cache_line_size>, cache_line_count> cache;
-    // TODO(PabloMK7): Make cache thread safe, read the comment in CacheReady function.
-    // std::shared_mutex cache_mutex;
+    static constexpr std::size_t cache_shard_count = 4;
+    static constexpr std::size_t cache_lines_per_shard = 8;
+    // Number of extra pages fetched on a miss when the guest is streaming sequentially.
+    static constexpr std::size_t readahead_pages = 3;
+
+    struct CacheLine {
+        std::array<u8, cache_line_size> data;
+        std::size_t size; ///< Amount of valid bytes, less than a full line at the end of the RomFS
+    };
+
+    // The cache is split into independently locked shards, consecutive pages being spread
+    // across them. Locks are only held while copying a page in or out, never while reading
+    // from disk, so small cached reads are not blocked behind slow misses.
+    struct CacheShard {
+        std::mutex mutex;
+        Common::StaticLRUCache<std::size_t, CacheLine, cache_lines_per_shard> lines;
+    };
+    std::array<CacheShard, cache_shard_count> cache_shards;
+
+    // Offset right after the last cached read, used to detect sequential streams.
+    std::atomic<std::size_t> last_read_end{0};
 
     DirectRomFSReader() = default;
 
@@ -80,9 +114,24 @@ private:
         return Common::AlignDown<std::size_t>(offset, cache_line_size);
     }
 
+    CacheShard& ShardForPage(std::size_t page) {
+        return cache_shards[(page / cache_line_size) % cache_shard_count];
+    }
+
     std::vector<std::pair<std::size_t, std::size_t>> BreakupRead(std::size_t offset,
                                                                  std::size_t length);
 
+    /// Reads data from the underlying file, decrypting it if needed.
+    std::size_t ReadRaw(std::size_t offset, std::size_t length, u8* buffer);
+
+    /// Copies part of a cached page into buffer. Returns the amount copied, or std::nullopt if
+    /// the page is not cached.
+    std::optional<std::size_t> CopyFromCache(std::size_t page, std::size_t page_offset,
+                                             std::size_t length, u8* buffer);
+
+    /// Reads page_count pages starting at first_page from disk and inserts them in the cache.
+    void FillCache(std::size_t first_page, std::size_t page_count);
+
     template <class Archive>
     void serialize(Archive& ar, const unsigned int) {
         ar& boost::serialization::base_object<RomFSReader>(*this);
@@ -93,6 +142,13 @@ private:
         ar& file_offset;
         ar& crypto_offset;
         ar& data_size;
+        if (Archive::is_loading::value) {
+            if (is_encrypted) {
+                cipher.SetKey(key, ctr);
+            } else {
+                mapping = FileUtil::MappedFile(file);
+            }
+        }
     }
     friend class boost::serialization::access;
 };
@@ -0,0 +1,208 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "common/polyfill_thread.h"
+#include "common/thread.h"
+#include "core/hle/kernel/async_executor.h"
+
+namespace Kernel {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct {
+    std::atomic<u64> completed;
+    std::atomic<u64> total_wait_us;
+    std::atomic<u64> total_latency_us;
+    std::atomic<u32> queue_depth;
+    std::atomic<u32> max_queue_depth;
+} g_stats;
+
+u64 MicrosecondsSince(Clock::time_point start) {
+    return static_cast<u64>(
+        std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count());
+}
+
+} // Anonymous namespace
+
+struct AsyncExecutor::Impl {
+    struct Job {
+        Task task;
+        std::promise<void> promise;
+        Clock::time_point submitted;
+        bool may_block; ///< Not counted against the service limit
+    };
+
+    struct Session {
+        std::string service;
+        std::deque<Job> jobs;
+    };
+
+    struct Service {
+        u32 limit = DefaultServiceLimit;
+        u32 running = 0;
+    };
+
+    explicit Impl(std::size_t max_threads_) : max_threads{max_threads_} {}
+
+    ~Impl() {
+        for (auto& thread : threads) {
+            thread.request_stop();
+        }
+        condition.notify_all();
+    }
+
+    /// Takes the next job, from the first session in turn whose service is below its limit.
+    bool PopJob(Job& job, std::string& service) {
+        for (auto it = ready_sessions.begin(); it != ready_sessions.end(); ++it) {
+            auto& session = sessions.at(*it);
+            auto& state = services[session.service];
+            const bool may_block = session.jobs.front().may_block;
+            if (!may_block && state.running >= state.limit) {
+                continue;
+            }
+            if (!may_block) {
+                state.running++;
+            }
+            queued_jobs--;
+            job = std::move(session.jobs.front());
+            session.jobs.pop_front();
+            service = session.service;
+
+            // The session goes back to the end of the line if it has more jobs
+            const void* key = *it;
+            ready_sessions.erase(it);
+            if (session.jobs.empty()) {
+                sessions.erase(key);
+            } else {
+                ready_sessions.push_back(key);
+            }
+            return true;
+        }
+        return false;
+    }
+
+    void WorkerLoop(std::stop_token stop_token) {
+        Common::SetCurrentThreadName("HLEAsync");
+        std::unique_lock lock{mutex};
+        while (!stop_token.stop_requested()) {
+            Job job;
+            std::string service;
+            idle_threads++;
+            Common::CondvarWait(condition, lock, stop_token, [&] { return PopJob(job, service); });
+            idle_threads--;
+            if (stop_token.stop_requested()) {
+                return;
+            }
+
+            lock.unlock();
+            g_stats.total_wait_us.fetch_add(MicrosecondsSince(job.submitted));
+            try {
+                job.task();
+                job.promise.set_value();
+            } catch (...) {
+                job.promise.set_exception(std::current_exception());
+            }
+            g_stats.total_latency_us.fetch_add(MicrosecondsSince(job.submitted));
+            g_stats.completed.fetch_add(1);
+            g_stats.queue_depth.fetch_sub(1);
+            lock.lock();
+
+            // A slot of the service was freed, which may let another thread start a job
+            if (job.may_block) {
+                blocking_jobs--;
+            } else {
+                services[service].running--;
+            }
+            condition.notify_all();
+        }
+    }
+
+    std::size_t max_threads;
+
+    std::mutex mutex;
+    std::condition_variable_any condition;
+    std::unordered_map<const void*, Session> sessions;
+    /// Sessions with queued jobs, in the order they take turns
+    std::list<const void*> ready_sessions;
+    std::unordered_map<std::string, Service> services;
+    std::size_t queued_jobs = 0;
+    /// Jobs that may block, queued or running. Each one allows a thread above max_threads, so
+    /// that they cannot take all the threads from the other jobs.
+    std::size_t blocking_jobs = 0;
+    std::size_t idle_threads = 0;
+    std::vector<std::jthread> threads;
+};
+
+AsyncExecutor::AsyncExecutor(std::size_t max_threads) : impl{std::make_unique<Impl>(max_threads)} {}
+
+AsyncExecutor::~AsyncExecutor() = default;
+
+std::future<void> AsyncExecutor::Submit(const std::string& service, const void* session,
+                                        Task task, bool may_block) {
+    const u32 depth = g_stats.queue_depth.fetch_add(1) + 1;
+    u32 max_depth = g_stats.max_queue_depth.load(std::memory_order_relaxed);
+    while (depth > max_depth && !g_stats.max_queue_depth.compare_exchange_weak(max_depth, depth)) {
+    }
+
+    Impl::Job job{std::move(task), {}, Clock::now(), may_block};
+    auto future = job.promise.get_future();
+    {
+        std::scoped_lock lock{impl->mutex};
+        auto [it, inserted] = impl->sessions.try_emplace(session);
+        if (inserted) {
+            it->second.service = service;
+            impl->ready_sessions.push_back(session);
+        }
+        it->second.jobs.push_back(std::move(job));
+        impl->queued_jobs++;
+        if (may_block) {
+            impl->blocking_jobs++;
+        }
+
+        // Threads are only created when there are not enough waiting for work
+        if (impl->queued_jobs > impl->idle_threads &&
+            impl->threads.size() < impl->max_threads + impl->blocking_jobs) {
+            impl->threads.emplace_back(
+                [this](std::stop_token stop_token) { impl->WorkerLoop(stop_token); });
+        }
+    }
+    impl->condition.notify_all();
+    return future;
+}
+
+void AsyncExecutor::SetServiceLimit(const std::string& service, u32 limit) {
+    {
+        std::scoped_lock lock{impl->mutex};
+        impl->services[service].limit = limit;
+    }
+    impl->condition.notify_all();
+}
+
+AsyncExecutor& AsyncExecutor::Get() {
+    static AsyncExecutor executor{32};
+    return executor;
+}
+
+AsyncExecutorStats AsyncExecutor::TakeStats() {
+    AsyncExecutorStats stats;
+    stats.completed = g_stats.completed.exchange(0);
+    stats.total_wait_us = g_stats.total_wait_us.exchange(0);
+    stats.total_latency_us = g_stats.total_latency_us.exchange(0);
+    stats.queue_depth = g_stats.queue_depth.load();
+    stats.max_queue_depth = g_stats.max_queue_depth.exchange(stats.queue_depth);
+    return stats;
+}
+
+} // namespace Kernel
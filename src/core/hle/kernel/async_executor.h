@@ -0,0 +1,70 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include "common/common_types.h"
+
+namespace Kernel {
+
+/// Statistics of the async executor since they were last taken
+struct AsyncExecutorStats {
+    u64 completed{};        ///< Number of completed tasks
+    u64 total_wait_us{};    ///< Sum of the times tasks were queued before running
+    u64 total_latency_us{}; ///< Sum of the submission to completion latencies
+    u32 queue_depth{};      ///< Tasks currently queued or running
+    u32 max_queue_depth{};  ///< Highest number of tasks queued or running
+};
+
+/**
+ * Runs the async sections of HLE requests (HLERequestContext::RunAsync) on a shared pool of
+ * threads, which grows on demand up to a fixed number of threads and keeps them for later
+ * requests. Async sections often block on the host (sockets, HTTP), so tasks are not stolen or
+ * split: each one holds a thread until it returns.
+ *
+ * Tasks of a client session start in the order they were submitted, and sessions with queued tasks
+ * take turns when every thread is busy. A service can only run a limited number of tasks at once,
+ * so that it cannot take all the threads from the others. Tasks that may block until the guest
+ * makes another request are exempt from that limit and get extra threads, as holding them back
+ * could hold back the request they wait for.
+ */
+class AsyncExecutor {
+public:
+    using Task = std::function<void()>;
+
+    /// Tasks a service can run at once unless SetServiceLimit was called for it
+    static constexpr u32 DefaultServiceLimit = 16;
+
+    explicit AsyncExecutor(std::size_t max_threads);
+    ~AsyncExecutor();
+
+    /**
+     * Queues a task.
+     * @param service Name of the service the task is run for, used for concurrency limits
+     * @param session Client session the task is run for, tasks of a session start in order
+     * @param may_block Whether the task can block until the guest makes another request
+     * @returns Future completed once the task returned
+     */
+    std::future<void> Submit(const std::string& service, const void* session, Task task,
+                             bool may_block = false);
+
+    /// Sets the number of tasks of a service that can run at once.
+    void SetServiceLimit(const std::string& service, u32 limit);
+
+    /// Returns the executor shared by the emulator, created on first use
+    static AsyncExecutor& Get();
+
+    /// Returns the statistics accumulated since the last call and resets them
+    static AsyncExecutorStats TakeStats();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+};
+
+} // namespace Kernel
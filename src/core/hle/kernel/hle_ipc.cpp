@@ -12,12 +12,14 @@
 #include "common/assert.h"
 #include "common/common_types.h"
 #include "core/core.h"
+#include "core/hle/kernel/async_executor.h"
 #include "core/hle/kernel/event.h"
 #include "core/hle/kernel/handle_table.h"
 #include "core/hle/kernel/hle_ipc.h"
 #include "core/hle/kernel/ipc_debugger/recorder.h"
 #include "core/hle/kernel/kernel.h"
 #include "core/hle/kernel/process.h"
+#include "core/hle/service/service.h"
 
 SERIALIZE_EXPORT_IMPL(Kernel::SessionRequestHandler)
 SERIALIZE_EXPORT_IMPL(Kernel::SessionRequestHandler::SessionDataBase)
@@ -121,6 +123,16 @@ std::shared_ptr<Event> HLERequestContext::SleepClientThread(
     return event;
 }
 
+std::future<void> HLERequestContext::SubmitAsync(std::function<void()> task, bool may_block) {
+    // Limits apply to every session handled by the same service
+    std::string service = session->GetName();
+    if (const auto framework =
+            dynamic_cast<const Service::ServiceFrameworkBase*>(session->hle_handler.get())) {
+        service = framework->GetServiceName();
+    }
+    return AsyncExecutor::Get().Submit(service, session.get(), std::move(task), may_block);
+}
+
 HLERequestContext::HLERequestContext() : kernel(Core::Global<KernelSystem>()) {}
 
 HLERequestContext::HLERequestContext(KernelSystem& kernel, std::shared_ptr<ServerSession> session,
@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <array>
 #include <chrono>
+#include <functional>
 #include <future>
 #include <memory>
 #include <string>
@@ -249,6 +250,9 @@ public:
                                              std::shared_ptr<WakeupCallback> callback);
 
 private:
+    /// Runs a task on the async executor, on behalf of the service and session of the request.
+    std::future<void> SubmitAsync(std::function<void()> task, bool may_block);
+
     template <typename ResultFunctor>
     class AsyncWakeUpCallback : public WakeupCallback {
     public:
@@ -257,6 +261,13 @@ private:
             future = std::move(fut);
         }
 
+        ~AsyncWakeUpCallback() override {
+            // The async section refers to the context, which must outlive it
+            if (future.valid()) {
+                future.wait();
+            }
+        }
+
         void WakeUp(std::shared_ptr<Kernel::Thread> thread, Kernel::HLERequestContext& ctx,
                     Kernel::ThreadWakeupReason reason) {
             functor(ctx);
@@ -278,7 +289,7 @@ private:
 
 public:
     /**
-     * Puts the game thread to sleep and calls the specified async_section asynchronously.
+     * Puts the game thread to sleep and calls the specified async_section on the async executor.
      * Once the execution of the async section finishes, result_function is called. Use this
      * mechanism to run blocking IO operations, so that other game threads are allowed to run
      * while the one performing the blocking operation waits.
@@ -290,20 +301,22 @@ public:
      * and can be used to set the IPC result.
      * @param really_async If set to false, it will call both async_section and result_function
      * from the emulator thread.
+     * @param may_block Whether async_section can block until the guest makes another request, as
+     * blocking socket calls do. Such sections are not counted against the concurrency limit of
+     * the service, so that they cannot keep the request that unblocks them from running.
      */
     template <typename AsyncFunctor, typename ResultFunctor>
     void RunAsync(AsyncFunctor async_section, ResultFunctor result_function,
-                  bool really_async = true) {
+                  bool really_async = true, bool may_block = false) {
 
         if (really_async) {
-            this->SleepClientThread(
-                "RunAsync", std::chrono::nanoseconds(-1),
-                std::make_shared<AsyncWakeUpCallback<ResultFunctor>>(
-                    result_function,
-                    std::move(std::async(std::launch::async, [this, async_section] {
-                        s64 sleep_for = async_section(*this);
-                        this->thread->WakeAfterDelay(sleep_for, true);
-                    }))));
+            auto task = [this, async_section] {
+                s64 sleep_for = async_section(*this);
+                this->thread->WakeAfterDelay(sleep_for, true);
+            };
+            this->SleepClientThread("RunAsync", std::chrono::nanoseconds(-1),
+                                    std::make_shared<AsyncWakeUpCallback<ResultFunctor>>(
+                                        result_function, SubmitAsync(std::move(task), may_block)));
 
         } else {
             s64 sleep_for = async_section(*this);
@@ -318,6 +331,28 @@ public:
         }
     }
 
+    /**
+     * Puts the game thread to sleep until an asynchronous host operation completes, then calls
+     * result_function. Unlike RunAsync, no host thread waits for the operation.
+     * @param submit Callable that takes a std::function<void(s64)> as argument and starts the
+     * operation. The operation calls that function once done, from any thread, with the amount of
+     * nanoseconds to wait before calling result_function.
+     * @param result_function Callable that takes Kernel::HLERequestContext& as argument
+     * and doesn't return anything. This callable is ran from the emulator thread
+     * and can be used to set the IPC result.
+     */
+    template <typename SubmitFunctor, typename ResultFunctor>
+    void RunAsyncIO(SubmitFunctor submit, ResultFunctor result_function) {
+        auto completed = std::make_shared<std::promise<void>>();
+        this->SleepClientThread("RunAsyncIO", std::chrono::nanoseconds(-1),
+                                std::make_shared<AsyncWakeUpCallback<ResultFunctor>>(
+                                    result_function, completed->get_future()));
+        submit(std::function<void(s64)>([this, completed](s64 sleep_for) {
+            this->thread->WakeAfterDelay(sleep_for, true);
+            completed->set_value();
+        }));
+    }
+
     /**
      * Resolves a object id from the request command buffer into a pointer to an object. See the
      * "HLE handle protocol" section in the class documentation for more details.
@@ -8,7 +8,9 @@
 #include "common/archives.h"
 #include "common/logging/log.h"
 #include "common/microprofile.h"
+#include "common/perf_counters.h"
 #include "common/scm_rev.h"
+#include "common/tracing.h"
 #include "core/arm/arm_interface.h"
 #include "core/core.h"
 #include "core/core_timing.h"
@@ -2237,6 +2239,7 @@ MICROPROFILE_DEFINE(Kernel_SVC, "Kernel", "SVC", MP_RGB(70, 200, 70));
 
 void SVC::CallSVC(u32 immediate) {
     MICROPROFILE_SCOPE(Kernel_SVC);
+    Common::PerfCounters::Add(Common::PerfCounters::Counter::SVCCalls);
 
     // Lock the kernel mutex when we enter the kernel HLE.
     std::scoped_lock lock{kernel.GetHLELock()};
@@ -2248,6 +2251,7 @@ void SVC::CallSVC(u32 immediate) {
     LOG_TRACE(Kernel_SVC, "calling {}", info->name);
     if (info) {
         if (info->func) {
+            Common::Tracing::Scope trace_scope{"SVC", info->name};
             (this->*(info->func))();
         } else {
             LOG_ERROR(Kernel_SVC, "unimplemented SVC function {}(..)", info->name);
@@ -3,10 +3,14 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <condition_variable>
 #include <cstddef>
 #include <cstring>
+#include <mutex>
+#include <queue>
 #include <cryptopp/aes.h>
 #include <cryptopp/modes.h>
+#include <cryptopp/sha.h>
 #include <fmt/format.h>
 #include "common/alignment.h"
 #include "common/archives.h"
@@ -14,6 +18,7 @@
 #include "common/file_util.h"
 #include "common/logging/log.h"
 #include "common/string_util.h"
+#include "common/thread.h"
 #include "core/core.h"
 #include "core/file_sys/errors.h"
 #include "core/file_sys/ncch_container.h"
@@ -85,6 +90,142 @@ public:
     std::vector<CryptoPP::CBC_Mode<CryptoPP::AES>::Decryption> content;
 };
 
+/**
+ * Installs a single content as a pipeline: chunks of CIA data are queued by the caller, then
+ * decrypted and hashed on one thread and written out on another. The queues are bounded, so a
+ * slow disk eventually throttles the caller.
+ */
+class CIAFile::ContentInstaller {
+public:
+    using Decryption = CryptoPP::CBC_Mode<CryptoPP::AES>::Decryption;
+
+    ContentInstaller(FileUtil::IOFile& file_, Decryption* decryption_, u64 content_size,
+                     const std::array<u8, 0x20>& expected_hash_)
+        : file(file_), decryption(decryption_), hash_remaining(content_size),
+          expected_hash(expected_hash_) {
+        crypto_thread = std::jthread([this] { CryptoLoop(); });
+        write_thread = std::jthread([this] { WriteLoop(); });
+    }
+
+    ~ContentInstaller() {
+        Finish();
+    }
+
+    /// Queues a chunk of content data. Blocks if the pipeline is full.
+    void Push(std::vector<u8>&& chunk) {
+        ASSERT(!chunk.empty() && !end_of_data);
+        input_queue.Push(std::move(chunk));
+    }
+
+    /// Signals that all the content data has been queued.
+    void EndOfData() {
+        if (!end_of_data) {
+            // An empty chunk marks the end of the data
+            input_queue.Push({});
+            end_of_data = true;
+        }
+    }
+
+    /**
+     * Waits for all queued data to be written out.
+     * @returns whether the content was written successfully and its hash matches the TMD
+     */
+    bool Finish() {
+        if (!finished) {
+            EndOfData();
+            crypto_thread.join();
+            write_thread.join();
+            verified = !write_failed && hash == expected_hash;
+            finished = true;
+        }
+        return verified;
+    }
+
+    bool IsFinished() const {
+        return finished;
+    }
+
+private:
+    /// Blocking queue of data chunks with a fixed capacity, connecting the pipeline stages.
+    class ChunkQueue {
+    public:
+        void Push(std::vector<u8>&& chunk) {
+            std::unique_lock lock{mutex};
+            not_full.wait(lock, [this] { return chunks.size() < Capacity; });
+            chunks.push(std::move(chunk));
+            not_empty.notify_one();
+        }
+
+        std::vector<u8> Pop() {
+            std::unique_lock lock{mutex};
+            not_empty.wait(lock, [this] { return !chunks.empty(); });
+            std::vector<u8> chunk = std::move(chunks.front());
+            chunks.pop();
+            not_full.notify_one();
+            return chunk;
+        }
+
+    private:
+        static constexpr std::size_t Capacity = 16;
+
+        std::mutex mutex;
+        std::condition_variable not_empty;
+        std::condition_variable not_full;
+        std::queue<std::vector<u8>> chunks;
+    };
+
+    void CryptoLoop() {
+        Common::SetCurrentThreadName("CIAFile:Crypto");
+        CryptoPP::SHA256 sha;
+        for (;;) {
+            std::vector<u8> chunk = input_queue.Pop();
+            const bool end = chunk.empty();
+            if (!end) {
+                if (decryption) {
+                    decryption->ProcessData(chunk.data(), chunk.data(), chunk.size());
+                }
+                // Anything past the size given by the TMD is padding, not part of the hash
+                const std::size_t hash_size = std::min<u64>(chunk.size(), hash_remaining);
+                sha.Update(chunk.data(), hash_size);
+                hash_remaining -= hash_size;
+            }
+            output_queue.Push(std::move(chunk));
+            if (end) {
+                break;
+            }
+        }
+        sha.Final(hash.data());
+    }
+
+    void WriteLoop() {
+        Common::SetCurrentThreadName("CIAFile:Write");
+        for (;;) {
+            std::vector<u8> chunk = output_queue.Pop();
+            if (chunk.empty()) {
+                break;
+            }
+            if (file.WriteBytes(chunk.data(), chunk.size()) != chunk.size()) {
+                write_failed = true;
+            }
+        }
+    }
+
+    FileUtil::IOFile& file;
+    Decryption* decryption;
+    u64 hash_remaining;
+    std::array<u8, 0x20> expected_hash;
+    std::array<u8, 0x20> hash{};
+    bool end_of_data = false;
+    bool write_failed = false;
+    bool finished = false;
+    bool verified = false;
+
+    ChunkQueue input_queue;
+    ChunkQueue output_queue;
+    std::jthread crypto_thread;
+    std::jthread write_thread;
+};
+
 CIAFile::CIAFile(Core::System& system_, Service::FS::MediaType media_type)
     : system(system_), media_type(media_type),
       decryption_state(std::make_unique<DecryptionState>()) {}
@@ -156,6 +297,8 @@ Result CIAFile::WriteTitleMetadata() {
     auto content_count = container.GetTitleMetadata().GetContentCount();
     content_written.resize(content_count);
 
+    content_installers.clear();
+    content_installers.resize(content_count);
     content_files.clear();
     for (std::size_t i = 0; i < content_count; i++) {
         auto path = GetTitleContentPath(media_type, tmd.GetTitleID(), i, is_update);
@@ -210,32 +353,56 @@ ResultVal<std::size_t> CIAFile::WriteContentData(u64 offset, std::size_t length,
 
             // Figure out how much of this content ID we have just recieved/can write out
             const u64 available_to_write = std::min(offset_max, range_max) - range_min;
-
-            // Since the incoming TMD has already been written, we can use GetTitleContentPath
-            // to get the content paths to write to.
-            FileSys::TitleMetadata tmd = container.GetTitleMetadata();
-            auto& file = content_files[i];
-
-            std::vector<u8> temp(buffer + (range_min - offset),
-                                 buffer + (range_min - offset) + available_to_write);
-
-            if ((tmd.GetContentTypeByIndex(i) & FileSys::TMDContentTypeFlag::Encrypted) != 0) {
-                decryption_state->content[i].ProcessData(temp.data(), temp.data(), temp.size());
+            if (available_to_write == 0) {
+                continue;
             }
 
-            file.WriteBytes(temp.data(), temp.size());
+            auto& installer = content_installers[i];
+            if (!installer) {
+                installer = StartContentInstall(i);
+            }
+            installer->Push(std::vector<u8>(buffer + (range_min - offset),
+                                            buffer + (range_min - offset) + available_to_write));
 
             // Keep tabs on how much of this content ID has been written so new range_min
             // values can be calculated.
             content_written[i] += available_to_write;
             LOG_DEBUG(Service_AM, "Wrote {:x} to content {}, total {:x}", available_to_write, i,
                       content_written[i]);
+
+            if (content_written[i] >= size) {
+                installer->EndOfData();
+            }
         }
     }
 
     return length;
 }
 
+std::unique_ptr<CIAFile::ContentInstaller> CIAFile::StartContentInstall(std::size_t index) {
+    // Contents are laid out one after the other, so the oldest pipelines have all their data
+    // queued already. Wait for them to drain to bound the amount of threads in use.
+    auto in_flight = std::count_if(
+        content_installers.begin(), content_installers.end(),
+        [](const auto& installer) { return installer && !installer->IsFinished(); });
+    for (auto& installer : content_installers) {
+        if (in_flight < static_cast<std::ptrdiff_t>(MaxParallelContents)) {
+            break;
+        }
+        if (installer && !installer->IsFinished()) {
+            installer->Finish();
+            in_flight--;
+        }
+    }
+
+    const FileSys::TitleMetadata& tmd = container.GetTitleMetadata();
+    const bool encrypted =
+        (tmd.GetContentTypeByIndex(index) & FileSys::TMDContentTypeFlag::Encrypted) != 0;
+    return std::make_unique<ContentInstaller>(
+        content_files[index], encrypted ? &decryption_state->content[index] : nullptr,
+        tmd.GetContentSizeByIndex(index), tmd.GetContentHashByIndex(index));
+}
+
 ResultVal<std::size_t> CIAFile::Write(u64 offset, std::size_t length, bool flush,
                                       const u8* buffer) {
     written += length;
@@ -319,8 +486,18 @@ bool CIAFile::SetSize(u64 size) const {
 }
 
 bool CIAFile::Close() const {
+    // Wait for the content pipelines to drain, and check the written data against the TMD
+    bool verified = true;
+    for (std::size_t i = 0; i < content_installers.size(); i++) {
+        if (content_installers[i] && !content_installers[i]->Finish()) {
+            LOG_ERROR(Service_AM, "Content {} could not be written or failed hash verification",
+                      i);
+            verified = false;
+        }
+    }
+
     bool complete =
-        install_state >= CIAInstallState::TMDLoaded &&
+        verified && install_state >= CIAInstallState::TMDLoaded &&
         content_written.size() == container.GetTitleMetadata().GetContentCount() &&
         std::all_of(content_written.begin(), content_written.end(),
                     [this, i = 0](auto& bytes_written) mutable {
@@ -331,7 +508,7 @@ bool CIAFile::Close() const {
     if (!complete) {
         LOG_ERROR(Service_AM, "CIAFile closed prematurely, aborting install...");
         FileUtil::DeleteDir(GetTitlePath(media_type, container.GetTitleMetadata().GetTitleID()));
-        return true;
+        return false;
     }
 
     // Clean up older content data if we installed newer content on top
@@ -463,7 +640,10 @@ InstallStatus InstallCIA(const std::string& path,
             }
             total_bytes_read += bytes_read;
         }
-        installFile.Close();
+        if (!installFile.Close()) {
+            LOG_ERROR(Service_AM, "CIA file installation of {} failed", path);
+            return InstallStatus::ErrorAborted;
+        }
 
         LOG_INFO(Service_AM, "Installed {} successfully.", path);
 
@@ -112,6 +112,13 @@ private:
 
     class DecryptionState;
     std::unique_ptr<DecryptionState> decryption_state;
+
+    // Contents being decrypted, verified and written in the background, by content index
+    class ContentInstaller;
+    std::vector<std::unique_ptr<ContentInstaller>> content_installers;
+    static constexpr std::size_t MaxParallelContents = 4;
+
+    std::unique_ptr<ContentInstaller> StartContentInstall(std::size_t index);
 };
 
 // A file handled returned for Tickets to be written into and subsequently installed.
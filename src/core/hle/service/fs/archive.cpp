@@ -22,6 +22,7 @@
 #include "core/file_sys/archive_sdmcwriteonly.h"
 #include "core/file_sys/archive_selfncch.h"
 #include "core/file_sys/archive_systemsavedata.h"
+#include "core/file_sys/disk_archive.h"
 #include "core/file_sys/directory_backend.h"
 #include "core/file_sys/errors.h"
 #include "core/file_sys/file_backend.h"
@@ -66,6 +67,15 @@ ResultVal<ArchiveHandle> ArchiveManager::OpenArchive(ArchiveIdCode id_code,
     return next_handle++;
 }
 
+Result ArchiveManager::CommitArchive(ArchiveHandle handle) {
+    if (GetArchive(handle) == nullptr) {
+        return FileSys::ResultInvalidArchiveHandle;
+    }
+
+    FileSys::DiskFile::WaitForAllWrites();
+    return ResultSuccess;
+}
+
 Result ArchiveManager::CloseArchive(ArchiveHandle handle) {
     if (handle_map.erase(handle) == 0)
         return FileSys::ResultInvalidArchiveHandle;
@@ -91,6 +101,9 @@ Result ArchiveManager::RegisterArchiveType(std::unique_ptr<FileSys::ArchiveFacto
 std::pair<ResultVal<std::shared_ptr<File>>, std::chrono::nanoseconds>
 ArchiveManager::OpenFileFromArchive(ArchiveHandle archive_handle, const FileSys::Path& path,
                                     const FileSys::Mode mode) {
+    // Files written through another handle must be up to date on the host
+    FileSys::DiskFile::WaitForAllWrites();
+
     ArchiveBackend* archive = GetArchive(archive_handle);
     if (archive == nullptr) {
         return std::make_pair(FileSys::ResultInvalidArchiveHandle, std::chrono::nanoseconds{0});
@@ -108,6 +121,8 @@ ArchiveManager::OpenFileFromArchive(ArchiveHandle archive_handle, const FileSys:
 
 Result ArchiveManager::DeleteFileFromArchive(ArchiveHandle archive_handle,
                                              const FileSys::Path& path) {
+    FileSys::DiskFile::WaitForAllWrites();
+
     ArchiveBackend* archive = GetArchive(archive_handle);
     if (archive == nullptr)
         return FileSys::ResultInvalidArchiveHandle;
@@ -119,6 +134,8 @@ Result ArchiveManager::RenameFileBetweenArchives(ArchiveHandle src_archive_handl
                                                  const FileSys::Path& src_path,
                                                  ArchiveHandle dest_archive_handle,
                                                  const FileSys::Path& dest_path) {
+    FileSys::DiskFile::WaitForAllWrites();
+
     ArchiveBackend* src_archive = GetArchive(src_archive_handle);
     ArchiveBackend* dest_archive = GetArchive(dest_archive_handle);
     if (src_archive == nullptr || dest_archive == nullptr)
@@ -134,6 +151,8 @@ Result ArchiveManager::RenameFileBetweenArchives(ArchiveHandle src_archive_handl
 
 Result ArchiveManager::DeleteDirectoryFromArchive(ArchiveHandle archive_handle,
                                                   const FileSys::Path& path) {
+    FileSys::DiskFile::WaitForAllWrites();
+
     ArchiveBackend* archive = GetArchive(archive_handle);
     if (archive == nullptr)
         return FileSys::ResultInvalidArchiveHandle;
@@ -143,6 +162,8 @@ Result ArchiveManager::DeleteDirectoryFromArchive(ArchiveHandle archive_handle,
 
 Result ArchiveManager::DeleteDirectoryRecursivelyFromArchive(ArchiveHandle archive_handle,
                                                              const FileSys::Path& path) {
+    FileSys::DiskFile::WaitForAllWrites();
+
     ArchiveBackend* archive = GetArchive(archive_handle);
     if (archive == nullptr)
         return FileSys::ResultInvalidArchiveHandle;
@@ -152,6 +173,8 @@ Result ArchiveManager::DeleteDirectoryRecursivelyFromArchive(ArchiveHandle archi
 
 Result ArchiveManager::CreateFileInArchive(ArchiveHandle archive_handle, const FileSys::Path& path,
                                            u64 file_size) {
+    FileSys::DiskFile::WaitForAllWrites();
+
     ArchiveBackend* archive = GetArchive(archive_handle);
     if (archive == nullptr)
         return FileSys::ResultInvalidArchiveHandle;
@@ -172,6 +195,8 @@ Result ArchiveManager::RenameDirectoryBetweenArchives(ArchiveHandle src_archive_
                                                       const FileSys::Path& src_path,
                                                       ArchiveHandle dest_archive_handle,
                                                       const FileSys::Path& dest_path) {
+    FileSys::DiskFile::WaitForAllWrites();
+
     ArchiveBackend* src_archive = GetArchive(src_archive_handle);
     ArchiveBackend* dest_archive = GetArchive(dest_archive_handle);
     if (src_archive == nullptr || dest_archive == nullptr)
@@ -187,6 +212,8 @@ Result ArchiveManager::RenameDirectoryBetweenArchives(ArchiveHandle src_archive_
 
 ResultVal<std::shared_ptr<Directory>> ArchiveManager::OpenDirectoryFromArchive(
     ArchiveHandle archive_handle, const FileSys::Path& path) {
+    FileSys::DiskFile::WaitForAllWrites();
+
     ArchiveBackend* archive = GetArchive(archive_handle);
     if (archive == nullptr) {
         return FileSys::ResultInvalidArchiveHandle;
@@ -211,6 +238,8 @@ ResultVal<u64> ArchiveManager::GetFreeBytesInArchive(ArchiveHandle archive_handl
 Result ArchiveManager::FormatArchive(ArchiveIdCode id_code,
                                      const FileSys::ArchiveFormatInfo& format_info,
                                      const FileSys::Path& path, u64 program_id) {
+    FileSys::DiskFile::WaitForAllWrites();
+
     auto archive_itr = id_code_map.find(id_code);
     if (archive_itr == id_code_map.end()) {
         return UnimplementedFunction(ErrorModule::FS); // TODO(Subv): Find the right error
@@ -256,6 +285,8 @@ Result ArchiveManager::CreateExtSaveData(MediaType media_type, u32 high, u32 low
 }
 
 Result ArchiveManager::DeleteExtSaveData(MediaType media_type, u32 high, u32 low) {
+    FileSys::DiskFile::WaitForAllWrites();
+
     // Construct the binary path to the archive first
     FileSys::Path path =
         FileSys::ConstructExtDataBinaryPath(static_cast<u32>(media_type), high, low);
@@ -280,6 +311,8 @@ Result ArchiveManager::DeleteExtSaveData(MediaType media_type, u32 high, u32 low
 }
 
 Result ArchiveManager::DeleteSystemSaveData(u32 high, u32 low) {
+    FileSys::DiskFile::WaitForAllWrites();
+
     // Construct the binary path to the archive first
     const FileSys::Path path = FileSys::ConstructSystemSaveDataBinaryPath(high, low);
 
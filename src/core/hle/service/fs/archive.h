@@ -84,6 +84,13 @@ public:
     ResultVal<ArchiveHandle> OpenArchive(ArchiveIdCode id_code, const FileSys::Path& archive_path,
                                          u64 program_id);
 
+    /**
+     * Commits the pending changes to an archive, waiting for the queued writes to reach the host
+     * file system
+     * @param handle Handle to the archive to commit
+     */
+    Result CommitArchive(ArchiveHandle handle);
+
     /**
      * Closes an archive
      * @param handle Handle to the archive to close
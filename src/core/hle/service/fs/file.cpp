@@ -4,7 +4,9 @@
 
 #include <boost/serialization/unique_ptr.hpp>
 #include "common/archives.h"
+#include "common/host_io.h"
 #include "common/logging/log.h"
+#include "common/perf_counters.h"
 #include "core/core.h"
 #include "core/file_sys/errors.h"
 #include "core/file_sys/file_backend.h"
@@ -20,6 +22,9 @@ SERIALIZE_EXPORT_IMPL(Service::FS::FileSessionSlot)
 
 namespace Service::FS {
 
+/// Host file reads are split in chunks of this size, so that the host can serve them in parallel
+constexpr std::size_t HostReadChunkSize = 256 * 1024;
+
 template <class Archive>
 void File::serialize(Archive& ar, const unsigned int) {
     ar& boost::serialization::base_object<Kernel::SessionRequestHandler>(*this);
@@ -36,6 +41,12 @@ File::File(Kernel::KernelSystem& kernel, std::unique_ptr<FileSys::FileBackend>&&
     this->path = path;
 }
 
+File::~File() {
+    if (backend) {
+        Common::HostIOEngine::Get().Cancel(reinterpret_cast<u64>(backend.get()));
+    }
+}
+
 File::File(Kernel::KernelSystem& kernel)
     : ServiceFramework("", 1), path(""), backend(nullptr), kernel(kernel) {
     static const FunctionInfo functions[] = {
@@ -75,17 +86,26 @@ void File::Read(Kernel::HLERequestContext& ctx) {
                   offset, length, backend->GetSize());
     }
 
-    // Conventional reading if the backend does not support cache.
-    if (!backend->AllowsCachedReads()) {
+    // Cache hits are served from memory. Host file reads of less than a chunk are done right away,
+    // which is as fast as going through the host I/O engine and keeps their timing independent
+    // of the host.
+    const bool cache_ready = backend->AllowsCachedReads() && backend->CacheReady(offset, length);
+    const auto host_range = cache_ready || length < HostReadChunkSize
+                                ? std::nullopt
+                                : backend->GetHostRange(offset, length);
+
+    // Conventional reading if the backend neither is backed by a host file nor supports cache.
+    if (!host_range && !backend->AllowsCachedReads()) {
         auto& buffer = rp.PopMappedBuffer();
         IPC::RequestBuilder rb = rp.MakeBuilder(2, 2);
-        std::unique_ptr<u8*> data = std::make_unique<u8*>(static_cast<u8*>(operator new(length)));
-        const auto read = backend->Read(offset, length, *data);
+        std::vector<u8> data(length);
+        const auto read = backend->Read(offset, length, data.data());
         if (read.Failed()) {
             rb.Push(read.Code());
             rb.Push<u32>(0);
         } else {
-            buffer.Write(*data, 0, *read);
+            buffer.Write(data.data(), 0, *read);
+            Common::PerfCounters::Add(Common::PerfCounters::Counter::FSBytesRead, *read);
             rb.Push(ResultSuccess);
             rb.Push<u32>(static_cast<u32>(*read));
         }
@@ -106,7 +126,7 @@ void File::Read(Kernel::HLERequestContext& ctx) {
         // Output
         Result ret{0};
         Kernel::MappedBuffer* buffer;
-        std::unique_ptr<u8*> data;
+        std::vector<u8> data;
         std::size_t read_size;
     };
 
@@ -114,55 +134,111 @@ void File::Read(Kernel::HLERequestContext& ctx) {
     async_data->buffer = &rp.PopMappedBuffer();
     async_data->length = length;
     async_data->offset = offset;
-    async_data->cache_ready = backend->CacheReady(offset, length);
+    async_data->cache_ready = cache_ready;
     if (!async_data->cache_ready) {
         async_data->pre_timer = std::chrono::steady_clock::now();
     }
 
+    // Time the guest still has to wait once the host read is done
+    const auto remaining_delay = [this, async_data] {
+        const auto read_delay = static_cast<s64>(backend->GetReadDelayNs(async_data->length));
+        if (async_data->cache_ready) {
+            return read_delay;
+        }
+        const auto time_took = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::steady_clock::now() - async_data->pre_timer)
+                                   .count();
+        return static_cast<s64>((read_delay > time_took) ? (read_delay - time_took) : 0);
+    };
+
+    const auto reply = [async_data](Kernel::HLERequestContext& ctx) {
+        IPC::RequestBuilder rb(ctx, 0x0802, 2, 2);
+        if (async_data->ret.IsError()) {
+            rb.Push(async_data->ret);
+            rb.Push<u32>(0);
+        } else {
+            async_data->buffer->Write(async_data->data.data(), 0, async_data->read_size);
+            Common::PerfCounters::Add(Common::PerfCounters::Counter::FSBytesRead,
+                                      async_data->read_size);
+            rb.Push(ResultSuccess);
+            rb.Push<u32>(static_cast<u32>(async_data->read_size));
+        }
+        rb.PushMappedBuffer(*async_data->buffer);
+    };
+
+    const auto read_backend = [this, async_data] {
+        async_data->data.resize(async_data->length);
+        const auto read =
+            backend->Read(async_data->offset, async_data->length, async_data->data.data());
+        if (read.Failed()) {
+            async_data->ret = read.Code();
+            async_data->read_size = 0;
+        } else {
+            async_data->ret = ResultSuccess;
+            async_data->read_size = *read;
+        }
+    };
+
     // LOG_DEBUG(Service_FS, "cache={}, offset={}, length={}", cache_ready, offset, length);
-    ctx.RunAsync(
-        [this, async_data](Kernel::HLERequestContext& ctx) {
-            async_data->data =
-                std::make_unique<u8*>(static_cast<u8*>(operator new(async_data->length)));
-            const auto read =
-                backend->Read(async_data->offset, async_data->length, *async_data->data);
-            if (read.Failed()) {
-                async_data->ret = read.Code();
-                async_data->read_size = 0;
-            } else {
-                async_data->ret = ResultSuccess;
-                async_data->read_size = *read;
+    if (async_data->cache_ready) {
+        ctx.RunAsync(
+            [read_backend, remaining_delay](Kernel::HLERequestContext& ctx) {
+                read_backend();
+                return remaining_delay();
+            },
+            reply, false);
+        return;
+    }
+
+    // Everything else is done by the host I/O engine, the guest thread being woken up from its
+    // completion.
+    const u64 owner = reinterpret_cast<u64>(backend.get());
+    ctx.RunAsyncIO(
+        [async_data, host_range, owner, read_backend,
+         remaining_delay](std::function<void(s64)> wake_up) {
+            auto& engine = Common::HostIOEngine::Get();
+            if (!host_range) {
+                engine.SubmitTask(
+                    owner,
+                    [read_backend] {
+                        read_backend();
+                        return s64{0};
+                    },
+                    [async_data, remaining_delay, wake_up](s64 result) {
+                        if (result < 0) {
+                            async_data->ret = ResultUnknown;
+                            async_data->read_size = 0;
+                        }
+                        wake_up(remaining_delay());
+                    });
+                return;
             }
 
-            const auto read_delay = static_cast<s64>(backend->GetReadDelayNs(async_data->length));
-            if (!async_data->cache_ready) {
-                const auto time_took = std::chrono::duration_cast<std::chrono::nanoseconds>(
-                                           std::chrono::steady_clock::now() - async_data->pre_timer)
-                                           .count();
-                /*
-                if (time_took > read_delay) {
-                    LOG_DEBUG(Service_FS, "Took longer! length={}, time_took={}, read_delay={}",
-                              async_data->length, time_took, read_delay);
-                }
-                */
-                return static_cast<s64>((read_delay > time_took) ? (read_delay - time_took) : 0);
-            } else {
-                return static_cast<s64>(read_delay);
+            async_data->data.resize(host_range->length);
+            std::vector<Common::HostIOEngine::ReadRequest> reads;
+            for (std::size_t done = 0; done < host_range->length; done += HostReadChunkSize) {
+                const std::size_t chunk = std::min(HostReadChunkSize, host_range->length - done);
+                reads.push_back({host_range->fd, host_range->offset + done,
+                                 std::span<u8>(async_data->data.data() + done, chunk)});
             }
-        },
-        [async_data](Kernel::HLERequestContext& ctx) {
-            IPC::RequestBuilder rb(ctx, 0x0802, 2, 2);
-            if (async_data->ret.IsError()) {
-                rb.Push(async_data->ret);
-                rb.Push<u32>(0);
-            } else {
-                async_data->buffer->Write(*async_data->data, 0, async_data->read_size);
-                rb.Push(ResultSuccess);
-                rb.Push<u32>(static_cast<u32>(async_data->read_size));
+            const auto completion = [async_data, remaining_delay, wake_up](s64 result) {
+                if (result < 0) {
+                    LOG_ERROR(Service_FS, "Host read failed with error {}", result);
+                    async_data->ret = ResultUnknown;
+                    async_data->read_size = 0;
+                } else {
+                    async_data->ret = ResultSuccess;
+                    async_data->read_size = static_cast<std::size_t>(result);
+                }
+                wake_up(remaining_delay());
+            };
+            if (reads.empty()) {
+                completion(0);
+                return;
             }
-            rb.PushMappedBuffer(*async_data->buffer);
+            engine.SubmitReads(owner, reads, completion);
         },
-        !async_data->cache_ready);
+        reply);
 }
 
 void File::Write(Kernel::HLERequestContext& ctx) {
@@ -240,9 +316,12 @@ void File::Close(Kernel::HLERequestContext& ctx) {
         LOG_WARNING(Service_FS, "Closing File backend but {} clients still connected",
                     connected_sessions.size());
 
+    // Reads still queued are of no use anymore
+    Common::HostIOEngine::Get().Cancel(reinterpret_cast<u64>(backend.get()));
+    const Result write_result = backend->TakeWriteResult();
     backend->Close();
     IPC::RequestBuilder rb = rp.MakeBuilder(1, 0);
-    rb.Push(ResultSuccess);
+    rb.Push(write_result);
 }
 
 void File::Flush(Kernel::HLERequestContext& ctx) {
@@ -259,7 +338,7 @@ void File::Flush(Kernel::HLERequestContext& ctx) {
     }
 
     backend->Flush();
-    rb.Push(ResultSuccess);
+    rb.Push(backend->TakeWriteResult());
 }
 
 void File::SetPriority(Kernel::HLERequestContext& ctx) {
@@ -343,12 +343,20 @@ void FS_USER::ControlArchive(Kernel::HLERequestContext& ctx) {
     [[maybe_unused]] const auto input = rp.PopMappedBuffer();
     [[maybe_unused]] const auto output = rp.PopMappedBuffer();
 
+    IPC::RequestBuilder rb = rp.MakeBuilder(1, 0);
+
+    // Action 0 commits the save data, the point at which it must be durable
+    if (action == 0) {
+        LOG_DEBUG(Service_FS, "called, archive_handle={:016X}, commit", archive_handle);
+        rb.Push(archives.CommitArchive(archive_handle));
+        return;
+    }
+
     LOG_WARNING(Service_FS,
                 "(STUBBED) called, archive_handle={:016X}, action={:08X}, input_size={:08X}, "
                 "output_size={:08X}",
                 archive_handle, action, input_size, output_size);
 
-    IPC::RequestBuilder rb = rp.MakeBuilder(1, 0);
     rb.Push(ResultSuccess);
 }
 
@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <chrono>
 #include <cstring>
 #include <boost/serialization/list.hpp>
 #include <boost/serialization/map.hpp>
@@ -33,7 +34,30 @@ void NWM_UDS::serialize(Archive& ar, const unsigned int) {
     ar& boost::serialization::base_object<Kernel::SessionRequestHandler>(*this);
     ar& node_map;
     ar& connection_event;
-    ar& received_beacons;
+
+    // Beacons are stored as a list in the order they were received
+    std::list<Network::WifiPacket> beacons;
+    if (Archive::is_saving::value) {
+        std::vector<const ReceivedBeacon*> sorted_beacons;
+        for (const auto& [address, beacon] : received_beacons) {
+            sorted_beacons.push_back(&beacon);
+        }
+        std::sort(sorted_beacons.begin(), sorted_beacons.end(),
+                  [](const auto* a, const auto* b) { return a->sequence < b->sequence; });
+        for (const auto* beacon : sorted_beacons) {
+            beacons.push_back(beacon->packet);
+        }
+    }
+    ar& beacons;
+    if (Archive::is_loading::value) {
+        received_beacons.clear();
+        // Host time does not carry over, the beacons start aging again when they are loaded
+        const auto now = std::chrono::steady_clock::now();
+        for (auto& beacon : beacons) {
+            const auto address = beacon.transmitter_address;
+            received_beacons[address] = {std::move(beacon), next_beacon_sequence++, now};
+        }
+    }
     // wifi_packet_received set in constructor
 }
 
@@ -48,28 +72,78 @@ enum {
 // TODO(Subv): Find a more accurate value for this limit.
 constexpr std::size_t MaxBeaconFrames = 15;
 
+// Host time after which a beacon that was not retrieved is discarded, as its host may be gone.
+constexpr auto MaxBeaconAge = std::chrono::seconds(5);
+
+// Minimum host time between two warnings about the frames dropped on a full data channel.
+constexpr auto DroppedFramesLogInterval = std::chrono::seconds(1);
+
 // Network node id used when a SecureData packet is addressed to every connected node.
 constexpr u16 BroadcastNetworkNodeId = 0xFFFF;
 
 // The Host has always dest_node_id 1
 constexpr u16 HostDestNodeId = 1;
 
-std::list<Network::WifiPacket> NWM_UDS::GetReceivedBeacons(const MacAddress& sender) {
+DataFrameQueue::DataFrameQueue() : frames(Capacity) {}
+
+bool DataFrameQueue::Push(u16 src_node_id, std::span<const u8> data) {
+    if (count == Capacity || data.size() > UDSMaxDataSize) {
+        return false;
+    }
+    auto& frame = frames[(read_index + count) % Capacity];
+    frame.src_node_id = src_node_id;
+    frame.size = static_cast<u16>(data.size());
+    std::memcpy(frame.data.data(), data.data(), data.size());
+    count++;
+    return true;
+}
+
+const ReceivedDataFrame& DataFrameQueue::Front() const {
+    ASSERT(count != 0);
+    return frames[read_index];
+}
+
+void DataFrameQueue::Pop() {
+    ASSERT(count != 0);
+    read_index = (read_index + 1) % Capacity;
+    count--;
+}
+
+std::vector<Network::WifiPacket> NWM_UDS::GetReceivedBeacons(const MacAddress& sender) {
     std::scoped_lock lock(beacon_mutex);
+    EvictStaleBeacons();
+    std::vector<Network::WifiPacket> beacons;
     if (sender != Network::BroadcastMac) {
-        std::list<Network::WifiPacket> filtered_list;
-        const auto beacon = std::find_if(received_beacons.begin(), received_beacons.end(),
-                                         [&sender](const Network::WifiPacket& packet) {
-                                             return packet.transmitter_address == sender;
-                                         });
+        const auto beacon = received_beacons.find(sender);
         if (beacon != received_beacons.end()) {
-            filtered_list.push_back(*beacon);
+            beacons.push_back(std::move(beacon->second.packet));
             // TODO(B3N30): Check if the complete deque is cleared or just the fetched entries
             received_beacons.erase(beacon);
         }
-        return filtered_list;
+        return beacons;
     }
-    return std::move(received_beacons);
+
+    // Return the beacons in the order they were received
+    std::vector<ReceivedBeacon*> sorted_beacons;
+    sorted_beacons.reserve(received_beacons.size());
+    for (auto& [address, beacon] : received_beacons) {
+        sorted_beacons.push_back(&beacon);
+    }
+    std::sort(sorted_beacons.begin(), sorted_beacons.end(),
+              [](const auto* a, const auto* b) { return a->sequence < b->sequence; });
+    beacons.reserve(sorted_beacons.size());
+    for (auto* beacon : sorted_beacons) {
+        beacons.push_back(std::move(beacon->packet));
+    }
+    received_beacons.clear();
+    return beacons;
+}
+
+void NWM_UDS::EvictStaleBeacons() {
+    const auto now = std::chrono::steady_clock::now();
+    std::erase_if(received_beacons, [now](const auto& entry) {
+        return now - entry.second.received_time > MaxBeaconAge;
+    });
 }
 
 /// Sends a WifiPacket to the room we're currently connected to.
@@ -145,21 +219,20 @@ void NWM_UDS::HandleNodeMapPacket(const Network::WifiPacket& packet) {
 
 void NWM_UDS::HandleBeaconFrame(const Network::WifiPacket& packet) {
     std::scoped_lock lock(beacon_mutex);
-    const auto unique_beacon =
-        std::find_if(received_beacons.begin(), received_beacons.end(),
-                     [&packet](const Network::WifiPacket& new_packet) {
-                         return new_packet.transmitter_address == packet.transmitter_address;
-                     });
-    if (unique_beacon != received_beacons.end()) {
-        // We already have a beacon from the same mac in the deque, remove the old one;
-        received_beacons.erase(unique_beacon);
-    }
 
-    received_beacons.emplace_back(packet);
-
-    // Discard old beacons if the buffer is full.
-    if (received_beacons.size() > MaxBeaconFrames)
-        received_beacons.pop_front();
+    // A beacon from the same mac replaces the old one
+    auto& beacon = received_beacons[packet.transmitter_address];
+    beacon.packet = packet;
+    beacon.sequence = next_beacon_sequence++;
+    beacon.received_time = std::chrono::steady_clock::now();
+
+    // Discard the oldest beacon if the buffer is full.
+    if (received_beacons.size() > MaxBeaconFrames) {
+        received_beacons.erase(std::min_element(
+            received_beacons.begin(), received_beacons.end(), [](const auto& a, const auto& b) {
+                return a.second.sequence < b.second.sequence;
+            }));
+    }
 }
 
 void NWM_UDS::HandleAssociationResponseFrame(const Network::WifiPacket& packet) {
@@ -320,6 +393,11 @@ void NWM_UDS::HandleEAPoLPacket(const Network::WifiPacket& packet) {
 }
 
 void NWM_UDS::HandleSecureDataPacket(const Network::WifiPacket& packet) {
+    constexpr std::size_t HeadersSize = sizeof(LLCHeader) + sizeof(SecureDataHeader);
+    if (packet.data.size() < HeadersSize) {
+        LOG_ERROR(Service_NWM, "Received a truncated SecureData packet");
+        return;
+    }
     const auto secure_data = ParseSecureDataHeader(packet.data);
     std::scoped_lock lock{connection_status_mutex, system.Kernel().GetHLELock()};
 
@@ -373,11 +451,30 @@ void NWM_UDS::HandleSecureDataPacket(const Network::WifiPacket& packet) {
         channel_info->second.network_node_id != secure_data.src_node_id)
         return;
 
-    // Add the received packet to the data queue.
-    channel_info->second.received_packets.emplace_back(packet.data);
+    // Add the data of the received packet to the data queue.
+    const std::size_t data_size = secure_data.GetActualDataSize();
+    if (data_size > packet.data.size() - HeadersSize) {
+        LOG_ERROR(Service_NWM, "Received a SecureData packet with an invalid size");
+        return;
+    }
+    auto& bind_node = channel_info->second;
+    if (!bind_node.received_frames.Push(secure_data.src_node_id,
+                                        std::span{packet.data}.subspan(HeadersSize, data_size))) {
+        // A game that stops reading a channel drops every frame sent to it, so the drops are
+        // counted and reported at most once per interval.
+        bind_node.dropped_frames++;
+        const auto now = std::chrono::steady_clock::now();
+        if (now - bind_node.last_drop_log >= DroppedFramesLogInterval) {
+            LOG_WARNING(Service_NWM, "Receive queue of data channel {} is full, dropped {} packets",
+                        secure_data.data_channel, bind_node.dropped_frames);
+            bind_node.dropped_frames = 0;
+            bind_node.last_drop_log = now;
+        }
+        return;
+    }
 
     // Signal the data event. We can do this directly because we locked hle_lock
-    channel_info->second.event->Signal();
+    bind_node.event->Signal();
 }
 
 void NWM_UDS::StartConnectionSequence(const MacAddress& server) {
@@ -1140,8 +1237,7 @@ void NWM_UDS::SendTo(Kernel::HLERequestContext& ctx) {
         return;
     }
 
-    constexpr std::size_t MaxSize = 0x5C6;
-    if (data_size > MaxSize) {
+    if (data_size > UDSMaxDataSize) {
         rb.Push(Result(ErrorDescription::TooLarge, ErrorModule::UDS, ErrorSummary::WrongArgument,
                        ErrorLevel::Usage));
         return;
@@ -1200,7 +1296,7 @@ void NWM_UDS::PullPacket(Kernel::HLERequestContext& ctx) {
         return;
     }
 
-    if (channel->second.received_packets.empty()) {
+    if (channel->second.received_frames.Empty()) {
         std::vector<u8> output_buffer(buff_size);
         IPC::RequestBuilder rb = rp.MakeBuilder(3, 2);
         rb.Push(ResultSuccess);
@@ -1210,10 +1306,8 @@ void NWM_UDS::PullPacket(Kernel::HLERequestContext& ctx) {
         return;
     }
 
-    const auto& next_packet = channel->second.received_packets.front();
-
-    auto secure_data = ParseSecureDataHeader(next_packet);
-    auto data_size = secure_data.GetActualDataSize();
+    const auto& next_frame = channel->second.received_frames.Front();
+    const u32 data_size = next_frame.size;
 
     if (data_size > max_out_buff_size) {
         IPC::RequestBuilder rb = rp.MakeBuilder(1, 0);
@@ -1226,15 +1320,14 @@ void NWM_UDS::PullPacket(Kernel::HLERequestContext& ctx) {
 
     std::vector<u8> output_buffer(buff_size);
     // Write the actual data.
-    std::memcpy(output_buffer.data(),
-                next_packet.data() + sizeof(LLCHeader) + sizeof(SecureDataHeader), data_size);
+    std::memcpy(output_buffer.data(), next_frame.data.data(), data_size);
 
     rb.Push(ResultSuccess);
     rb.Push<u32>(data_size);
-    rb.Push<u16>(secure_data.src_node_id);
+    rb.Push<u16>(next_frame.src_node_id);
     rb.PushStaticBuffer(std::move(output_buffer), 0);
 
-    channel->second.received_packets.pop_front();
+    channel->second.received_frames.Pop();
 }
 
 void NWM_UDS::GetChannel(Kernel::HLERequestContext& ctx) {
@@ -6,12 +6,12 @@
 
 #include <array>
 #include <atomic>
+#include <chrono>
 #include <cstddef>
-#include <deque>
-#include <list>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <span>
 #include <unordered_map>
 #include <vector>
 #include <boost/optional.hpp>
@@ -47,6 +47,9 @@ const u16 DefaultBeaconInterval = 100;
 /// The maximum number of nodes that can exist in an UDS session.
 constexpr u32 UDSMaxNodes = 16;
 
+/// The maximum size of the data of an UDS packet, without its headers.
+constexpr std::size_t UDSMaxDataSize = 0x5C6;
+
 struct NodeInfo {
     u64_le friend_code_seed;
     std::array<u16_le, 10> username;
@@ -129,6 +132,50 @@ enum class TagId : u8 {
     VendorSpecific = 221
 };
 
+/// Data of a received UDS packet, without its headers
+struct ReceivedDataFrame {
+    u16 src_node_id; ///< Network node id of the sender
+    u16 size;        ///< Size of the data
+    std::array<u8, UDSMaxDataSize> data;
+};
+
+/**
+ * Data frames received on a bind node, in the order they were received. The frames are kept in a
+ * ring of preallocated buffers, so that receiving a frame does not allocate memory.
+ */
+class DataFrameQueue {
+public:
+    /// Number of frames the queue can hold, frames received while it is full are dropped
+    static constexpr std::size_t Capacity = 64;
+
+    DataFrameQueue();
+
+    /**
+     * Adds a frame to the end of the queue.
+     * @returns False if the queue is full or the data is larger than UDSMaxDataSize
+     */
+    bool Push(u16 src_node_id, std::span<const u8> data);
+
+    /// Returns the oldest frame of the queue, which must not be empty.
+    const ReceivedDataFrame& Front() const;
+
+    /// Removes the oldest frame of the queue, which must not be empty.
+    void Pop();
+
+    bool Empty() const {
+        return count == 0;
+    }
+
+    std::size_t Size() const {
+        return count;
+    }
+
+private:
+    std::vector<ReceivedDataFrame> frames;
+    std::size_t read_index = 0;
+    std::size_t count = 0;
+};
+
 class NWM_UDS final : public ServiceFramework<NWM_UDS> {
 public:
     explicit NWM_UDS(Core::System& system);
@@ -461,7 +508,13 @@ private:
      * Returns a list of received 802.11 beacon frames from the specified sender since the last
      * call.
      */
-    std::list<Network::WifiPacket> GetReceivedBeacons(const MacAddress& sender);
+    std::vector<Network::WifiPacket> GetReceivedBeacons(const MacAddress& sender);
+
+    /**
+     * Removes the beacons that were received longer than MaxBeaconAge ago, in host time.
+     * Must be called with beacon_mutex held.
+     */
+    void EvictStaleBeacons();
 
     /*
      * Returns an available index in the nodes array for the
@@ -531,8 +584,10 @@ private:
         u8 channel;          ///< Channel that this bind node was bound to.
         u16 network_node_id; ///< Node id this bind node is associated with, only packets from this
                              /// network node will be received.
-        std::shared_ptr<Kernel::Event> event;         ///< Receive event for this bind node.
-        std::deque<std::vector<u8>> received_packets; ///< List of packets received on this channel.
+        std::shared_ptr<Kernel::Event> event; ///< Receive event for this bind node.
+        DataFrameQueue received_frames;       ///< Frames received on this channel.
+        u32 dropped_frames = 0; ///< Frames dropped since the last warning about them.
+        std::chrono::steady_clock::time_point last_drop_log{}; ///< Host time of that warning.
     };
 
     // Mapping of data channels to their internal data.
@@ -577,8 +632,16 @@ private:
     // the network thread.
     std::mutex beacon_mutex;
 
-    // List of the last <MaxBeaconFrames> beacons received from the network.
-    std::list<Network::WifiPacket> received_beacons;
+    struct ReceivedBeacon {
+        Network::WifiPacket packet;
+        u64 sequence; ///< Order in which the beacons were received
+        /// Host time of reception, only used to discard stale beacons
+        std::chrono::steady_clock::time_point received_time;
+    };
+
+    // Last beacon received from each transmitter, at most <MaxBeaconFrames> of them.
+    std::unordered_map<MacAddress, ReceivedBeacon, Network::MacAddressHash> received_beacons;
+    u64 next_beacon_sequence = 0;
 
     template <class Archive>
     void serialize(Archive& ar, const unsigned int);
@@ -1021,7 +1021,8 @@ void SOC_U::Accept(Kernel::HLERequestContext& ctx) {
             rb.Push(ResultSuccess);
             rb.Push(async_data->ret);
             rb.PushStaticBuffer(std::move(ctr_addr_buf), 0);
-        });
+        },
+        true, holder.blocking);
 }
 
 void SOC_U::SockAtMark(Kernel::HLERequestContext& ctx) {
@@ -1376,7 +1377,7 @@ void SOC_U::RecvFromOther(Kernel::HLERequestContext& ctx) {
             rb.PushStaticBuffer(std::move(async_data->addr_buff), 0);
             rb.PushMappedBuffer(*async_data->buffer);
         },
-        needs_async);
+        needs_async, needs_async);
 }
 
 void SOC_U::RecvFrom(Kernel::HLERequestContext& ctx) {
@@ -1499,7 +1500,7 @@ void SOC_U::RecvFrom(Kernel::HLERequestContext& ctx) {
             rb.PushStaticBuffer(std::move(async_data->output_buff), 0);
             rb.PushStaticBuffer(std::move(async_data->addr_buff), 1);
         },
-        needs_async);
+        needs_async, needs_async);
 }
 
 void SOC_U::Poll(Kernel::HLERequestContext& ctx) {
@@ -1576,7 +1577,7 @@ void SOC_U::Poll(Kernel::HLERequestContext& ctx) {
             LOG_POLL(Service_SOC, "called, fd_count={}, ret={}", async_data->nfds,
                      static_cast<s32>(async_data->ret));
         },
-        timeout != 0);
+        timeout != 0, timeout != 0);
 }
 
 void SOC_U::GetSockName(Kernel::HLERequestContext& ctx) {
@@ -1816,7 +1817,8 @@ void SOC_U::Connect(Kernel::HLERequestContext& ctx) {
             IPC::RequestBuilder rb(ctx, 0x06, 2, 0);
             rb.Push(ResultSuccess);
             rb.Push(async_data->ret);
-        });
+        },
+        true, holder.blocking);
 }
 
 void SOC_U::InitializeSockets(Kernel::HLERequestContext& ctx) {
@@ -0,0 +1,80 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <mutex>
+#include <cryptopp/aes.h>
+#include <cryptopp/modes.h>
+#include "common/worker_pool.h"
+#include "core/hw/aes/ctr.h"
+
+namespace HW::AES {
+
+namespace {
+
+// Buffers smaller than this are processed on the calling thread.
+constexpr std::size_t ParallelThreshold = 1024 * 1024;
+// Size of the chunks processed by each worker, multiple of the AES block size.
+constexpr std::size_t ParallelChunkSize = 256 * 1024;
+
+void ProcessWithNewContext(const AESKey& key, const AESIV& ctr, u64 stream_offset,
+                           std::span<u8> data) {
+    CryptoPP::CTR_Mode<CryptoPP::AES>::Decryption context(key.data(), key.size(), ctr.data());
+    context.Seek(stream_offset);
+    context.ProcessData(data.data(), data.data(), data.size());
+}
+
+} // Anonymous namespace
+
+struct CTRCipher::Impl {
+    AESKey key{};
+    AESIV ctr{};
+
+    // Keyed context reused by small requests. Requests that find it busy use a temporary one.
+    std::mutex context_mutex;
+    CryptoPP::CTR_Mode<CryptoPP::AES>::Decryption context;
+};
+
+CTRCipher::CTRCipher() : impl(std::make_unique<Impl>()) {}
+
+CTRCipher::CTRCipher(const AESKey& key, const AESIV& ctr) : CTRCipher() {
+    SetKey(key, ctr);
+}
+
+CTRCipher::~CTRCipher() = default;
+
+void CTRCipher::SetKey(const AESKey& key, const AESIV& ctr) {
+    std::scoped_lock lock{impl->context_mutex};
+    impl->key = key;
+    impl->ctr = ctr;
+    impl->context.SetKeyWithIV(key.data(), key.size(), ctr.data());
+}
+
+void CTRCipher::Process(u64 stream_offset, std::span<u8> data) {
+    if (data.empty()) {
+        return; // Crypto++ does not like zero size buffer
+    }
+
+    if (data.size() < ParallelThreshold) {
+        std::unique_lock lock{impl->context_mutex, std::try_to_lock};
+        if (lock.owns_lock()) {
+            impl->context.Seek(stream_offset);
+            impl->context.ProcessData(data.data(), data.data(), data.size());
+        } else {
+            ProcessWithNewContext(impl->key, impl->ctr, stream_offset, data);
+        }
+        return;
+    }
+
+    // Every chunk is processed with its own context, on the shared workers and this thread.
+    const std::size_t num_chunks = (data.size() + ParallelChunkSize - 1) / ParallelChunkSize;
+    Common::ParallelFor(num_chunks, [&](std::size_t i) {
+        const std::size_t chunk_offset = i * ParallelChunkSize;
+        const auto chunk =
+            data.subspan(chunk_offset, std::min(ParallelChunkSize, data.size() - chunk_offset));
+        ProcessWithNewContext(impl->key, impl->ctr, stream_offset + chunk_offset, chunk);
+    });
+}
+
+} // namespace HW::AES
@@ -0,0 +1,43 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <memory>
+#include <span>
+#include "common/common_types.h"
+#include "core/hw/aes/key.h"
+
+namespace HW::AES {
+
+/**
+ * AES-CTR cipher that is keyed once and can then process data at any offset of its key stream.
+ * CTR mode being symmetric, the same operation is used for both encryption and decryption.
+ * Large buffers are split in chunks that are processed in parallel.
+ */
+class CTRCipher {
+public:
+    CTRCipher();
+    CTRCipher(const AESKey& key, const AESIV& ctr);
+    ~CTRCipher();
+
+    CTRCipher(const CTRCipher&) = delete;
+    CTRCipher& operator=(const CTRCipher&) = delete;
+
+    /// Changes the key and initial counter used by the cipher. Must not race with Process.
+    void SetKey(const AESKey& key, const AESIV& ctr);
+
+    /**
+     * Encrypts or decrypts data in place. Safe to call from multiple threads at once.
+     * @param stream_offset Offset of the first byte of data in the key stream
+     * @param data The data to process
+     */
+    void Process(u64 stream_offset, std::span<u8> data);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+};
+
+} // namespace HW::AES
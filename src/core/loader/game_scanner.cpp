@@ -0,0 +1,374 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include "common/common_paths.h"
+#include "common/file_util.h"
+#include "common/logging/log.h"
+#include "core/hle/service/am/am.h"
+#include "core/hle/service/fs/archive.h"
+#include "core/hw/aes/key.h"
+#include "core/loader/game_scanner.h"
+#include "core/loader/smdh.h"
+
+namespace Loader {
+
+namespace {
+
+constexpr u32 IndexMagic = MakeMagic('C', 'G', 'L', 'I');
+constexpr u32 IndexVersion = 1;
+
+// Bounds checked while loading, so that a corrupted index is rejected instead of being trusted
+constexpr u32 MaxPathLength = 0x1000;
+constexpr u32 MaxSMDHSize = 0x10000;
+
+/// A new scanner can be created while a cancelled one is still saving its index
+std::mutex index_file_mutex;
+
+class IndexWriter {
+public:
+    template <typename T>
+    void Write(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const auto* bytes = reinterpret_cast<const u8*>(&value);
+        data.insert(data.end(), bytes, bytes + sizeof(T));
+    }
+
+    void WriteBytes(std::span<const u8> bytes) {
+        Write(static_cast<u32>(bytes.size()));
+        data.insert(data.end(), bytes.begin(), bytes.end());
+    }
+
+    void WriteString(const std::string& string) {
+        WriteBytes({reinterpret_cast<const u8*>(string.data()), string.size()});
+    }
+
+    std::vector<u8> data;
+};
+
+class IndexReader {
+public:
+    explicit IndexReader(std::span<const u8> data_) : data(data_) {}
+
+    template <typename T>
+    bool Read(T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (data.size() - position < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, data.data() + position, sizeof(T));
+        position += sizeof(T);
+        return true;
+    }
+
+    bool ReadBytes(std::vector<u8>& bytes, u32 max_size) {
+        u32 size;
+        if (!Read(size) || size > max_size || data.size() - position < size) {
+            return false;
+        }
+        bytes.assign(data.begin() + position, data.begin() + position + size);
+        position += size;
+        return true;
+    }
+
+    bool ReadString(std::string& string, u32 max_size) {
+        std::vector<u8> bytes;
+        if (!ReadBytes(bytes, max_size)) {
+            return false;
+        }
+        string.assign(bytes.begin(), bytes.end());
+        return true;
+    }
+
+private:
+    std::span<const u8> data;
+    std::size_t position = 0;
+};
+
+bool HasUpdate(u64 program_id) {
+    return !(program_id & ~0x00040000FFFFFFFF);
+}
+
+} // Anonymous namespace
+
+GameScanner::GameScanner(std::string index_path_, std::size_t num_threads_)
+    : index_path(std::move(index_path_)), num_threads(num_threads_) {
+    if (num_threads == 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    LoadIndex();
+}
+
+GameScanner::~GameScanner() = default;
+
+GameScanner::FileStamp GameScanner::GetStamp(const std::string& path) {
+    if (!FileUtil::Exists(path)) {
+        return {};
+    }
+    return {true, FileUtil::GetSize(path), FileUtil::GetModificationTime(path)};
+}
+
+void GameScanner::CollectFiles(const std::string& dir_path, unsigned int recursion,
+                               const Filter& filter, const std::atomic_bool& stop,
+                               std::vector<std::string>& files,
+                               std::vector<std::string>* watch_list) {
+    const auto callback = [&](u64*, const std::string& directory,
+                              const std::string& virtual_name) -> bool {
+        if (stop) {
+            // Breaks the callback loop.
+            return false;
+        }
+
+        const std::string physical_name = directory + DIR_SEP + virtual_name;
+        const bool is_dir = FileUtil::IsDirectory(physical_name);
+        if (!is_dir && filter(physical_name)) {
+            files.push_back(physical_name);
+        } else if (is_dir && recursion > 0) {
+            if (watch_list) {
+                watch_list->push_back(physical_name);
+            }
+            CollectFiles(physical_name, recursion - 1, filter, stop, files, watch_list);
+        }
+        return true;
+    };
+
+    FileUtil::ForeachDirectoryEntry(nullptr, dir_path, callback);
+}
+
+void GameScanner::Scan(const std::string& dir_path, unsigned int recursion, const Filter& filter,
+                       const Callback& callback, const std::atomic_bool& stop,
+                       std::vector<std::string>* watch_list) {
+    // Listing directories is cheap compared to opening the files, so it is done upfront.
+    std::vector<std::string> files;
+    CollectFiles(dir_path, recursion, filter, stop, files, watch_list);
+    stats.files += files.size();
+
+    // Loaders would otherwise race to initialize the keys of encrypted titles.
+    HW::AES::InitKeys();
+
+    std::vector<std::optional<IndexRecord>> records(files.size());
+    std::mutex records_mutex;
+    std::condition_variable records_cv;
+    std::atomic<std::size_t> next_file{0};
+
+    const auto worker = [&] {
+        std::size_t i;
+        while (!stop && (i = next_file++) < files.size()) {
+            auto record = ReadRecord(files[i], GetStamp(files[i]));
+            std::scoped_lock lock{records_mutex};
+            records[i] = std::move(record);
+            records_cv.notify_all();
+        }
+        // Wakes up the scanning thread when stopping
+        std::scoped_lock lock{records_mutex};
+        records_cv.notify_all();
+    };
+
+    std::vector<std::jthread> workers;
+    for (std::size_t i = 0; i < std::min(num_threads, files.size()); i++) {
+        workers.emplace_back(worker);
+    }
+
+    // Files are reported in directory order as they become ready, so that the game list does not
+    // depend on which file happened to be opened first.
+    for (std::size_t i = 0; i < files.size(); i++) {
+        std::unique_lock lock{records_mutex};
+        records_cv.wait(lock, [&] { return stop || records[i].has_value(); });
+        if (stop) {
+            break;
+        }
+        lock.unlock();
+
+        if (records[i]->is_game) {
+            callback(records[i]->entry);
+        }
+    }
+
+    workers.clear();
+    if (stop) {
+        std::scoped_lock lock{index_mutex};
+        stopped = true;
+    }
+}
+
+GameScanner::IndexRecord GameScanner::ReadRecord(const std::string& path,
+                                                 const FileStamp& stamp) {
+    std::optional<IndexRecord> cached;
+    {
+        std::scoped_lock lock{index_mutex};
+        seen.insert(path);
+        const auto it = index.find(path);
+        if (it != index.end() && it->second.stamp == stamp) {
+            cached = it->second;
+        }
+    }
+
+    if (cached) {
+        // The update may have been installed or changed independently of the game.
+        const auto update_stamp = cached->update_stamp;
+        RefreshUpdate(*cached, false);
+        if (cached->update_stamp != update_stamp) {
+            std::scoped_lock lock{index_mutex};
+            index[path] = *cached;
+        }
+        return *std::move(cached);
+    }
+
+    IndexRecord record;
+    record.stamp = stamp;
+    record.entry.path = path;
+    record.entry.size = stamp.size;
+
+    if (std::unique_ptr<AppLoader> loader = GetLoader(path)) {
+        bool executable = false;
+        const auto res = loader->IsExecutable(executable);
+        if (executable || res == ResultStatus::ErrorEncrypted) {
+            record.is_game = true;
+            loader->ReadProgramId(record.entry.program_id);
+            loader->ReadExtdataId(record.entry.extdata_id);
+            loader->ReadIcon(record.own_smdh);
+            record.entry.file_type = loader->GetFileType();
+            RefreshUpdate(record, true);
+        }
+    }
+
+    std::scoped_lock lock{index_mutex};
+    stats.opened++;
+    index[path] = record;
+    return record;
+}
+
+void GameScanner::RefreshUpdate(IndexRecord& record, bool force) {
+    if (record.is_game && HasUpdate(record.entry.program_id)) {
+        const std::string update_path = Service::AM::GetTitleContentPath(
+            Service::FS::MediaType::SDMC, record.entry.program_id | 0x0000000E00000000);
+        const auto update_stamp = GetStamp(update_path);
+        if (force || update_stamp != record.update_stamp) {
+            record.update_stamp = update_stamp;
+            record.update_smdh.clear();
+            if (update_stamp.exists) {
+                if (std::unique_ptr<AppLoader> update_loader = GetLoader(update_path)) {
+                    update_loader->ReadIcon(record.update_smdh);
+                }
+            }
+        }
+    }
+
+    // Prefer the update icon if there is a valid one
+    record.entry.smdh = IsValidSMDH(record.update_smdh) ? record.update_smdh : record.own_smdh;
+}
+
+void GameScanner::LoadIndex() {
+    if (index_path.empty()) {
+        return;
+    }
+
+    std::vector<u8> data;
+    {
+        std::scoped_lock lock{index_file_mutex};
+        FileUtil::IOFile file(index_path, "rb");
+        if (!file.IsOpen()) {
+            return;
+        }
+        data.resize(file.GetSize());
+        if (file.ReadBytes(data.data(), data.size()) != data.size()) {
+            LOG_WARNING(Loader, "Could not read game index {}", index_path);
+            return;
+        }
+    }
+
+    IndexReader reader(data);
+    u32 magic, version, count;
+    if (!reader.Read(magic) || !reader.Read(version) || !reader.Read(count) ||
+        magic != IndexMagic || version != IndexVersion) {
+        LOG_WARNING(Loader, "Ignoring game index {} of an unknown format", index_path);
+        return;
+    }
+
+    for (u32 i = 0; i < count; i++) {
+        IndexRecord record;
+        u8 is_game, update_exists;
+        u32 file_type;
+        if (!reader.ReadString(record.entry.path, MaxPathLength) || !reader.Read(is_game) ||
+            !reader.Read(record.stamp.size) || !reader.Read(record.stamp.mtime) ||
+            !reader.Read(record.entry.program_id) || !reader.Read(record.entry.extdata_id) ||
+            !reader.Read(file_type) || !reader.ReadBytes(record.own_smdh, MaxSMDHSize) ||
+            !reader.Read(update_exists) || !reader.Read(record.update_stamp.size) ||
+            !reader.Read(record.update_stamp.mtime) ||
+            !reader.ReadBytes(record.update_smdh, MaxSMDHSize)) {
+            LOG_WARNING(Loader, "Game index {} is truncated, ignoring it", index_path);
+            index.clear();
+            return;
+        }
+        record.stamp.exists = true;
+        record.is_game = is_game != 0;
+        record.entry.size = record.stamp.size;
+        record.entry.file_type = static_cast<FileType>(file_type);
+        record.update_stamp.exists = update_exists != 0;
+        record.entry.smdh =
+            IsValidSMDH(record.update_smdh) ? record.update_smdh : record.own_smdh;
+        index.emplace(record.entry.path, std::move(record));
+    }
+    LOG_INFO(Loader, "Loaded {} entries from the game index", index.size());
+}
+
+bool GameScanner::SaveIndex() {
+    if (index_path.empty()) {
+        return false;
+    }
+
+    IndexWriter writer;
+    {
+        std::scoped_lock lock{index_mutex};
+        std::vector<const IndexRecord*> records;
+        for (const auto& [path, record] : index) {
+            if (stopped || seen.contains(path)) {
+                records.push_back(&record);
+            }
+        }
+
+        writer.Write(IndexMagic);
+        writer.Write(IndexVersion);
+        writer.Write(static_cast<u32>(records.size()));
+        for (const IndexRecord* record : records) {
+            writer.WriteString(record->entry.path);
+            writer.Write(static_cast<u8>(record->is_game));
+            writer.Write(record->stamp.size);
+            writer.Write(record->stamp.mtime);
+            writer.Write(record->entry.program_id);
+            writer.Write(record->entry.extdata_id);
+            writer.Write(static_cast<u32>(record->entry.file_type));
+            writer.WriteBytes(record->own_smdh);
+            writer.Write(static_cast<u8>(record->update_stamp.exists));
+            writer.Write(record->update_stamp.size);
+            writer.Write(record->update_stamp.mtime);
+            writer.WriteBytes(record->update_smdh);
+        }
+    }
+
+    // Written next to the index first, so that a crash never leaves a half written index behind
+    std::scoped_lock lock{index_file_mutex};
+    const std::string temp_path = index_path + ".tmp";
+    {
+        FileUtil::IOFile file(temp_path, "wb");
+        if (!file.IsOpen() ||
+            file.WriteBytes(writer.data.data(), writer.data.size()) != writer.data.size()) {
+            LOG_ERROR(Loader, "Could not write game index {}", temp_path);
+            return false;
+        }
+    }
+    if (!FileUtil::RenameReplace(temp_path, index_path)) {
+        LOG_ERROR(Loader, "Could not replace game index {}", index_path);
+        return false;
+    }
+    return true;
+}
+
+} // namespace Loader
@@ -0,0 +1,123 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "common/common_types.h"
+#include "core/loader/loader.h"
+
+namespace Loader {
+
+/// Metadata of a bootable file found by the GameScanner
+struct GameEntry {
+    std::string path;
+    u64 size{};
+    u64 program_id{};
+    u64 extdata_id{};
+    FileType file_type{FileType::Unknown};
+    /// SMDH of the installed update if it has a valid one, otherwise the SMDH of the file itself
+    std::vector<u8> smdh;
+};
+
+/**
+ * Finds the bootable files of a directory tree and reads their metadata, opening several files in
+ * parallel. The metadata is kept in an index stored on disk and keyed by path, size and
+ * modification time, so that files which did not change are not opened again on the next scan.
+ */
+class GameScanner {
+public:
+    /// Decides whether a file name is worth opening
+    using Filter = std::function<bool(const std::string& path)>;
+
+    /// Called from the scanning thread for each game, in directory order
+    using Callback = std::function<void(const GameEntry& entry)>;
+
+    struct Stats {
+        std::size_t files{};  ///< Files that passed the filter
+        std::size_t opened{}; ///< Files whose metadata was not in the index
+    };
+
+    /**
+     * @param index_path Path of the index file, or an empty string not to store the index on disk
+     * @param num_threads Number of files opened in parallel, 0 for the number of host threads
+     */
+    explicit GameScanner(std::string index_path, std::size_t num_threads = 0);
+    ~GameScanner();
+
+    /**
+     * Scans a directory for games.
+     * @param dir_path Directory to scan
+     * @param recursion How many levels of subdirectories are scanned
+     * @param filter Decides which files are opened
+     * @param callback Called for each game found
+     * @param stop Stops the scan once set
+     * @param watch_list Receives the subdirectories that were scanned, if not null
+     */
+    void Scan(const std::string& dir_path, unsigned int recursion, const Filter& filter,
+              const Callback& callback, const std::atomic_bool& stop,
+              std::vector<std::string>* watch_list = nullptr);
+
+    /**
+     * Writes the index to disk. Files that were not seen by any scan since the scanner was created
+     * are dropped, unless a scan was stopped early.
+     */
+    bool SaveIndex();
+
+    Stats GetStats() const {
+        return stats;
+    }
+
+private:
+    struct FileStamp {
+        bool exists{};
+        u64 size{};
+        s64 mtime{};
+
+        bool operator==(const FileStamp&) const = default;
+    };
+
+    struct IndexRecord {
+        FileStamp stamp;
+        /// Whether the file should be listed. Files that are not games are kept in the index too.
+        bool is_game{};
+        GameEntry entry;
+        /// SMDH of the file itself, entry.smdh may come from an update
+        std::vector<u8> own_smdh;
+        FileStamp update_stamp;
+        std::vector<u8> update_smdh;
+    };
+
+    static FileStamp GetStamp(const std::string& path);
+
+    void CollectFiles(const std::string& dir_path, unsigned int recursion, const Filter& filter,
+                      const std::atomic_bool& stop, std::vector<std::string>& files,
+                      std::vector<std::string>* watch_list);
+
+    /// Reads the metadata of a file, reusing what the index has if it is still valid
+    IndexRecord ReadRecord(const std::string& path, const FileStamp& stamp);
+
+    /// Rereads the update SMDH of a record if the update changed since it was indexed, or if forced
+    void RefreshUpdate(IndexRecord& record, bool force);
+
+    void LoadIndex();
+
+    std::string index_path;
+    std::size_t num_threads;
+
+    std::mutex index_mutex;
+    std::unordered_map<std::string, IndexRecord> index;
+    std::unordered_set<std::string> seen;
+    bool stopped{};
+
+    Stats stats;
+};
+
+} // namespace Loader
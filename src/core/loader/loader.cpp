@@ -44,6 +44,14 @@ FileType IdentifyFile(const std::string& file_name) {
 FileType GuessFromExtension(const std::string& extension_) {
     std::string extension = Common::ToLower(extension_);
 
+    // Compressed images use the original extension prefixed with a 'z' (.zcia, .z3ds...)
+    if (extension.starts_with(".z") && extension != ".z") {
+        const FileType type = GuessFromExtension("." + extension.substr(2));
+        if (type != FileType::Unknown) {
+            return type;
+        }
+    }
+
     if (extension == ".elf" || extension == ".axf")
         return FileType::ELF;
 
@@ -2,8 +2,10 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <array>
 #include <cstring>
+#include <stdexcept>
 #include <boost/serialization/array.hpp>
 #include <boost/serialization/binary_object.hpp>
 #include "audio_core/dsp_interface.h"
@@ -30,6 +32,17 @@ SERIALIZE_EXPORT_IMPL(Memory::MemorySystem::BackingMemImpl<Memory::Region::N3DS>
 
 namespace Memory {
 
+bool IsZeroMemory(std::span<const u8> data) {
+    for (std::size_t offset = 0; offset < data.size(); offset += sizeof(u64)) {
+        u64 word;
+        std::memcpy(&word, data.data() + offset, sizeof(word));
+        if (word != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void PageTable::Clear() {
     pointers.raw.fill(nullptr);
     pointers.refs.fill(MemoryRef());
@@ -319,11 +332,16 @@ private:
     void serialize(Archive& ar, const unsigned int file_version) {
         bool save_n3ds_ram = Settings::values.is_new_3ds.GetValue();
         ar& save_n3ds_ram;
-        ar& boost::serialization::make_binary_object(vram.get(), Memory::VRAM_SIZE);
-        ar& boost::serialization::make_binary_object(
-            fcram.get(), save_n3ds_ram ? Memory::FCRAM_N3DS_SIZE : Memory::FCRAM_SIZE);
-        ar& boost::serialization::make_binary_object(
-            n3ds_extra_ram.get(), save_n3ds_ram ? Memory::N3DS_EXTRA_RAM_SIZE : 0);
+        // The contents of VRAM, FCRAM and the N3DS extra RAM are stored apart from the archive, as
+        // the memory groups of savestates or the pages of rewind snapshots. Version 0 is only read
+        // to load savestates from older builds, which hold them.
+        if (file_version == 0) {
+            ar& boost::serialization::make_binary_object(vram.get(), Memory::VRAM_SIZE);
+            ar& boost::serialization::make_binary_object(
+                fcram.get(), save_n3ds_ram ? Memory::FCRAM_N3DS_SIZE : Memory::FCRAM_SIZE);
+            ar& boost::serialization::make_binary_object(
+                n3ds_extra_ram.get(), save_n3ds_ram ? Memory::N3DS_EXTRA_RAM_SIZE : 0);
+        }
         ar& cache_marker;
         ar& page_table_list;
         // dsp is set from Core::System at startup
@@ -13,6 +13,7 @@
 #include "common/archives.h"
 #include "common/bit_field.h"
 #include "common/file_util.h"
+#include "common/hash.h"
 #include "common/logging/log.h"
 #include "common/scm_rev.h"
 #include "common/swap.h"
@@ -121,12 +122,46 @@ struct CTMHeader {
     u32_le rerecord_count;       /// Number of rerecords when making the movie
     u64_le input_count;          /// Number of inputs (button and pad states) when making the movie
     s64_le timing_base_ticks;    /// The base system tick count to initialize core timing with.
+    u32_le format_version;       /// Layout of the data following the header, see CTMFormat
 
-    std::array<u8, 156> reserved; /// Make heading 256 bytes so it has consistent size
+    std::array<u8, 152> reserved; /// Make heading 256 bytes so it has consistent size
 };
 static_assert(sizeof(CTMHeader) == 256, "CTMHeader should be 256 bytes");
 #pragma pack(pop)
 
+enum CTMFormat : u32 {
+    /// The header is followed by the controller states
+    Flat = 0,
+    /// The header is followed by blocks, written as the movie is recorded. A movie cut short by a
+    /// crash keeps every complete block, its header is only updated when it is saved.
+    Blocks = 1,
+};
+
+enum class CTMBlockType : u32 {
+    Input,    ///< Controller states
+    Keyframe, ///< CTMKeyframe followed by the file name of the savestate
+};
+
+#pragma pack(push, 1)
+struct CTMBlockHeader {
+    u32_le type;
+    u32_le size; ///< Size of the data following this header
+};
+static_assert(sizeof(CTMBlockHeader) == 8, "CTMBlockHeader should be 8 bytes");
+
+struct CTMKeyframe {
+    u64_le input_byte;
+    u64_le input_count;
+};
+static_assert(sizeof(CTMKeyframe) == 16, "CTMKeyframe should be 16 bytes");
+#pragma pack(pop)
+
+/// Input blocks are written once this many controller states are pending
+constexpr std::size_t InputBlockSize = 1024 * sizeof(ControllerState);
+
+/// Pad inputs between keyframes, about a minute of emulation
+constexpr u64 KeyframeInterval = 234 * 60;
+
 static u64 GetInputCount(std::span<const u8> input) {
     u64 input_count = 0;
     for (std::size_t pos = 0; pos < input.size(); pos += sizeof(ControllerState)) {
@@ -143,23 +178,124 @@ static u64 GetInputCount(std::span<const u8> input) {
     return input_count;
 }
 
+/// Adds a controller state to a hash of the input that precedes it.
+static u64 HashControllerState(u64 input_hash, const u8* state) {
+    return Common::HashCombine(input_hash, Common::ComputeHash64(state, sizeof(ControllerState)));
+}
+
+static u64 HashInput(std::span<const u8> input) {
+    u64 input_hash = 0;
+    for (std::size_t pos = 0; pos + sizeof(ControllerState) <= input.size();
+         pos += sizeof(ControllerState)) {
+        input_hash = HashControllerState(input_hash, input.data() + pos);
+    }
+    return input_hash;
+}
+
+/// Savestates of the keyframes are stored next to the movie, which refers to them by file name.
+static std::string GetKeyframeFileName(const std::string& movie_file, std::size_t index) {
+    const auto separator = movie_file.find_last_of("/\\");
+    const auto name = movie_file.substr(separator == std::string::npos ? 0 : separator + 1);
+    return fmt::format("{}.{:04d}.cst", name, index);
+}
+
+static std::string GetKeyframePath(const std::string& movie_file, const std::string& file_name) {
+    const auto separator = movie_file.find_last_of("/\\");
+    return separator == std::string::npos ? file_name
+                                          : movie_file.substr(0, separator + 1) + file_name;
+}
+
+/**
+ * Reads the blocks of a movie from the current position of the file. Blocks cut short are read up
+ * to the last complete controller state, so that a movie recorded until a crash can be played.
+ */
+static void ReadBlocks(FileUtil::IOFile& file, const std::string& movie_file,
+                       std::vector<u8>& input, std::vector<Movie::Keyframe>& keyframes) {
+    const u64 size = file.GetSize();
+    u64 offset = file.Tell();
+    CTMBlockHeader block;
+    while (offset + sizeof(block) <= size &&
+           file.ReadBytes(&block, sizeof(block)) == sizeof(block)) {
+        const u64 available = std::min<u64>(block.size, size - offset - sizeof(block));
+        if (available < block.size) {
+            LOG_WARNING(Movie, "Movie '{}' ends with an incomplete block", movie_file);
+        }
+
+        switch (static_cast<CTMBlockType>(static_cast<u32>(block.type))) {
+        case CTMBlockType::Input: {
+            const std::size_t states = available / sizeof(ControllerState);
+            const std::size_t start = input.size();
+            input.resize(start + states * sizeof(ControllerState));
+            file.ReadBytes(input.data() + start, states * sizeof(ControllerState));
+            break;
+        }
+        case CTMBlockType::Keyframe: {
+            CTMKeyframe keyframe;
+            if (available < sizeof(keyframe) ||
+                file.ReadBytes(&keyframe, sizeof(keyframe)) != sizeof(keyframe)) {
+                break;
+            }
+            std::string file_name(available - sizeof(keyframe), '\0');
+            file.ReadBytes(file_name.data(), file_name.size());
+            keyframes.push_back({keyframe.input_byte, keyframe.input_count,
+                                 GetKeyframePath(movie_file, file_name)});
+            break;
+        }
+        default:
+            LOG_WARNING(Movie, "Skipping unknown block {} in movie '{}'",
+                        static_cast<u32>(block.type), movie_file);
+            break;
+        }
+
+        offset += sizeof(block) + available;
+        file.Seek(static_cast<s64>(offset), SEEK_SET);
+    }
+
+    // Keyframes written after the last complete input are unusable
+    std::erase_if(keyframes,
+                  [&](const auto& keyframe) { return keyframe.input_byte > input.size(); });
+}
+
+/// Reads the input and keyframes of a movie, which may be in either format.
+static bool ReadMovie(const std::string& movie_file, CTMHeader& header, std::vector<u8>& input,
+                      std::vector<Movie::Keyframe>& keyframes) {
+    FileUtil::IOFile file(movie_file, "rb");
+    const u64 size = file.GetSize();
+    if (!file.IsGood() || size <= sizeof(CTMHeader) ||
+        file.ReadBytes(&header, sizeof(header)) != sizeof(header)) {
+        return false;
+    }
+
+    input.clear();
+    keyframes.clear();
+    if (header.format_version == CTMFormat::Flat) {
+        input.resize(size - sizeof(CTMHeader));
+        return file.ReadBytes(input.data(), input.size()) == input.size();
+    }
+    ReadBlocks(file, movie_file, input, keyframes);
+    return true;
+}
+
 Movie::Movie(const Core::System& system_) : system{system_} {}
 
 Movie::~Movie() = default;
 
 template <class Archive>
 void Movie::serialize(Archive& ar, const unsigned int file_version) {
-    // Only serialize what's needed to make savestates useful for TAS:
-    u64 _current_byte = static_cast<u64>(current_byte);
-    ar& _current_byte;
-    current_byte = static_cast<std::size_t>(_current_byte);
-    ar& current_input;
-
-    std::vector<u8> recorded_input_ = recorded_input;
-    ar& recorded_input_;
-
-    ar& init_time;
-    ar& base_ticks;
+    // Only serialize what's needed to make savestates useful for TAS. The input stays in the movie,
+    // a state only stores its position in it and the hash of the input up to there, which tells
+    // whether the movie is still on the timeline of the state when it is loaded.
+    u64 current_byte_ = static_cast<u64>(current_byte);
+    u64 current_input_ = current_input;
+    u64 input_hash_ = input_hash;
+    ar& current_byte_;
+    ar& current_input_;
+    ar& input_hash_;
+
+    u64 init_time_ = init_time;
+    s64 base_ticks_ = base_ticks;
+    ar& init_time_;
+    ar& base_ticks_;
 
     if (Archive::is_loading::value) {
         u64 savestate_movie_id;
@@ -179,36 +315,59 @@ void Movie::serialize(Archive& ar, const unsigned int file_version) {
     bool post_movie = play_mode == PlayMode::MovieFinished;
     ar& post_movie;
 
-    if (Archive::is_loading::value && id != 0) {
-        if (!read_only) {
-            recorded_input = std::move(recorded_input_);
-        }
+    if (!Archive::is_loading::value) {
+        return;
+    }
 
-        if (post_movie) {
-            play_mode = PlayMode::MovieFinished;
-            return;
+    // The recording is read back, its input was not kept in memory
+    const bool recording = id != 0 && play_mode == PlayMode::Recording;
+    std::vector<u8> recorded = recording ? ReadRecordedInput() : std::vector<u8>{};
+    const std::vector<u8>& input = recording ? recorded : recorded_input;
+
+    if (id != 0 && !post_movie) {
+        if (current_byte_ > input.size() || (read_only && current_byte_ == input.size())) {
+            throw std::runtime_error(read_only ? "Future event savestate not allowed in R/O mode"
+                                               : "Future event savestate not allowed in R/W mode");
+        }
+        // Ensure that the current movie and savestate movie are in the same timeline
+        if (HashInput(std::span{input}.first(current_byte_)) != input_hash_) {
+            throw std::runtime_error(read_only ? "Timeline mismatch not allowed in R/O mode"
+                                               : "Timeline mismatch not allowed in R/W mode");
         }
+    }
 
-        if (read_only) {
-            if (play_mode == PlayMode::Recording) {
-                SaveMovie();
-            }
-            if (recorded_input_.size() >= recorded_input.size()) {
-                throw std::runtime_error("Future event savestate not allowed in R/O mode");
-            }
-            // Ensure that the current movie and savestate movie are in the same timeline
-            if (std::mismatch(recorded_input_.begin(), recorded_input_.end(),
-                              recorded_input.begin())
-                    .first != recorded_input_.end()) {
-                throw std::runtime_error("Timeline mismatch not allowed in R/O mode");
-            }
+    if (recording) {
+        // Saved with the input count of the recording, before the position of the state applies
+        SaveMovie();
+        record_file.Close();
+    }
+    current_byte = static_cast<std::size_t>(current_byte_);
+    current_input = current_input_;
+    input_hash = input_hash_;
+    init_time = init_time_;
+    base_ticks = base_ticks_;
 
-            play_mode = PlayMode::Playing;
-            total_input = GetInputCount(recorded_input);
-        } else {
-            play_mode = PlayMode::Recording;
-            rerecord_count++;
+    if (id == 0) {
+        return;
+    }
+
+    if (post_movie) {
+        play_mode = PlayMode::MovieFinished;
+        return;
+    }
+
+    if (read_only) {
+        if (recording) {
+            recorded_input = std::move(recorded);
         }
+        play_mode = PlayMode::Playing;
+        total_input = GetInputCount(recorded_input);
+    } else {
+        // Rerecording rewrites the movie from the input of the state
+        play_mode = PlayMode::Recording;
+        rerecord_count++;
+        OpenRecordFile(std::span{input}.first(current_byte));
+        recorded_input.clear();
     }
 }
 
@@ -358,9 +517,13 @@ void Movie::Play(Service::IR::ExtraHIDResponse& extra_hid_response) {
 }
 
 void Movie::Record(const ControllerState& controller_state) {
-    recorded_input.resize(current_byte + sizeof(ControllerState));
-    std::memcpy(&recorded_input[current_byte], &controller_state, sizeof(ControllerState));
+    const auto bytes = reinterpret_cast<const u8*>(&controller_state);
+    input_hash = HashControllerState(input_hash, bytes);
+    pending_input.insert(pending_input.end(), bytes, bytes + sizeof(ControllerState));
     current_byte += sizeof(ControllerState);
+    if (pending_input.size() >= InputBlockSize) {
+        WritePendingInput();
+    }
 }
 
 void Movie::Record(const Service::HID::PadState& pad_state, const s16& circle_pad_x,
@@ -480,15 +643,40 @@ Movie::ValidationResult Movie::ValidateInput(std::span<const u8> input, u64 expe
                                                   : ValidationResult::InputCountDismatch;
 }
 
-void Movie::SaveMovie() {
-    LOG_INFO(Movie, "Saving recorded movie to '{}'", record_movie_file);
-    FileUtil::IOFile save_record(record_movie_file, "wb");
-
-    if (!save_record.IsGood()) {
-        LOG_ERROR(Movie, "Unable to open file to save movie");
-        return;
+bool Movie::OpenRecordFile(std::span<const u8> input) {
+    record_file = FileUtil::IOFile(record_movie_file, "w+b");
+    if (!record_file.IsGood()) {
+        LOG_ERROR(Movie, "Unable to open file to record movie");
+        return false;
     }
+    WriteHeader();
+
+    // Keyframes made after the input are out of the timeline, their savestates are replaced as new
+    // keyframes are made.
+    const auto first_removed =
+        std::find_if(keyframes.begin(), keyframes.end(),
+                     [&](const auto& keyframe) { return keyframe.input_byte > input.size(); });
+    for (auto it = first_removed; it != keyframes.end(); ++it) {
+        FileUtil::Delete(it->state_file);
+    }
+    keyframes.erase(first_removed, keyframes.end());
+
+    std::size_t written = 0;
+    for (auto& keyframe : keyframes) {
+        pending_input.assign(input.begin() + written, input.begin() + keyframe.input_byte);
+        WritePendingInput();
+        WriteKeyframe(keyframe);
+        written = keyframe.input_byte;
+    }
+    pending_input.assign(input.begin() + written, input.end());
+    WritePendingInput();
+
+    next_keyframe_input =
+        (keyframes.empty() ? 0 : keyframes.back().input_count) + KeyframeInterval;
+    return record_file.IsGood();
+}
 
+void Movie::WriteHeader() {
     CTMHeader header = {};
     header.filetype = header_magic_bytes;
     header.program_id = program_id;
@@ -500,33 +688,113 @@ void Movie::SaveMovie() {
                 std::min(header.author.size(), record_movie_author.size()));
 
     header.rerecord_count = rerecord_count;
-    header.input_count = GetInputCount(recorded_input);
+    header.input_count = current_input;
+    header.format_version = CTMFormat::Blocks;
 
     std::string rev_bytes;
     CryptoPP::StringSource(Common::g_scm_rev, true,
                            new CryptoPP::HexDecoder(new CryptoPP::StringSink(rev_bytes)));
     std::memcpy(header.revision.data(), rev_bytes.data(), sizeof(CTMHeader::revision));
 
-    save_record.WriteBytes(&header, sizeof(CTMHeader));
-    save_record.WriteBytes(recorded_input.data(), recorded_input.size());
+    const u64 end = record_file.Tell();
+    record_file.Seek(0, SEEK_SET);
+    record_file.WriteBytes(&header, sizeof(CTMHeader));
+    if (end > sizeof(CTMHeader)) {
+        record_file.Seek(static_cast<s64>(end), SEEK_SET);
+    }
+}
+
+void Movie::BeginBlock(CTMBlockType type, std::size_t size) {
+    const CTMBlockHeader block{static_cast<u32>(type), static_cast<u32>(size)};
+    record_file.WriteBytes(&block, sizeof(block));
+}
+
+void Movie::WritePendingInput() {
+    if (pending_input.empty()) {
+        return;
+    }
+    BeginBlock(CTMBlockType::Input, pending_input.size());
+    record_file.WriteBytes(pending_input.data(), pending_input.size());
+    pending_input.clear();
+}
+
+void Movie::WriteKeyframe(const Keyframe& keyframe) {
+    const auto separator = keyframe.state_file.find_last_of("/\\");
+    const auto file_name = keyframe.state_file.substr(
+        separator == std::string::npos ? 0 : separator + 1);
+
+    const CTMKeyframe data{keyframe.input_byte, keyframe.input_count};
+    BeginBlock(CTMBlockType::Keyframe, sizeof(data) + file_name.size());
+    record_file.WriteBytes(&data, sizeof(data));
+    record_file.WriteBytes(file_name.data(), file_name.size());
+}
+
+std::vector<u8> Movie::ReadRecordedInput() {
+    std::vector<u8> input;
+    std::vector<Keyframe> unused_keyframes;
+    input.reserve(current_byte);
+    const u64 end = record_file.Tell();
+    record_file.Seek(sizeof(CTMHeader), SEEK_SET);
+    ReadBlocks(record_file, record_movie_file, input, unused_keyframes);
+    record_file.Seek(static_cast<s64>(end), SEEK_SET);
+
+    input.insert(input.end(), pending_input.begin(), pending_input.end());
+    return input;
+}
+
+void Movie::SaveMovie() {
+    LOG_INFO(Movie, "Saving recorded movie to '{}'", record_movie_file);
+    if (!record_file.IsOpen()) {
+        LOG_ERROR(Movie, "Unable to open file to save movie");
+        return;
+    }
+
+    WritePendingInput();
+    WriteHeader();
+    record_file.Flush();
 
-    if (!save_record.IsGood()) {
+    if (!record_file.IsGood()) {
         LOG_ERROR(Movie, "Error saving movie");
     }
 }
 
+void Movie::UpdateKeyframes() {
+    if (play_mode != PlayMode::Recording || current_input < next_keyframe_input ||
+        !record_file.IsOpen()) {
+        return;
+    }
+    next_keyframe_input = current_input + KeyframeInterval;
+
+    Keyframe keyframe{current_byte, current_input, ""};
+    keyframe.state_file = GetKeyframePath(
+        record_movie_file, GetKeyframeFileName(record_movie_file, keyframes.size()));
+    system.SaveState(keyframe.state_file);
+
+    WritePendingInput();
+    WriteKeyframe(keyframe);
+    keyframes.push_back(std::move(keyframe));
+    LOG_INFO(Movie, "Saved keyframe {} at input {}", keyframes.size() - 1, current_input);
+}
+
+std::string Movie::GetKeyframeState(u64 frame) const {
+    if (play_mode != PlayMode::Playing && play_mode != PlayMode::MovieFinished) {
+        return {};
+    }
+    const u64 input_count = static_cast<u64>(frame * 234.0 / SCREEN_REFRESH_RATE);
+    const auto it =
+        std::find_if(keyframes.rbegin(), keyframes.rend(),
+                     [&](const auto& keyframe) { return keyframe.input_count <= input_count; });
+    return it == keyframes.rend() ? std::string{} : it->state_file;
+}
+
 void Movie::SetPlaybackCompletionCallback(std::function<void()> completion_callback) {
     playback_completion_callback = completion_callback;
 }
 
 void Movie::StartPlayback(const std::string& movie_file) {
     LOG_INFO(Movie, "Loading Movie for playback");
-    FileUtil::IOFile save_record(movie_file, "rb");
-    const u64 size = save_record.GetSize();
-
-    if (save_record.IsGood() && size > sizeof(CTMHeader)) {
-        CTMHeader header;
-        save_record.ReadArray(&header, 1);
+    CTMHeader header;
+    if (ReadMovie(movie_file, header, recorded_input, keyframes)) {
         if (ValidateHeader(header) != ValidationResult::Invalid) {
             play_mode = PlayMode::Playing;
             record_movie_file = movie_file;
@@ -536,13 +804,13 @@ void Movie::StartPlayback(const std::string& movie_file) {
             record_movie_author = author.data();
 
             rerecord_count = header.rerecord_count;
-            total_input = header.input_count;
-
-            recorded_input.resize(size - sizeof(CTMHeader));
-            save_record.ReadArray(recorded_input.data(), recorded_input.size());
+            // Movies that were not saved have no input count in their header
+            total_input = header.input_count ? static_cast<u64>(header.input_count)
+                                             : GetInputCount(recorded_input);
 
             current_byte = 0;
             current_input = 0;
+            input_hash = 0;
             id = header.id;
             program_id = header.program_id;
 
@@ -565,7 +833,15 @@ void Movie::StartRecording(const std::string& movie_file, const std::string& aut
 
     // Get program ID
     program_id = 0;
-    system.GetAppLoader().ReadProgramId(program_id);
+    if (system.IsPoweredOn()) {
+        system.GetAppLoader().ReadProgramId(program_id);
+    }
+
+    current_byte = 0;
+    current_input = 0;
+    input_hash = 0;
+    keyframes.clear();
+    OpenRecordFile({});
 
     LOG_INFO(Movie, "Enabling Movie recording, ID: {:016X}", id);
 }
@@ -620,17 +896,11 @@ void Movie::PrepareForRecording() {
 Movie::ValidationResult Movie::ValidateMovie(const std::string& movie_file) const {
     LOG_INFO(Movie, "Validating Movie file '{}'", movie_file);
 
-    FileUtil::IOFile save_record(movie_file, "rb");
-    const u64 size = save_record.GetSize();
-
-    if (!save_record || size <= sizeof(CTMHeader)) {
-        return ValidationResult::Invalid;
-    }
-
     CTMHeader header;
-    save_record.ReadArray(&header, 1);
-
-    if (header_magic_bytes != header.filetype) {
+    std::vector<u8> input;
+    std::vector<Keyframe> movie_keyframes;
+    if (!ReadMovie(movie_file, header, input, movie_keyframes) ||
+        header_magic_bytes != header.filetype) {
         return ValidationResult::Invalid;
     }
 
@@ -639,12 +909,10 @@ Movie::ValidationResult Movie::ValidateMovie(const std::string& movie_file) cons
         return result;
     }
 
-    if (!header.input_count) { // Probably created by an older version.
+    if (!header.input_count) { // Probably created by an older version, or not saved.
         return ValidationResult::OK;
     }
 
-    std::vector<u8> input(size - sizeof(header));
-    save_record.ReadArray(input.data(), input.size());
     return ValidateInput(input, header.input_count);
 }
 
@@ -667,9 +935,13 @@ void Movie::Shutdown() {
 
     play_mode = PlayMode::None;
     recorded_input.resize(0);
+    record_file.Close();
+    pending_input.clear();
+    keyframes.clear();
     record_movie_file.clear();
     current_byte = 0;
     current_input = 0;
+    input_hash = 0;
     init_time = 0;
     base_ticks = -1;
     id = 0;
@@ -679,6 +951,7 @@ template <typename... Targs>
 void Movie::Handle(Targs&... Fargs) {
     if (play_mode == PlayMode::Playing) {
         ASSERT(current_byte + sizeof(ControllerState) <= recorded_input.size());
+        input_hash = HashControllerState(input_hash, recorded_input.data() + current_byte);
         Play(Fargs...);
         CheckInputEnd();
     } else if (play_mode == PlayMode::Recording) {
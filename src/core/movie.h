@@ -6,8 +6,11 @@
 
 #include <functional>
 #include <span>
+#include <string>
+#include <vector>
 #include <boost/serialization/vector.hpp>
 #include "common/common_types.h"
+#include "common/file_util.h"
 
 namespace Service {
 namespace HID {
@@ -27,6 +30,7 @@ namespace Core {
 class System;
 struct CTMHeader;
 struct ControllerState;
+enum class CTMBlockType : u32;
 
 class Movie {
 public:
@@ -44,6 +48,13 @@ public:
         Invalid,
     };
 
+    /// Point of a movie at which a savestate was made while recording
+    struct Keyframe {
+        u64 input_byte;         ///< Offset of the keyframe in the recorded input
+        u64 input_count;        ///< Number of inputs (button and pad states) before the keyframe
+        std::string state_file; ///< Path of the savestate
+    };
+
     explicit Movie(const Core::System& system);
     ~Movie();
 
@@ -85,6 +96,19 @@ public:
     };
     MovieMetadata GetMovieMetadata(const std::string& movie_file) const;
 
+    /**
+     * Gets the savestate of the last keyframe at or before a frame of the movie being played, or
+     * an empty string if there is none. Loading it seeks the playback to the keyframe, in R/W mode
+     * it starts rerecording from there like loading any other state.
+     */
+    std::string GetKeyframeState(u64 frame) const;
+
+    /**
+     * Saves a keyframe when recording and enough inputs were recorded since the previous one.
+     * Called by the system between run loop slices, where savestates can be made.
+     */
+    void UpdateKeyframes();
+
     /// Get the current movie's unique ID. Used to provide separate savestate slots for movies.
     u64 GetCurrentMovieID() const {
         return id;
@@ -164,6 +188,19 @@ private:
     ValidationResult ValidateHeader(const CTMHeader& header) const;
     ValidationResult ValidateInput(std::span<const u8> input, u64 expected_count) const;
 
+    /// Creates the movie file with the given input and the keyframes within it.
+    bool OpenRecordFile(std::span<const u8> input);
+    /// Writes the header at the start of the movie file.
+    void WriteHeader();
+    /// Starts a block at the end of the movie file.
+    void BeginBlock(CTMBlockType type, std::size_t size);
+    /// Appends the pending input to the movie file.
+    void WritePendingInput();
+    /// Appends a keyframe block to the movie file.
+    void WriteKeyframe(const Keyframe& keyframe);
+    /// Reads back the input recorded so far, without writing the pending input.
+    std::vector<u8> ReadRecordedInput();
+
 private:
     const Core::System& system;
     PlayMode play_mode;
@@ -174,12 +211,21 @@ private:
     u64 init_time;       // Clock init time override for RNG consistency
     s64 base_ticks = -1; // Core timing base system ticks override for RNG consistency
 
+    // Input of the movie being played. Recorded input is streamed to record_file instead.
     std::vector<u8> recorded_input;
     std::size_t current_byte = 0;
     u64 current_input = 0;
+    // Hash of the input before current_byte
+    u64 input_hash = 0;
     // Total input count of the current movie being played. Not used for recording.
     u64 total_input = 0;
 
+    FileUtil::IOFile record_file;
+    // Recorded input not yet written to record_file
+    std::vector<u8> pending_input;
+    std::vector<Keyframe> keyframes;
+    u64 next_keyframe_input = 0;
+
     u64 id = 0; // ID of the current movie loaded
     u64 program_id = 0;
     u32 rerecord_count = 1;
@@ -12,8 +12,10 @@
 #include <fmt/chrono.h>
 #include <fmt/format.h>
 #include "common/file_util.h"
+#include "common/host_io.h"
 #include "common/settings.h"
 #include "core/core_timing.h"
+#include "core/hle/kernel/async_executor.h"
 #include "core/perf_stats.h"
 #include "video_core/gpu.h"
 
@@ -67,6 +69,14 @@ void PerfStats::EndSystemFrame() {
 
     previous_frame_length = frame_end - previous_frame_end;
     previous_frame_end = frame_end;
+
+    const auto totals = Common::PerfCounters::GetTotals();
+    for (std::size_t i = 0; i < totals.size(); i++) {
+        last_frame_counters.values[i] = totals[i] - previous_frame_totals[i];
+        accumulated_counters[i] += last_frame_counters.values[i];
+    }
+    last_frame_counters.frame++;
+    previous_frame_totals = totals;
 }
 
 void PerfStats::EndGameFrame() {
@@ -102,12 +112,33 @@ PerfStats::Results PerfStats::GetAndResetStats(microseconds current_system_time_
                            static_cast<double>(system_frames);
     last_stats.emulation_speed = system_us_per_second.count() / 1'000'000.0;
 
+    const auto io_stats = Common::HostIOEngine::TakeStats();
+    last_stats.io_read_latency =
+        io_stats.completed == 0 ? 0.0
+                                : static_cast<double>(io_stats.total_latency_us) /
+                                      static_cast<double>(io_stats.completed) / 1'000'000.0;
+    last_stats.io_queue_depth = io_stats.max_queue_depth;
+
+    const auto async_stats = Kernel::AsyncExecutor::TakeStats();
+    last_stats.hle_async_wait =
+        async_stats.completed == 0 ? 0.0
+                                   : static_cast<double>(async_stats.total_wait_us) /
+                                         static_cast<double>(async_stats.completed) / 1'000'000.0;
+    last_stats.hle_async_queue_depth = async_stats.max_queue_depth;
+
+    for (std::size_t i = 0; i < accumulated_counters.size(); i++) {
+        last_stats.counters[i] = system_frames == 0 ? 0.0
+                                                    : static_cast<double>(accumulated_counters[i]) /
+                                                          static_cast<double>(system_frames);
+    }
+
     // Reset counters
     reset_point = now;
     reset_point_system_us = current_system_time_us;
     accumulated_frametime = Clock::duration::zero();
     system_frames = 0;
     game_frames = 0;
+    accumulated_counters = {};
 
     return last_stats;
 }
@@ -118,6 +149,12 @@ PerfStats::Results PerfStats::GetLastStats() {
     return last_stats;
 }
 
+PerfStats::FrameCounters PerfStats::GetLastFrameCounters() const {
+    std::scoped_lock lock{object_mutex};
+
+    return last_frame_counters;
+}
+
 double PerfStats::GetLastFrameTimeScale() const {
     std::scoped_lock lock{object_mutex};
 
@@ -144,6 +181,14 @@ void FrameLimiter::DoFrameLimiting(microseconds current_system_time_us) {
     auto now = Clock::now();
     double sleep_scale = Settings::values.frame_limit.GetValue() / 100.0;
 
+    if (turbo_enabled) {
+        // Keep the reference points current so that limiting resumes smoothly after turbo mode
+        previous_system_time_us = current_system_time_us;
+        previous_walltime = now;
+        frame_limiting_delta_err = microseconds::zero();
+        return;
+    }
+
     if (Settings::values.frame_limit.GetValue() == 0) {
         return;
     }
@@ -187,4 +232,12 @@ void FrameLimiter::AdvanceFrame() {
     frame_advance_event.Set();
 }
 
+bool FrameLimiter::IsTurbo() const {
+    return turbo_enabled;
+}
+
+void FrameLimiter::SetTurbo(bool value) {
+    turbo_enabled = value;
+}
+
 } // namespace Core
@@ -10,6 +10,7 @@
 #include <cstddef>
 #include <mutex>
 #include "common/common_types.h"
+#include "common/perf_counters.h"
 #include "common/thread.h"
 
 namespace Core {
@@ -34,6 +35,24 @@ public:
         double frametime;
         /// Ratio of walltime / emulated time elapsed
         double emulation_speed;
+        /// Mean latency of the completed host I/O operations, in seconds
+        double io_read_latency;
+        /// Highest number of host I/O operations in flight
+        u32 io_queue_depth;
+        /// Mean time the async sections of HLE requests waited for a thread, in seconds
+        double hle_async_wait;
+        /// Highest number of async sections of HLE requests queued or running
+        u32 hle_async_queue_depth;
+        /// Value of each Common::PerfCounters counter per system frame, averaged since the last
+        /// reset
+        std::array<double, Common::PerfCounters::NumCounters> counters;
+    };
+
+    struct FrameCounters {
+        /// Number of system frames completed
+        u64 frame;
+        /// Value of each Common::PerfCounters counter during the last completed system frame
+        Common::PerfCounters::Values values;
     };
 
     void BeginSystemFrame();
@@ -44,6 +63,8 @@ public:
 
     Results GetLastStats();
 
+    FrameCounters GetLastFrameCounters() const;
+
     /**
      * Returns the arithmetic mean of all frametime values stored in the performance history.
      */
@@ -85,6 +106,13 @@ private:
     /// Total visible duration (including frame-limiting, etc.) of the previous system frame
     Clock::duration previous_frame_length = Clock::duration::zero();
 
+    /// Counter totals when the previous system frame ended
+    Common::PerfCounters::Values previous_frame_totals = Common::PerfCounters::GetTotals();
+    /// Cumulative counters of the system frames since last reset
+    Common::PerfCounters::Values accumulated_counters{};
+    /// Counters of the last completed system frame
+    FrameCounters last_frame_counters{};
+
     /// Last recorded performance statistics.
     Results last_stats;
 };
@@ -105,6 +133,13 @@ public:
     void AdvanceFrame();
     void WaitOnce();
 
+    bool IsTurbo() const;
+    /**
+     * Sets whether turbo mode is enabled or not. In turbo mode every frame is still emulated, but
+     * frames are not limited, only some of them are presented and audio output is muted.
+     */
+    void SetTurbo(bool value);
+
 private:
     /// Emulated system time (in microseconds) at the last limiter invocation
     std::chrono::microseconds previous_system_time_us{0};
@@ -117,6 +152,9 @@ private:
     /// Whether to use frame advancing (i.e. frame by frame)
     std::atomic_bool frame_advancing_enabled;
 
+    /// Whether to run in turbo mode
+    std::atomic_bool turbo_enabled;
+
     /// Event to advance the frame when frame advancing is enabled
     Common::Event frame_advance_event;
 };
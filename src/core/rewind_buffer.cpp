@@ -0,0 +1,288 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/stream.hpp>
+#include "common/archives.h"
+#include "common/hash.h"
+#include "common/logging/log.h"
+#include "common/settings.h"
+#include "common/worker_pool.h"
+#include "common/zstd_compression.h"
+#include "core/core.h"
+#include "core/core_timing.h"
+#include "core/memory.h"
+#include "core/rewind_buffer.h"
+
+namespace Core {
+
+using Memory::CITRA_PAGE_SIZE;
+
+// The system state is compressed on the emulation thread, so favor speed over size.
+constexpr s32 StateCompressionLevel = 1;
+
+// Pages hashed or copied by a single worker task
+constexpr std::size_t PagesPerRange = 1024;
+
+template <typename Func>
+void MemorySnapshots::ForEachRange(std::size_t num_pages, Func&& func) {
+    const std::size_t num_ranges = (num_pages + PagesPerRange - 1) / PagesPerRange;
+    Common::ParallelFor(num_ranges, [&](std::size_t range) {
+        const std::size_t first = range * PagesPerRange;
+        func(first, std::min(first + PagesPerRange, num_pages));
+    });
+}
+
+bool MemorySnapshots::Take(Regions regions) {
+    const auto pages = GetPages(regions);
+    // The first snapshot, or one following a change of the memory layout, stores every page.
+    const bool full = snapshots.empty() || page_hashes.size() != pages.size();
+    if (full) {
+        page_hashes.assign(pages.size(), 0);
+    }
+
+    // Every range collects its own pages, they are merged once all of them are done.
+    std::vector<std::vector<std::pair<u32, Page>>> changed((pages.size() + PagesPerRange - 1) /
+                                                           PagesPerRange);
+    ForEachRange(pages.size(), [&](std::size_t first, std::size_t end) {
+        auto& range_pages = changed[first / PagesPerRange];
+        for (std::size_t page = first; page < end; page++) {
+            const u8* data = pages[page];
+            const u64 hash = Common::ComputeHash64(data, CITRA_PAGE_SIZE);
+            if (!full && hash == page_hashes[page]) {
+                continue;
+            }
+            page_hashes[page] = hash;
+
+            const bool is_zero = Memory::IsZeroMemory({data, CITRA_PAGE_SIZE});
+            if (full && is_zero) {
+                continue;
+            }
+            Page contents;
+            if (!is_zero) {
+                contents = std::make_unique<u8[]>(CITRA_PAGE_SIZE);
+                std::memcpy(contents.get(), data, CITRA_PAGE_SIZE);
+            }
+            range_pages.emplace_back(static_cast<u32>(page), std::move(contents));
+        }
+    });
+
+    Snapshot snapshot;
+    for (auto& range_pages : changed) {
+        for (auto& [page, contents] : range_pages) {
+            snapshot.emplace(page, std::move(contents));
+        }
+    }
+
+    const bool dropped = full && !snapshots.empty();
+    if (full) {
+        // Older snapshots cannot be completed by this one.
+        snapshots.clear();
+    }
+    snapshots.push_back(std::move(snapshot));
+    return dropped;
+}
+
+void MemorySnapshots::Restore(std::size_t index, Regions regions) {
+    if (index >= snapshots.size()) {
+        throw std::runtime_error("Invalid rewind snapshot");
+    }
+    snapshots.erase(snapshots.begin() + index + 1, snapshots.end());
+    const auto pages = GetPages(regions);
+
+    // Each page comes from the newest snapshot that has it, pages no snapshot has are zero.
+    std::vector<const Page*> sources(pages.size());
+    for (auto it = snapshots.rbegin(); it != snapshots.rend(); ++it) {
+        for (const auto& [page, data] : *it) {
+            if (page < sources.size() && !sources[page]) {
+                sources[page] = &data;
+            }
+        }
+    }
+
+    page_hashes.resize(pages.size());
+    ForEachRange(pages.size(), [&](std::size_t first, std::size_t end) {
+        for (std::size_t page = first; page < end; page++) {
+            const Page* source = sources[page];
+            if (source && *source) {
+                std::memcpy(pages[page], source->get(), CITRA_PAGE_SIZE);
+            } else {
+                std::memset(pages[page], 0, CITRA_PAGE_SIZE);
+            }
+            page_hashes[page] = Common::ComputeHash64(pages[page], CITRA_PAGE_SIZE);
+        }
+    });
+}
+
+void MemorySnapshots::DropOldest() {
+    // The pages of the oldest snapshot that the next one does not have still describe the next
+    // one's state, and that snapshot becomes the one holding every page.
+    auto oldest = std::move(snapshots.front());
+    snapshots.pop_front();
+    if (snapshots.empty()) {
+        page_hashes.clear();
+        return;
+    }
+    auto& next = snapshots.front();
+    for (auto& [page, data] : oldest) {
+        next.try_emplace(page, std::move(data));
+    }
+    std::erase_if(next, [](const auto& entry) { return entry.second == nullptr; });
+}
+
+void MemorySnapshots::Clear() {
+    snapshots.clear();
+    page_hashes.clear();
+}
+
+std::size_t MemorySnapshots::GetMemoryUsage() const {
+    std::size_t usage = 0;
+    for (const auto& snapshot : snapshots) {
+        for (const auto& [page, data] : snapshot) {
+            usage += data ? CITRA_PAGE_SIZE : 0;
+        }
+    }
+    return usage;
+}
+
+std::vector<u8*> MemorySnapshots::GetPages(Regions regions) {
+    std::vector<u8*> pages;
+    for (const auto region : regions) {
+        for (std::size_t offset = 0; offset + CITRA_PAGE_SIZE <= region.size();
+             offset += CITRA_PAGE_SIZE) {
+            pages.push_back(region.data() + offset);
+        }
+    }
+    return pages;
+}
+
+RewindBuffer::RewindBuffer(System& system_, std::size_t capacity_, u64 interval_ticks_)
+    : system{system_}, capacity{std::max<std::size_t>(capacity_, 1)},
+      interval_ticks{interval_ticks_} {}
+
+RewindBuffer::~RewindBuffer() = default;
+
+void RewindBuffer::Update() {
+    if (system.CoreTiming().GetGlobalTicks() < next_snapshot_ticks) {
+        return;
+    }
+    TakeSnapshot();
+}
+
+void RewindBuffer::TakeSnapshot() {
+    Snapshot snapshot;
+    snapshot.ticks = system.CoreTiming().GetGlobalTicks();
+    next_snapshot_ticks = snapshot.ticks + interval_ticks;
+
+    state_buffer.clear();
+    {
+        boost::iostreams::stream<boost::iostreams::back_insert_device<std::vector<char>>> stream{
+            state_buffer};
+        {
+            oarchive oa{stream};
+            oa& system;
+        }
+        stream.flush();
+    }
+    snapshot.state = Common::Compression::CompressDataZSTD(
+        std::span{reinterpret_cast<const u8*>(state_buffer.data()), state_buffer.size()},
+        StateCompressionLevel);
+    if (snapshot.state.empty()) {
+        LOG_ERROR(Core, "Could not compress rewind snapshot");
+        return;
+    }
+
+    if (snapshots.size() == capacity) {
+        snapshots.pop_front();
+        memory.DropOldest();
+    }
+    // Serializing flushed the rasterizer, so memory is up to date.
+    if (memory.Take(GetRegions())) {
+        snapshots.clear();
+    }
+    snapshots.push_back(std::move(snapshot));
+}
+
+void RewindBuffer::Restore(std::size_t index) {
+    if (index >= snapshots.size()) {
+        throw std::runtime_error("Invalid rewind snapshot");
+    }
+    snapshots.erase(snapshots.begin() + index + 1, snapshots.end());
+    const auto& snapshot = snapshots.back();
+
+    const auto state = Common::Compression::DecompressDataZSTD(snapshot.state);
+    if (state.empty()) {
+        throw std::runtime_error("Could not decompress rewind snapshot");
+    }
+    {
+        boost::iostreams::stream<boost::iostreams::array_source> stream{
+            reinterpret_cast<const char*>(state.data()), state.size()};
+        iarchive ia{stream};
+        try {
+            ia& system;
+        } catch (...) {
+            // The memory snapshots no longer match the system states.
+            Clear();
+            throw;
+        }
+    }
+
+    // Deserializing recreated the memory system, so the regions are only looked up now.
+    memory.Restore(index, GetRegions());
+    next_snapshot_ticks = snapshot.ticks + interval_ticks;
+}
+
+void RewindBuffer::Rewind(u64 ticks) {
+    if (snapshots.empty()) {
+        throw std::runtime_error("No rewind snapshot");
+    }
+    const u64 now = system.CoreTiming().GetGlobalTicks();
+    std::size_t index = snapshots.size() - 1;
+    while (index > 0 && snapshots[index].ticks + ticks > now) {
+        index--;
+    }
+    Restore(index);
+}
+
+void RewindBuffer::Clear() {
+    snapshots.clear();
+    memory.Clear();
+    next_snapshot_ticks = 0;
+}
+
+std::vector<RewindBuffer::SnapshotInfo> RewindBuffer::GetSnapshots() const {
+    std::vector<SnapshotInfo> info;
+    info.reserve(snapshots.size());
+    for (std::size_t i = 0; i < snapshots.size(); i++) {
+        info.push_back({snapshots[i].ticks, snapshots[i].state.size(), memory.GetNumPages(i)});
+    }
+    return info;
+}
+
+std::size_t RewindBuffer::GetMemoryUsage() const {
+    std::size_t usage = memory.GetMemoryUsage();
+    for (const auto& snapshot : snapshots) {
+        usage += snapshot.state.size();
+    }
+    return usage;
+}
+
+std::vector<std::span<u8>> RewindBuffer::GetRegions() const {
+    // Same sizes as the ones savestates store
+    const bool is_new_3ds = Settings::values.is_new_3ds.GetValue();
+    auto& system_memory = system.Memory();
+    return {
+        {system_memory.GetPhysicalPointer(Memory::VRAM_PADDR), Memory::VRAM_SIZE},
+        {system_memory.GetFCRAMPointer(0),
+         is_new_3ds ? Memory::FCRAM_N3DS_SIZE : Memory::FCRAM_SIZE},
+        {system_memory.GetPhysicalPointer(Memory::N3DS_EXTRA_RAM_PADDR),
+         is_new_3ds ? Memory::N3DS_EXTRA_RAM_SIZE : 0},
+    };
+}
+
+} // namespace Core
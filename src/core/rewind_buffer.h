@@ -0,0 +1,156 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <vector>
+#include "common/common_types.h"
+
+namespace Core {
+
+class System;
+
+/**
+ * Stores successive snapshots of a set of memory regions, each one holding only the pages that
+ * changed since the previous snapshot. Changes are found by hashing every page: writes from the
+ * JIT do not go through the memory system, so there is no dirty page tracking to rely on. Pages
+ * are hashed and copied by worker threads, in ranges the size of a few megabytes.
+ */
+class MemorySnapshots {
+public:
+    using Regions = std::span<const std::span<u8>>;
+
+    /**
+     * Adds a snapshot of the regions. When their layout changed since the newest snapshot, the
+     * older snapshots cannot be completed by the new one and are dropped.
+     * @returns true if the older snapshots were dropped
+     */
+    bool Take(Regions regions);
+
+    /**
+     * Brings the regions back to a snapshot and drops the snapshots taken after it.
+     * @param index Index of the snapshot, 0 being the oldest one
+     */
+    void Restore(std::size_t index, Regions regions);
+
+    /// Drops the oldest snapshot, moving the pages still needed into the next one.
+    void DropOldest();
+
+    /// Drops every snapshot.
+    void Clear();
+
+    /// Returns the number of snapshots held.
+    [[nodiscard]] std::size_t Size() const {
+        return snapshots.size();
+    }
+
+    /// Returns the number of pages stored by a snapshot.
+    [[nodiscard]] std::size_t GetNumPages(std::size_t index) const {
+        return snapshots[index].size();
+    }
+
+    /// Returns the number of bytes used by the stored pages.
+    [[nodiscard]] std::size_t GetMemoryUsage() const;
+
+private:
+    /// Contents of a memory page, nullptr for a page of zeros
+    using Page = std::unique_ptr<u8[]>;
+    /// Pages that changed since the previous snapshot. The oldest snapshot holds every page that
+    /// is not zero instead.
+    using Snapshot = std::unordered_map<u32, Page>;
+
+    /// Returns the address of every page of the regions, in the order of their page numbers.
+    static std::vector<u8*> GetPages(Regions regions);
+
+    /// Runs a function on every page range in parallel, with the range's first and end page.
+    template <typename Func>
+    void ForEachRange(std::size_t num_pages, Func&& func);
+
+    std::deque<Snapshot> snapshots;
+    /// Hash of every page as of the newest snapshot
+    std::vector<u64> page_hashes;
+};
+
+/**
+ * Keeps the most recent states of the emulated system in memory, so that emulation can go back to
+ * any of them. Each snapshot stores the system state without the contents of FCRAM, VRAM and the
+ * N3DS extra RAM, which are kept by a MemorySnapshots instead.
+ */
+class RewindBuffer {
+public:
+    struct SnapshotInfo {
+        u64 ticks;              ///< Emulated ticks when the snapshot was taken
+        std::size_t state_size; ///< Size of the compressed system state
+        std::size_t num_pages;  ///< Number of memory pages stored by the snapshot
+    };
+
+    /**
+     * @param system System to take snapshots of
+     * @param capacity Number of snapshots kept, the oldest one is dropped past it
+     * @param interval_ticks Emulated ticks between two snapshots taken by Update
+     */
+    RewindBuffer(System& system, std::size_t capacity, u64 interval_ticks);
+    ~RewindBuffer();
+
+    /// Takes a snapshot if the interval elapsed since the last one. Called between run loop slices.
+    void Update();
+
+    /// Takes a snapshot of the current state.
+    void TakeSnapshot();
+
+    /**
+     * Brings the system back to a snapshot and drops the snapshots taken after it.
+     * @param index Index of the snapshot, 0 being the oldest one
+     */
+    void Restore(std::size_t index);
+
+    /**
+     * Brings the system back to the newest snapshot taken at least the given number of ticks ago,
+     * or to the oldest snapshot if none is that old.
+     */
+    void Rewind(u64 ticks);
+
+    /// Drops every snapshot.
+    void Clear();
+
+    /// Returns the snapshots held, from the oldest to the newest.
+    std::vector<SnapshotInfo> GetSnapshots() const;
+
+    /// Returns the number of bytes used by the snapshots.
+    std::size_t GetMemoryUsage() const;
+
+    std::size_t GetCapacity() const {
+        return capacity;
+    }
+
+    u64 GetIntervalTicks() const {
+        return interval_ticks;
+    }
+
+private:
+    struct Snapshot {
+        u64 ticks{};
+        std::vector<u8> state;
+    };
+
+    /// Returns the memory regions tracked.
+    std::vector<std::span<u8>> GetRegions() const;
+
+    System& system;
+    std::size_t capacity;
+    u64 interval_ticks;
+    u64 next_snapshot_ticks{};
+
+    /// System states, in lockstep with the memory snapshots
+    std::deque<Snapshot> snapshots;
+    MemorySnapshots memory;
+    /// Buffer the system state is serialized into, kept to avoid reallocations
+    std::vector<char> state_buffer;
+};
+
+} // namespace Core
@@ -15,6 +15,8 @@ enum class PacketType : u32 {
     Undefined = 0,
     ReadMemory = 1,
     WriteMemory = 2,
+    ReadCounters = 3,
+    ReadCounterName = 4,
 };
 
 struct PacketHeader {
@@ -29,6 +31,7 @@ constexpr u32 MIN_PACKET_SIZE = sizeof(PacketHeader);
 constexpr u32 MAX_PACKET_DATA_SIZE = 32;
 constexpr u32 MAX_PACKET_SIZE = MIN_PACKET_SIZE + MAX_PACKET_DATA_SIZE;
 constexpr u32 MAX_READ_SIZE = MAX_PACKET_DATA_SIZE;
+constexpr u32 MAX_READ_COUNTERS = MAX_PACKET_DATA_SIZE / sizeof(u64) - 1;
 
 class Packet {
 public:
@@ -2,9 +2,14 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <cstring>
+#include <string_view>
 #include "common/logging/log.h"
+#include "common/perf_counters.h"
 #include "core/core.h"
 #include "core/memory.h"
+#include "core/perf_stats.h"
 #include "core/rpc/packet.h"
 #include "core/rpc/rpc_server.h"
 
@@ -45,11 +50,35 @@ void RPCServer::HandleWriteMemory(Packet& packet, u32 address, std::span<const u
     packet.SendReply();
 }
 
+void RPCServer::HandleReadCounters(Packet& packet, u32 first_counter, u32 num_counters) {
+    // The reply holds the number of the frame the counters were taken from, then their values
+    const auto perf_stats = system.perf_stats.get();
+    const auto counters =
+        perf_stats ? perf_stats->GetLastFrameCounters() : PerfStats::FrameCounters{};
+    const auto packet_data = packet.GetPacketData();
+    std::memcpy(packet_data.data(), &counters.frame, sizeof(u64));
+    std::memcpy(packet_data.data() + sizeof(u64), counters.values.data() + first_counter,
+                num_counters * sizeof(u64));
+    packet.SetPacketDataSize(static_cast<u32>((1 + num_counters) * sizeof(u64)));
+    packet.SendReply();
+}
+
+void RPCServer::HandleReadCounterName(Packet& packet, u32 counter) {
+    const std::string_view name =
+        Common::PerfCounters::GetName(static_cast<Common::PerfCounters::Counter>(counter));
+    const std::size_t size = std::min<std::size_t>(name.size(), MAX_PACKET_DATA_SIZE);
+    std::memcpy(packet.GetPacketData().data(), name.data(), size);
+    packet.SetPacketDataSize(static_cast<u32>(size));
+    packet.SendReply();
+}
+
 bool RPCServer::ValidatePacket(const PacketHeader& packet_header) {
     if (packet_header.version <= CURRENT_VERSION) {
         switch (packet_header.packet_type) {
         case PacketType::ReadMemory:
         case PacketType::WriteMemory:
+        case PacketType::ReadCounters:
+        case PacketType::ReadCounterName:
             if (packet_header.packet_size >= (sizeof(u32) * 2)) {
                 return true;
             }
@@ -86,6 +115,21 @@ void RPCServer::HandleSingleRequest(std::unique_ptr<Packet> request_packet) {
                 success = true;
             }
             break;
+        // Counter requests use the address as the first counter and the size as their number
+        case PacketType::ReadCounters:
+            if (data_size > 0 && data_size <= MAX_READ_COUNTERS &&
+                address < Common::PerfCounters::NumCounters &&
+                data_size <= Common::PerfCounters::NumCounters - address) {
+                HandleReadCounters(*request_packet, address, data_size);
+                success = true;
+            }
+            break;
+        case PacketType::ReadCounterName:
+            if (address < Common::PerfCounters::NumCounters) {
+                HandleReadCounterName(*request_packet, address);
+                success = true;
+            }
+            break;
         default:
             break;
         }
@@ -29,6 +29,8 @@ public:
 private:
     void HandleReadMemory(Packet& packet, u32 address, u32 data_size);
     void HandleWriteMemory(Packet& packet, u32 address, std::span<const u8> data);
+    void HandleReadCounters(Packet& packet, u32 first_counter, u32 num_counters);
+    void HandleReadCounterName(Packet& packet, u32 counter);
     bool ValidatePacket(const PacketHeader& packet_header);
     void HandleSingleRequest(std::unique_ptr<Packet> request);
     void HandleRequestsLoop(std::stop_token stop_token);
@@ -2,18 +2,27 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
-#include <sstream>
+#include <span>
+#include <utility>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/stream.hpp>
 #include <cryptopp/hex.h>
 #include <fmt/format.h>
 #include "common/archives.h"
 #include "common/file_util.h"
 #include "common/logging/log.h"
 #include "common/scm_rev.h"
+#include "common/settings.h"
 #include "common/swap.h"
+#include "common/worker_pool.h"
 #include "common/zstd_compression.h"
 #include "core/core.h"
+#include "core/memory.h"
 #include "core/movie.h"
+#include "core/rewind_buffer.h"
 #include "core/savestate.h"
 #include "core/savestate_data.h"
 #include "network/network.h"
@@ -28,14 +37,118 @@ struct CSTHeader {
     u64_le time;                   /// The time when this save state was created
     std::array<u8, 20> build_name; /// The build name (Canary/Nightly) with the version number
     u32_le zero = 0;               /// Should be zero, just in case.
+    u32_le chunk_count = 0;        /// Number of compressed chunks, 0 for a single zstd frame
+    u32_le memory_group_count = 0; /// Number of memory groups, 0 if the state holds the memory
 
-    std::array<u8, 192> reserved{}; /// Make heading 256 bytes so it has consistent size
+    std::array<u8, 184> reserved{}; /// Make heading 256 bytes so it has consistent size
 };
 static_assert(sizeof(CSTHeader) == 256, "CSTHeader should be 256 bytes");
 #pragma pack(pop)
 
 constexpr std::array<u8, 4> header_magic_bytes{{'C', 'S', 'T', 0x1B}};
 
+/// Entry of the table following the header, one per chunk
+struct CSTChunk {
+    u32_le size;            /// Uncompressed size
+    u32_le compressed_size; /// Size of the chunk in the file
+};
+static_assert(sizeof(CSTChunk) == 8, "CSTChunk should be 8 bytes");
+
+/// Entry of the table following the chunk table, one per memory group
+struct CSTMemoryGroup {
+    u32_le region;
+    u32_le offset;
+    u32_le size;
+    u32_le compressed_size; /// Size of the group in the file, 0 for a group of zeros
+};
+static_assert(sizeof(CSTMemoryGroup) == 16, "CSTMemoryGroup should be 16 bytes");
+
+constexpr std::size_t SaveStateChunkSize = 4 * 1024 * 1024;
+
+/// Guest memory is compressed in groups of pages, so that it can be restored in parallel
+constexpr std::size_t MemoryGroupSize = 64 * Memory::CITRA_PAGE_SIZE;
+
+/// Output device appending to fixed size chunks, so that serializing never moves the state around
+class ChunkSink {
+public:
+    using char_type = char;
+    using category = boost::iostreams::sink_tag;
+
+    explicit ChunkSink(SaveStateChunks& chunks_) : chunks{&chunks_} {}
+
+    std::streamsize write(const char* data, std::streamsize size) {
+        std::streamsize written = 0;
+        while (written < size) {
+            if (chunks->empty() || chunks->back().size() == SaveStateChunkSize) {
+                chunks->emplace_back().reserve(SaveStateChunkSize);
+            }
+            auto& chunk = chunks->back();
+            const auto count = std::min(static_cast<std::size_t>(size - written),
+                                        SaveStateChunkSize - chunk.size());
+            chunk.insert(chunk.end(), data + written, data + written + count);
+            written += static_cast<std::streamsize>(count);
+        }
+        return size;
+    }
+
+private:
+    SaveStateChunks* chunks;
+};
+
+/// Largest size of each region of guest memory stored as memory groups
+constexpr std::array<std::size_t, 3> MaxMemoryRegionSizes{
+    Memory::VRAM_SIZE, Memory::FCRAM_N3DS_SIZE, Memory::N3DS_EXTRA_RAM_SIZE};
+
+/// Regions of guest memory stored as memory groups, in the order of SaveStateMemoryGroup::region
+static std::array<std::span<u8>, 3> GetMemoryRegions(const Memory::MemorySystem& memory,
+                                                     bool is_new_3ds) {
+    return {{
+        {memory.GetPhysicalPointer(Memory::VRAM_PADDR), Memory::VRAM_SIZE},
+        {memory.GetPhysicalPointer(Memory::FCRAM_PADDR),
+         is_new_3ds ? Memory::FCRAM_N3DS_SIZE : Memory::FCRAM_SIZE},
+        {memory.GetPhysicalPointer(Memory::N3DS_EXTRA_RAM_PADDR),
+         is_new_3ds ? Memory::N3DS_EXTRA_RAM_SIZE : 0},
+    }};
+}
+
+SaveStateMemory CollectSaveStateMemory(const Memory::MemorySystem& memory) {
+    SaveStateMemory groups;
+    const auto regions = GetMemoryRegions(memory, Settings::values.is_new_3ds.GetValue());
+    for (u32 region = 0; region < regions.size(); region++) {
+        const auto data = regions[region];
+        for (std::size_t offset = 0; offset < data.size(); offset += MemoryGroupSize) {
+            const auto group =
+                data.subspan(offset, std::min(MemoryGroupSize, data.size() - offset));
+            auto& entry = groups.emplace_back(SaveStateMemoryGroup{
+                region, static_cast<u32>(offset), static_cast<u32>(group.size()), {}});
+            if (!Memory::IsZeroMemory(group)) {
+                entry.data.assign(group.begin(), group.end());
+            }
+        }
+    }
+    return groups;
+}
+
+void RestoreSaveStateMemory(Memory::MemorySystem& memory, const SaveStateMemory& groups) {
+    const auto regions = GetMemoryRegions(memory, true);
+    for (const auto& group : groups) {
+        if (group.region >= regions.size() ||
+            u64{group.offset} + group.size > regions[group.region].size() ||
+            (!group.data.empty() && group.data.size() != group.size)) {
+            throw std::runtime_error("Invalid save state memory group");
+        }
+    }
+    Common::ParallelFor(groups.size(), [&](std::size_t i) {
+        const auto& group = groups[i];
+        const auto destination = regions[group.region].subspan(group.offset, group.size);
+        if (group.data.empty()) {
+            std::memset(destination.data(), 0, destination.size());
+        } else {
+            std::memcpy(destination.data(), group.data.data(), destination.size());
+        }
+    });
+}
+
 static std::string GetSaveStatePath(u64 program_id, u64 movie_id, u32 slot) {
     if (movie_id) {
         return fmt::format("{}{:016X}.movie{:016X}.{:02d}.cst",
@@ -48,8 +161,7 @@ static std::string GetSaveStatePath(u64 program_id, u64 movie_id, u32 slot) {
 }
 
 static bool ValidateSaveState(const CSTHeader& header, SaveStateInfo& info, u64 program_id,
-                              u64 movie_id) {
-    const auto path = GetSaveStatePath(program_id, movie_id, info.slot);
+                              const std::string& path) {
     if (header.filetype != header_magic_bytes) {
         LOG_WARNING(Core, "Invalid save state file {}", path);
         return false;
@@ -112,7 +224,7 @@ std::vector<SaveStateInfo> ListSaveStates(u64 program_id, u64 movie_id) {
             LOG_ERROR(Core, "Could not read from file {}", path);
             continue;
         }
-        if (!ValidateSaveState(header, info, program_id, movie_id)) {
+        if (!ValidateSaveState(header, info, program_id, path)) {
             continue;
         }
 
@@ -121,30 +233,11 @@ std::vector<SaveStateInfo> ListSaveStates(u64 program_id, u64 movie_id) {
     return result;
 }
 
-void System::SaveState(u32 slot) const {
-    std::ostringstream sstream{std::ios_base::binary};
-    // Serialize
-    oarchive oa{sstream};
-    oa&* this;
-
-    const std::string& str{sstream.str()};
-    const auto data = std::span<const u8>{reinterpret_cast<const u8*>(str.data()), str.size()};
-    auto buffer = Common::Compression::CompressDataZSTDDefault(data);
-
-    const u64 movie_id = movie.GetCurrentMovieID();
-    const auto path = GetSaveStatePath(title_id, movie_id, slot);
-    if (!FileUtil::CreateFullPath(path)) {
-        throw std::runtime_error("Could not create path " + path);
-    }
-
-    FileUtil::IOFile file(path, "wb");
-    if (!file) {
-        throw std::runtime_error("Could not open file " + path);
-    }
-
+static std::vector<u8> MakeHeader(u64 program_id, std::size_t chunk_count,
+                                  std::size_t memory_group_count) {
     CSTHeader header{};
     header.filetype = header_magic_bytes;
-    header.program_id = title_id;
+    header.program_id = program_id;
     std::string rev_bytes;
     CryptoPP::StringSource ss(Common::g_scm_rev, true,
                               new CryptoPP::HexDecoder(new CryptoPP::StringSink(rev_bytes)));
@@ -156,53 +249,269 @@ void System::SaveState(u32 slot) const {
     std::memset(header.build_name.data(), 0, sizeof(header.build_name));
     std::memcpy(header.build_name.data(), build_fullname.c_str(),
                 std::min(build_fullname.length(), sizeof(header.build_name) - 1));
+    header.chunk_count = static_cast<u32>(chunk_count);
+    header.memory_group_count = static_cast<u32>(memory_group_count);
 
-    if (file.WriteBytes(&header, sizeof(header)) != sizeof(header) ||
-        file.WriteBytes(buffer.data(), buffer.size()) != buffer.size()) {
-        throw std::runtime_error("Could not write to file " + path);
+    std::vector<u8> header_bytes(sizeof(header));
+    std::memcpy(header_bytes.data(), &header, sizeof(header));
+    return header_bytes;
+}
+
+SaveStateWriter::SaveStateWriter() : file_worker{1, "SaveStateWriter"} {}
+
+SaveStateWriter::~SaveStateWriter() {
+    Wait();
+}
+
+void SaveStateWriter::Write(std::string path, u64 program_id, SaveStateChunks chunks,
+                            SaveStateMemory memory) {
+    // Every state holds a copy of guest memory, so a state is only queued once the previous one
+    // was written.
+    Wait();
+    auto header = MakeHeader(program_id, chunks.size(), memory.size());
+    file_worker.QueueWork([this, path = std::move(path), header = std::move(header),
+                           chunks = std::move(chunks), memory = std::move(memory)]() mutable {
+        try {
+            WriteFile(path, header, chunks, memory);
+            LOG_INFO(Core, "Save state written to {}", path);
+        } catch (const std::exception& e) {
+            LOG_ERROR(Core, "Error writing save state: {}", e.what());
+            std::scoped_lock lock{error_mutex};
+            if (!error) {
+                error = e.what();
+                has_error = true;
+            }
+        }
+    });
+}
+
+void SaveStateWriter::Wait() {
+    file_worker.WaitForRequests();
+}
+
+std::optional<std::string> SaveStateWriter::TakeError() {
+    if (!has_error) {
+        return std::nullopt;
     }
+    std::scoped_lock lock{error_mutex};
+    has_error = false;
+    return std::exchange(error, std::nullopt);
 }
 
-void System::LoadState(u32 slot) {
-    if (Network::GetRoomMember().lock()->IsConnected()) {
-        throw std::runtime_error("Unable to load while connected to multiplayer");
+void SaveStateWriter::WriteFile(const std::string& path, const std::vector<u8>& header,
+                                SaveStateChunks& chunks, SaveStateMemory& memory) {
+    // Chunks and memory groups are compressed independently, and freed as soon as they are.
+    std::vector<CSTChunk> table(chunks.size());
+    std::vector<std::vector<u8>> compressed(chunks.size());
+    Common::TaskGroup compress_group;
+    for (std::size_t i = 0; i < chunks.size(); i++) {
+        table[i].size = static_cast<u32>(chunks[i].size());
+        compress_group.Run([&chunks, &compressed, i] {
+            compressed[i] = Common::Compression::CompressDataZSTDDefault(chunks[i]);
+            chunks[i] = {};
+        });
     }
+    std::vector<CSTMemoryGroup> memory_table(memory.size());
+    std::vector<std::vector<u8>> compressed_memory(memory.size());
+    for (std::size_t i = 0; i < memory.size(); i++) {
+        memory_table[i].region = memory[i].region;
+        memory_table[i].offset = memory[i].offset;
+        memory_table[i].size = memory[i].size;
+        if (memory[i].data.empty()) {
+            continue;
+        }
+        compress_group.Run([&memory, &compressed_memory, i] {
+            compressed_memory[i] = Common::Compression::CompressDataZSTDDefault(memory[i].data);
+            memory[i].data = {};
+        });
+    }
+    compress_group.Wait();
 
-    const u64 movie_id = movie.GetCurrentMovieID();
-    const auto path = GetSaveStatePath(title_id, movie_id, slot);
+    for (std::size_t i = 0; i < chunks.size(); i++) {
+        if (compressed[i].empty()) {
+            throw std::runtime_error("Could not compress save state " + path);
+        }
+        table[i].compressed_size = static_cast<u32>(compressed[i].size());
+    }
+    for (std::size_t i = 0; i < memory.size(); i++) {
+        memory_table[i].compressed_size = static_cast<u32>(compressed_memory[i].size());
+    }
 
-    std::vector<u8> decompressed;
+    // Written next to the state first, so that the slot keeps its previous state until this one
+    // is complete.
+    const std::string temp_path = path + ".tmp";
     {
-        std::vector<u8> buffer(FileUtil::GetSize(path) - sizeof(CSTHeader));
+        FileUtil::IOFile file(temp_path, "wb");
+        bool success = file.IsOpen() &&
+                       file.WriteBytes(header.data(), header.size()) == header.size() &&
+                       file.WriteArray(table.data(), table.size()) == table.size() &&
+                       file.WriteArray(memory_table.data(), memory_table.size()) ==
+                           memory_table.size();
+        for (std::size_t i = 0; success && i < compressed.size(); i++) {
+            success = file.WriteBytes(compressed[i].data(), compressed[i].size()) ==
+                      compressed[i].size();
+        }
+        for (std::size_t i = 0; success && i < compressed_memory.size(); i++) {
+            success = file.WriteBytes(compressed_memory[i].data(), compressed_memory[i].size()) ==
+                      compressed_memory[i].size();
+        }
+        if (!success) {
+            file.Close();
+            FileUtil::Delete(temp_path);
+            throw std::runtime_error("Could not write to file " + temp_path);
+        }
+    }
+    if (!FileUtil::RenameReplace(temp_path, path)) {
+        FileUtil::Delete(temp_path);
+        throw std::runtime_error("Could not replace save state " + path);
+    }
+}
 
-        FileUtil::IOFile file(path, "rb");
+SaveStateContents SaveStateWriter::Read(const std::string& path, u64 program_id) {
+    FileUtil::IOFile file(path, "rb");
 
-        // load header
-        CSTHeader header;
-        if (file.ReadBytes(&header, sizeof(header)) != sizeof(header)) {
+    // load header
+    CSTHeader header;
+    if (file.ReadBytes(&header, sizeof(header)) != sizeof(header)) {
+        throw std::runtime_error("Could not read from file at " + path);
+    }
+
+    // validate header
+    SaveStateInfo info{};
+    if (!ValidateSaveState(header, info, program_id, path)) {
+        throw std::runtime_error("Invalid savestate");
+    }
+
+    SaveStateContents contents;
+    if (header.chunk_count == 0) {
+        // States written as a single zstd frame
+        std::vector<u8> buffer(file.GetSize() - sizeof(CSTHeader));
+        if (file.ReadBytes(buffer.data(), buffer.size()) != buffer.size()) {
             throw std::runtime_error("Could not read from file at " + path);
         }
+        contents.state = Common::Compression::DecompressDataZSTD(buffer);
+        return contents;
+    }
 
-        // validate header
-        SaveStateInfo info;
-        info.slot = slot;
-        if (!ValidateSaveState(header, info, title_id, movie_id)) {
-            throw std::runtime_error("Invalid savestate");
+    std::vector<CSTChunk> table(header.chunk_count);
+    std::vector<CSTMemoryGroup> memory_table(header.memory_group_count);
+    if (file.ReadArray(table.data(), table.size()) != table.size() ||
+        file.ReadArray(memory_table.data(), memory_table.size()) != memory_table.size()) {
+        throw std::runtime_error("Could not read from file at " + path);
+    }
+    std::size_t total_size = 0;
+    for (const auto& chunk : table) {
+        total_size += chunk.size;
+    }
+    contents.state.resize(total_size);
+    for (const auto& group : memory_table) {
+        if (group.region >= MaxMemoryRegionSizes.size() ||
+            u64{group.offset} + group.size > MaxMemoryRegionSizes[group.region]) {
+            throw std::runtime_error("Invalid memory group in " + path);
         }
+        contents.memory.push_back({group.region, group.offset, group.size, {}});
+    }
 
-        if (file.ReadBytes(buffer.data(), buffer.size()) != buffer.size()) {
-            throw std::runtime_error("Could not read from file at " + path);
+    // Everything is decompressed in parallel while the rest of the file is read.
+    std::vector<std::vector<u8>> buffers(table.size() + memory_table.size());
+    std::atomic<bool> failed{false};
+    // Declared after the buffers, so that it waits for the tasks before they are freed
+    Common::TaskGroup decompress_group;
+    const auto queue_decompress = [&](std::size_t index, std::span<u8> destination) {
+        if (file.ReadBytes(buffers[index].data(), buffers[index].size()) !=
+            buffers[index].size()) {
+            failed = true;
+            return;
         }
-        decompressed = Common::Compression::DecompressDataZSTD(buffer);
+        decompress_group.Run([&buffers, &failed, index, destination] {
+            if (!Common::Compression::DecompressDataZSTD(buffers[index], destination)) {
+                failed = true;
+            }
+            buffers[index] = {};
+        });
+    };
+    std::size_t offset = 0;
+    for (std::size_t i = 0; i < table.size(); i++) {
+        buffers[i].resize(table[i].compressed_size);
+        queue_decompress(i, std::span{contents.state}.subspan(offset, table[i].size));
+        offset += table[i].size;
     }
-    std::istringstream sstream{
-        std::string{reinterpret_cast<char*>(decompressed.data()), decompressed.size()},
-        std::ios_base::binary};
-    decompressed.clear();
+    for (std::size_t i = 0; i < memory_table.size(); i++) {
+        if (memory_table[i].compressed_size == 0) {
+            continue;
+        }
+        auto& data = contents.memory[i].data;
+        data.resize(memory_table[i].size);
+        buffers[table.size() + i].resize(memory_table[i].compressed_size);
+        queue_decompress(table.size() + i, data);
+    }
+    decompress_group.Wait();
+    if (failed) {
+        throw std::runtime_error("Could not decompress " + path);
+    }
+    return contents;
+}
 
-    // Deserialize
-    iarchive ia{sstream};
-    ia&* this;
+void System::SaveState(u32 slot) const {
+    SaveState(GetSaveStatePath(title_id, movie.GetCurrentMovieID(), slot));
+}
+
+void System::SaveState(const std::string& path) const {
+    // Only the serialization and the copy of the memory stall emulation, compressing and writing
+    // the state is done by the save state writer.
+    SaveStateChunks chunks;
+    {
+        boost::iostreams::stream<ChunkSink> stream{ChunkSink{chunks}};
+        {
+            oarchive oa{stream};
+            oa&* this;
+        }
+        stream.flush();
+    }
+    // Emulation goes on while the memory is compressed.
+    auto memory_groups = CollectSaveStateMemory(*memory);
+
+    if (!FileUtil::CreateFullPath(path)) {
+        throw std::runtime_error("Could not create path " + path);
+    }
+
+    if (!savestate_writer) {
+        savestate_writer = std::make_unique<SaveStateWriter>();
+    }
+    savestate_writer->Write(path, title_id, std::move(chunks), std::move(memory_groups));
+}
+
+void System::LoadState(u32 slot) {
+    LoadState(GetSaveStatePath(title_id, movie.GetCurrentMovieID(), slot));
+}
+
+void System::LoadState(const std::string& path) {
+    if (Network::GetRoomMember().lock()->IsConnected()) {
+        throw std::runtime_error("Unable to load while connected to multiplayer");
+    }
+
+    // The slot may still be being written.
+    if (savestate_writer) {
+        savestate_writer->Wait();
+    } else {
+        savestate_writer = std::make_unique<SaveStateWriter>();
+    }
+
+    auto contents = savestate_writer->Read(path, title_id);
+    {
+        boost::iostreams::stream<boost::iostreams::array_source> stream{
+            reinterpret_cast<const char*>(contents.state.data()), contents.state.size()};
+        iarchive ia{stream};
+        ia&* this;
+    }
+
+    // Deserializing replaced the memory system, so its contents can only be restored now.
+    RestoreSaveStateMemory(*memory, contents.memory);
+
+    // Snapshots only describe memory relative to each other, so they cannot follow a load.
+    if (rewind_buffer) {
+        rewind_buffer->Clear();
+    }
 }
 
 } // namespace Core
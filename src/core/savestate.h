@@ -4,9 +4,17 @@
 
 #pragma once
 
+#include <atomic>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <vector>
 #include "common/common_types.h"
+#include "common/thread_worker.h"
+
+namespace Memory {
+class MemorySystem;
+}
 
 namespace Core {
 
@@ -24,4 +32,71 @@ constexpr u32 SaveStateSlotCount = 10; // Maximum count of savestate slots
 
 std::vector<SaveStateInfo> ListSaveStates(u64 program_id, u64 movie_id);
 
+/// A serialized state, split in chunks so that it never has to be contiguous
+using SaveStateChunks = std::vector<std::vector<u8>>;
+
+/// Pages of guest memory, stored apart from the serialized state and compressed independently
+struct SaveStateMemoryGroup {
+    u32 region;           ///< Index of the memory region: VRAM, FCRAM or N3DS extra RAM
+    u32 offset;           ///< Offset of the group in the region
+    u32 size;             ///< Size of the group
+    std::vector<u8> data; ///< Contents of the group, empty if it is all zeros
+};
+using SaveStateMemory = std::vector<SaveStateMemoryGroup>;
+
+/// A state read back from a file
+struct SaveStateContents {
+    std::vector<u8> state;  ///< Serialized system state
+    SaveStateMemory memory; ///< Guest memory, empty if the serialized state holds it
+};
+
+/// Copies the guest memory that is not zero in groups of pages.
+SaveStateMemory CollectSaveStateMemory(const Memory::MemorySystem& memory);
+
+/**
+ * Copies memory groups into guest memory, in parallel. Groups without data are cleared.
+ * @throws std::runtime_error if a group lies outside of guest memory
+ */
+void RestoreSaveStateMemory(Memory::MemorySystem& memory, const SaveStateMemory& groups);
+
+/**
+ * Compresses and writes savestates on background threads, so that saving only stalls emulation
+ * for the time it takes to serialize the system. Chunks are compressed in parallel and the file
+ * only replaces the previous state of the slot once it is complete.
+ */
+class SaveStateWriter {
+public:
+    SaveStateWriter();
+    ~SaveStateWriter();
+
+    /**
+     * Queues a state of the given program for writing. Waits for the previous state to be written
+     * first, so that at most one state is in flight.
+     */
+    void Write(std::string path, u64 program_id, SaveStateChunks chunks, SaveStateMemory memory);
+
+    /// Waits until every queued state is on disk.
+    void Wait();
+
+    /// Returns the error of the first state that could not be written since the last call.
+    std::optional<std::string> TakeError();
+
+    /**
+     * Reads a state, its chunks and memory groups being decompressed in parallel.
+     * @throws std::runtime_error if the file is not a valid state of the program
+     */
+    SaveStateContents Read(const std::string& path, u64 program_id);
+
+private:
+    /// Throws std::runtime_error if the state could not be written
+    void WriteFile(const std::string& path, const std::vector<u8>& header,
+                   SaveStateChunks& chunks, SaveStateMemory& memory);
+
+    Common::ThreadWorker file_worker;
+
+    std::mutex error_mutex;
+    std::optional<std::string> error;
+    std::atomic<bool> has_error{false}; ///< Lets the run loop check for errors without locking
+};
+
 } // namespace Core
@@ -60,6 +60,10 @@ struct CTHeader {
     u32 stream_size;
 };
 
+// Register writes are recorded at the physical address of the register
+constexpr u32 LcdRegistersBase = 0x10202000;
+constexpr u32 GpuRegistersBase = 0x10400000;
+
 enum CTStreamElementType : u32 {
     FrameMarker = 0xE1,
     MemoryLoad = 0xE2,
@@ -0,0 +1,388 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstring>
+#include "common/file_util.h"
+#include "common/hash.h"
+#include "common/logging/log.h"
+#include "core/memory.h"
+#include "core/tracer/player.h"
+#include "video_core/pica/pica_core.h"
+#include "video_core/rasterizer_interface.h"
+#include "video_core/renderer_software/sw_blitter.h"
+
+namespace CiTrace {
+
+using Clock = std::chrono::steady_clock;
+
+/// Forwards everything to the rasterizer of the player and measures the time spent in each draw.
+class Player::TimingRasterizer : public VideoCore::RasterizerInterface {
+public:
+    explicit TimingRasterizer(VideoCore::RasterizerInterface& inner) : inner{inner} {}
+
+    /// Starts a frame, the next draw is measured from now.
+    void BeginFrame(ReplayTimings::Frame* frame_) {
+        frame = frame_;
+        last_mark = Clock::now();
+    }
+
+    void AddTriangle(const Pica::OutputVertex& v0, const Pica::OutputVertex& v1,
+                     const Pica::OutputVertex& v2) override {
+        inner.AddTriangle(v0, v1, v2);
+    }
+
+    void DrawTriangles() override {
+        inner.DrawTriangles();
+        MarkDraw();
+    }
+
+    void NotifyPicaRegisterChanged(u32 id) override {
+        inner.NotifyPicaRegisterChanged(id);
+    }
+
+    void FlushAll() override {
+        inner.FlushAll();
+    }
+
+    void FlushRegion(PAddr addr, u32 size) override {
+        inner.FlushRegion(addr, size);
+    }
+
+    void InvalidateRegion(PAddr addr, u32 size) override {
+        inner.InvalidateRegion(addr, size);
+    }
+
+    void FlushAndInvalidateRegion(PAddr addr, u32 size) override {
+        inner.FlushAndInvalidateRegion(addr, size);
+    }
+
+    void ClearAll(bool flush) override {
+        inner.ClearAll(flush);
+    }
+
+    bool AccelerateDisplayTransfer(const Pica::DisplayTransferConfig& config) override {
+        return inner.AccelerateDisplayTransfer(config);
+    }
+
+    bool AccelerateTextureCopy(const Pica::DisplayTransferConfig& config) override {
+        return inner.AccelerateTextureCopy(config);
+    }
+
+    bool AccelerateFill(const Pica::MemoryFillConfig& config) override {
+        return inner.AccelerateFill(config);
+    }
+
+    bool AccelerateDrawBatch(bool is_indexed) override {
+        const bool accelerated = inner.AccelerateDrawBatch(is_indexed);
+        if (accelerated) {
+            MarkDraw();
+        }
+        return accelerated;
+    }
+
+    void SyncEntireState() override {
+        inner.SyncEntireState();
+    }
+
+private:
+    void MarkDraw() {
+        const auto now = Clock::now();
+        if (frame) {
+            frame->draws.push_back(now - last_mark);
+        }
+        last_mark = now;
+    }
+
+    VideoCore::RasterizerInterface& inner;
+    ReplayTimings::Frame* frame{};
+    Clock::time_point last_mark;
+};
+
+Player::Player(Memory::MemorySystem& memory, Pica::PicaCore& pica,
+               VideoCore::RasterizerInterface& rasterizer)
+    : memory{memory}, pica{pica}, rasterizer{rasterizer},
+      timing_rasterizer{std::make_unique<TimingRasterizer>(rasterizer)},
+      sw_blitter{std::make_unique<SwRenderer::SwBlitter>(memory, &rasterizer)},
+      interrupt_handler{[](Service::GSP::InterruptId) {}} {}
+
+Player::~Player() = default;
+
+bool Player::Load(const std::string& filename) {
+    std::vector<u8> data;
+    FileUtil::IOFile file(filename, "rb");
+    if (!file.IsOpen()) {
+        LOG_ERROR(HW_GPU, "Could not open CiTrace {}", filename);
+        return false;
+    }
+    data.resize(file.GetSize());
+    if (file.ReadBytes(data.data(), data.size()) != data.size()) {
+        LOG_ERROR(HW_GPU, "Could not read CiTrace {}", filename);
+        return false;
+    }
+    return Load(std::move(data));
+}
+
+bool Player::Load(std::vector<u8> data) {
+    trace.clear();
+    stream.clear();
+
+    if (data.size() < sizeof(CTHeader)) {
+        LOG_ERROR(HW_GPU, "CiTrace is too small");
+        return false;
+    }
+    std::memcpy(&header, data.data(), sizeof(CTHeader));
+    if (std::memcmp(header.magic, CTHeader::ExpectedMagicWord(), sizeof(header.magic)) != 0 ||
+        header.version != CTHeader::ExpectedVersion()) {
+        LOG_ERROR(HW_GPU, "Not a CiTrace, or unsupported version {}", header.version);
+        return false;
+    }
+
+    const auto in_file = [&](u64 offset, u64 size) {
+        return offset <= data.size() && size <= data.size() - offset;
+    };
+
+    const auto& initial = header.initial_state_offsets;
+    const std::array<std::pair<u32, u32>, 10> blocks = {{
+        {initial.gpu_registers, initial.gpu_registers_size},
+        {initial.lcd_registers, initial.lcd_registers_size},
+        {initial.pica_registers, initial.pica_registers_size},
+        {initial.default_attributes, initial.default_attributes_size},
+        {initial.vs_program_binary, initial.vs_program_binary_size},
+        {initial.vs_swizzle_data, initial.vs_swizzle_data_size},
+        {initial.vs_float_uniforms, initial.vs_float_uniforms_size},
+        {initial.gs_program_binary, initial.gs_program_binary_size},
+        {initial.gs_swizzle_data, initial.gs_swizzle_data_size},
+        {initial.gs_float_uniforms, initial.gs_float_uniforms_size},
+    }};
+    for (const auto& [offset, size] : blocks) {
+        if (!in_file(offset, u64{size} * sizeof(u32))) {
+            LOG_ERROR(HW_GPU, "CiTrace initial state is out of the file");
+            return false;
+        }
+    }
+    if (!in_file(header.stream_offset, u64{header.stream_size} * sizeof(CTStreamElement))) {
+        LOG_ERROR(HW_GPU, "CiTrace stream is out of the file");
+        return false;
+    }
+
+    stream.resize(header.stream_size);
+    std::memcpy(stream.data(), data.data() + header.stream_offset,
+                stream.size() * sizeof(CTStreamElement));
+    for (const auto& element : stream) {
+        if (element.type == MemoryLoad &&
+            !in_file(element.memory_load.file_offset, element.memory_load.size)) {
+            LOG_ERROR(HW_GPU, "CiTrace memory load is out of the file");
+            stream.clear();
+            return false;
+        }
+    }
+
+    trace = std::move(data);
+    return true;
+}
+
+std::size_t Player::GetFrameCount() const {
+    const auto markers =
+        std::count_if(stream.begin(), stream.end(),
+                      [](const CTStreamElement& element) { return element.type == FrameMarker; });
+    // Elements after the last marker belong to a frame that was not finished.
+    const bool unfinished = !stream.empty() && stream.back().type != FrameMarker;
+    return static_cast<std::size_t>(markers) + (unfinished ? 1 : 0);
+}
+
+ReplayTimings Player::Replay() {
+    ReplayTimings timings;
+    ApplyInitialState();
+
+    pica.BindRasterizer(timing_rasterizer.get());
+    pica.SetInterruptHandler(interrupt_handler);
+
+    const auto start = Clock::now();
+    auto frame_start = start;
+    if (!stream.empty()) {
+        timings.frames.emplace_back();
+        timing_rasterizer->BeginFrame(&timings.frames.back());
+    }
+
+    for (std::size_t i = 0; i < stream.size(); i++) {
+        const auto& element = stream[i];
+        switch (element.type) {
+        case FrameMarker: {
+            const auto now = Clock::now();
+            timings.frames.back().duration = now - frame_start;
+            frame_start = now;
+            if (i + 1 < stream.size()) {
+                timings.frames.emplace_back();
+                timing_rasterizer->BeginFrame(&timings.frames.back());
+            }
+            break;
+        }
+        case MemoryLoad:
+            LoadMemory(element.memory_load);
+            break;
+        case RegisterWrite:
+            WriteRegister(element.register_write.physical_address, element.register_write.value);
+            break;
+        default:
+            LOG_WARNING(HW_GPU, "Unknown CiTrace stream element {:#x}",
+                        static_cast<u32>(element.type));
+            break;
+        }
+    }
+
+    const auto end = Clock::now();
+    if (!stream.empty() && stream.back().type != FrameMarker) {
+        timings.frames.back().duration = end - frame_start;
+    }
+    timings.duration = end - start;
+
+    timing_rasterizer->BeginFrame(nullptr);
+    pica.BindRasterizer(&rasterizer);
+
+    rasterizer.FlushAll();
+    const u8* fcram = memory.GetFCRAMPointer(0);
+    const u8* vram = memory.GetPhysicalPointer(Memory::VRAM_PADDR);
+    const std::array<u64, 2> hashes = {
+        Common::ComputeHash64(fcram, Memory::FCRAM_N3DS_SIZE),
+        Common::ComputeHash64(vram, Memory::VRAM_SIZE),
+    };
+    timings.output_hash = Common::ComputeHash64(hashes.data(), sizeof(hashes));
+    return timings;
+}
+
+std::vector<u32> Player::GetInitialState(u32 offset, u32 size) const {
+    std::vector<u32> words(size);
+    std::memcpy(words.data(), trace.data() + offset, size * sizeof(u32));
+    return words;
+}
+
+void Player::ApplyInitialState() {
+    const auto& initial = header.initial_state_offsets;
+
+    // Start from zeroed memory, so that every replay sees the same data.
+    std::memset(memory.GetFCRAMPointer(0), 0, Memory::FCRAM_N3DS_SIZE);
+    std::memset(memory.GetPhysicalPointer(Memory::VRAM_PADDR), 0, Memory::VRAM_SIZE);
+
+    const auto lcd_registers = GetInitialState(initial.lcd_registers, initial.lcd_registers_size);
+    for (u32 i = 0; i < std::min<std::size_t>(lcd_registers.size(), Pica::RegsLcd::NumIds()); i++) {
+        pica.regs_lcd[i] = lcd_registers[i];
+    }
+
+    const auto pica_registers =
+        GetInitialState(initial.pica_registers, initial.pica_registers_size);
+    pica.regs.reg_array.fill(0);
+    std::copy_n(pica_registers.begin(),
+                std::min(pica_registers.size(), pica.regs.reg_array.size()),
+                pica.regs.reg_array.begin());
+
+    const auto load_vectors = [this](u32 offset, u32 size, auto& dest) {
+        const auto words = GetInitialState(offset, size);
+        for (std::size_t i = 0; i < std::min(words.size() / 4, dest.size()); i++) {
+            for (std::size_t comp = 0; comp < 4; comp++) {
+                dest[i][comp] = Pica::f24::FromRaw(words[i * 4 + comp]);
+            }
+        }
+    };
+    load_vectors(initial.default_attributes, initial.default_attributes_size,
+                 pica.input_default_attributes);
+    load_vectors(initial.vs_float_uniforms, initial.vs_float_uniforms_size,
+                 pica.vs_setup.uniforms.f);
+    load_vectors(initial.gs_float_uniforms, initial.gs_float_uniforms_size,
+                 pica.gs_setup.uniforms.f);
+
+    const auto load_words = [this](u32 offset, u32 size, auto& dest) {
+        const auto words = GetInitialState(offset, size);
+        dest.fill(0);
+        std::copy_n(words.begin(), std::min(words.size(), dest.size()), dest.begin());
+    };
+    load_words(initial.vs_program_binary, initial.vs_program_binary_size,
+               pica.vs_setup.program_code);
+    load_words(initial.vs_swizzle_data, initial.vs_swizzle_data_size, pica.vs_setup.swizzle_data);
+    load_words(initial.gs_program_binary, initial.gs_program_binary_size,
+               pica.gs_setup.program_code);
+    load_words(initial.gs_swizzle_data, initial.gs_swizzle_data_size, pica.gs_setup.swizzle_data);
+    pica.vs_setup.MarkProgramCodeDirty();
+    pica.vs_setup.MarkSwizzleDataDirty();
+    pica.gs_setup.MarkProgramCodeDirty();
+    pica.gs_setup.MarkSwizzleDataDirty();
+
+    pica.ResetPipeline();
+    rasterizer.ClearAll(false);
+    rasterizer.SyncEntireState();
+}
+
+void Player::LoadMemory(const CTMemoryLoad& load) {
+    if (!memory.IsValidPhysicalAddress(load.physical_address) ||
+        memory.GetPhysicalRef(load.physical_address).GetSize() < load.size) {
+        LOG_WARNING(HW_GPU, "CiTrace loads {:#x} bytes to invalid address {:#010x}", load.size,
+                    load.physical_address);
+        return;
+    }
+    std::memcpy(memory.GetPhysicalPointer(load.physical_address), trace.data() + load.file_offset,
+                load.size);
+    rasterizer.InvalidateRegion(load.physical_address, load.size);
+}
+
+void Player::WriteRegister(u32 physical_address, u32 value) {
+    if (physical_address >= LcdRegistersBase &&
+        physical_address < LcdRegistersBase + Pica::RegsLcd::NumIds() * sizeof(u32)) {
+        pica.regs_lcd[(physical_address - LcdRegistersBase) / sizeof(u32)] = value;
+        return;
+    }
+
+    const u32 index = (physical_address - GpuRegistersBase) / sizeof(u32);
+    if (physical_address < GpuRegistersBase || index >= Pica::PicaCore::Regs::NUM_REGS) {
+        LOG_WARNING(HW_GPU, "CiTrace writes to unknown register {:#010x}", physical_address);
+        return;
+    }
+    auto& regs = pica.regs;
+    regs.reg_array[index] = value;
+
+    // Perform the operations the register triggers, the same way the GPU does.
+    switch (index) {
+    case GPU_REG_INDEX(memory_fill_config[0].trigger):
+    case GPU_REG_INDEX(memory_fill_config[1].trigger): {
+        auto& config =
+            regs.memory_fill_config[index == GPU_REG_INDEX(memory_fill_config[0].trigger) ? 0 : 1];
+        if (config.trigger) {
+            if (!timing_rasterizer->AccelerateFill(config)) {
+                sw_blitter->MemoryFill(config);
+            }
+            config.trigger.Assign(0);
+            config.finished.Assign(1);
+        }
+        break;
+    }
+    case GPU_REG_INDEX(display_transfer_config.trigger): {
+        auto& config = regs.display_transfer_config;
+        if (config.trigger.Value()) {
+            if (config.is_texture_copy) {
+                if (!timing_rasterizer->AccelerateTextureCopy(config)) {
+                    sw_blitter->TextureCopy(config);
+                }
+            } else if (!timing_rasterizer->AccelerateDisplayTransfer(config)) {
+                sw_blitter->DisplayTransfer(config);
+            }
+            config.trigger.Assign(0);
+        }
+        break;
+    }
+    case GPU_REG_INDEX(internal.pipeline.command_buffer.trigger[0]):
+    case GPU_REG_INDEX(internal.pipeline.command_buffer.trigger[1]): {
+        auto& config = regs.internal.pipeline.command_buffer;
+        const u32 list =
+            index == GPU_REG_INDEX(internal.pipeline.command_buffer.trigger[0]) ? 0 : 1;
+        if (config.trigger[list]) {
+            pica.ProcessCmdList(config.GetPhysicalAddress(list), config.GetSize(list));
+            config.trigger[list] = 0;
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+} // namespace CiTrace
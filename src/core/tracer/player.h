@@ -0,0 +1,98 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common_types.h"
+#include "core/hle/service/gsp/gsp_interrupt.h"
+#include "core/tracer/citrace.h"
+
+namespace Memory {
+class MemorySystem;
+}
+
+namespace Pica {
+class PicaCore;
+}
+
+namespace VideoCore {
+class RasterizerInterface;
+}
+
+namespace SwRenderer {
+class SwBlitter;
+}
+
+namespace CiTrace {
+
+/// Timings of one replay of a trace
+struct ReplayTimings {
+    struct Frame {
+        std::chrono::nanoseconds duration{};
+        /// Time spent in each draw, including the register writes that set it up
+        std::vector<std::chrono::nanoseconds> draws;
+    };
+
+    std::chrono::nanoseconds duration{};
+    std::vector<Frame> frames;
+    /// Hash of VRAM and FCRAM after the replay, identical between replays of the same trace
+    u64 output_hash{};
+};
+
+/**
+ * Plays back a CiTrace on a PICA core. Each replay starts from the initial state stored in the
+ * trace and from zeroed memory, so that replays of the same trace are deterministic. Memory fills
+ * and display transfers are performed by the rasterizer if it accelerates them, by the software
+ * blitter otherwise.
+ */
+class Player {
+public:
+    /**
+     * @param memory Memory the PICA core reads from
+     * @param pica PICA core to replay the trace on
+     * @param rasterizer Rasterizer bound to the PICA core
+     */
+    Player(Memory::MemorySystem& memory, Pica::PicaCore& pica,
+           VideoCore::RasterizerInterface& rasterizer);
+    ~Player();
+
+    /// Loads a trace, returns false if the file is not a valid CiTrace.
+    bool Load(const std::string& filename);
+
+    /// Loads a trace from memory, returns false if the data is not a valid CiTrace.
+    bool Load(std::vector<u8> data);
+
+    /// Number of frames of the loaded trace
+    std::size_t GetFrameCount() const;
+
+    /// Replays the loaded trace once.
+    ReplayTimings Replay();
+
+private:
+    class TimingRasterizer;
+
+    /// Returns the words of an initial state block
+    std::vector<u32> GetInitialState(u32 offset, u32 size) const;
+
+    void ApplyInitialState();
+    void LoadMemory(const CTMemoryLoad& load);
+    void WriteRegister(u32 physical_address, u32 value);
+
+    Memory::MemorySystem& memory;
+    Pica::PicaCore& pica;
+    VideoCore::RasterizerInterface& rasterizer;
+    std::unique_ptr<TimingRasterizer> timing_rasterizer;
+    std::unique_ptr<SwRenderer::SwBlitter> sw_blitter;
+    Service::GSP::InterruptHandler interrupt_handler;
+
+    std::vector<u8> trace;
+    CTHeader header{};
+    std::vector<CTStreamElement> stream;
+};
+
+} // namespace CiTrace
@@ -2,13 +2,17 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <chrono>
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
 #include <cryptopp/base64.h>
+#include <fmt/format.h>
+#include <httplib.h>
 
 #ifdef _WIN32
 // windows.h needs to be included before shellapi.h
@@ -25,10 +29,12 @@
 #include "common/logging/log.h"
 #include "common/scm_rev.h"
 #include "common/string_util.h"
+#include "common/thread.h"
 #include "network/announce_multiplayer_session.h"
 #include "network/network.h"
 #include "network/network_settings.h"
 #include "network/room.h"
+#include "network/room_server.h"
 #include "network/verify_user.h"
 
 #ifdef ENABLE_WEB_SERVICE
@@ -57,6 +63,11 @@ static void PrintHelp(const char* argv0) {
                  "--ban-list-file     The file for storing the room ban list\n"
                  "--log-file          The file for storing the room log\n"
                  "--enable-citra-mods Allow Citra Community Moderators to moderate on your room\n"
+                 "--rooms             The number of rooms to host, on consecutive ports\n"
+                 "--threads           The number of threads servicing the rooms\n"
+                 "--rate-limit        The maximum number of packets per second of a member\n"
+                 "--admin-port        The local port of the HTTP metrics and admin endpoint\n"
+                 "--drain-timeout     Seconds to wait for members to leave before closing\n"
                  "-h, --help          Display this help and exit\n"
                  "-v, --version       Output version information and exit\n";
 }
@@ -149,6 +160,29 @@ static void SaveBanList(const Network::Room::BanList& ban_list, const std::strin
     file.flush();
 }
 
+/// Formats the statistics of the rooms in the Prometheus text format.
+static std::string FormatMetrics(const std::vector<std::shared_ptr<Network::Room>>& rooms) {
+    std::string metrics;
+    const auto add_metric = [&](const char* name, const char* type, auto get_value) {
+        metrics += fmt::format("# TYPE {} {}\n", name, type);
+        for (const auto& room : rooms) {
+            metrics += fmt::format("{}{{port=\"{}\"}} {}\n", name,
+                                   room->GetRoomInformation().port, get_value(*room));
+        }
+    };
+    add_metric("citra_room_members", "gauge",
+               [](const Network::Room& room) { return room.GetRoomMemberList().size(); });
+    add_metric("citra_room_packets_received_total", "counter",
+               [](const Network::Room& room) { return room.GetStats().packets_received; });
+    add_metric("citra_room_bytes_received_total", "counter",
+               [](const Network::Room& room) { return room.GetStats().bytes_received; });
+    add_metric("citra_room_packets_forwarded_total", "counter",
+               [](const Network::Room& room) { return room.GetStats().packets_forwarded; });
+    add_metric("citra_room_packets_dropped_total", "counter",
+               [](const Network::Room& room) { return room.GetStats().packets_dropped; });
+    return metrics;
+}
+
 static void InitializeLogging(const std::string& log_file) {
     Common::Log::Initialize(log_file);
     Common::Log::SetColorConsoleBackendEnabled(true);
@@ -174,6 +208,11 @@ int main(int argc, char** argv) {
     u16 port = Network::DefaultRoomPort;
     u32 max_members = 16;
     bool enable_citra_mods = false;
+    u32 num_rooms = 1;
+    u32 num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    u32 rate_limit = 0;
+    u16 admin_port = 0;
+    u32 drain_timeout = 0;
 
     static struct option long_options[] = {
         {"room-name", required_argument, 0, 'n'},
@@ -189,6 +228,11 @@ int main(int argc, char** argv) {
         {"ban-list-file", required_argument, 0, 'b'},
         {"log-file", required_argument, 0, 'l'},
         {"enable-citra-mods", no_argument, 0, 'e'},
+        {"rooms", required_argument, 0, 'r'},
+        {"threads", required_argument, 0, 'j'},
+        {"rate-limit", required_argument, 0, 'R'},
+        {"admin-port", required_argument, 0, 'A'},
+        {"drain-timeout", required_argument, 0, 'D'},
         {"help", no_argument, 0, 'h'},
         {"version", no_argument, 0, 'v'},
         {0, 0, 0, 0},
@@ -237,6 +281,21 @@ int main(int argc, char** argv) {
             case 'e':
                 enable_citra_mods = true;
                 break;
+            case 'r':
+                num_rooms = strtoul(optarg, &endarg, 0);
+                break;
+            case 'j':
+                num_threads = strtoul(optarg, &endarg, 0);
+                break;
+            case 'R':
+                rate_limit = strtoul(optarg, &endarg, 0);
+                break;
+            case 'A':
+                admin_port = static_cast<u16>(strtoul(optarg, &endarg, 0));
+                break;
+            case 'D':
+                drain_timeout = strtoul(optarg, &endarg, 0);
+                break;
             case 'h':
                 PrintHelp(argv[0]);
                 return 0;
@@ -272,6 +331,17 @@ int main(int argc, char** argv) {
         PrintHelp(argv[0]);
         return -1;
     }
+    if (num_rooms < 1 || port + num_rooms - 1 > 65535) {
+        std::cout << "rooms needs to be at least 1 and the ports of all rooms need to be in the "
+                     "range 0 - 65535!\n\n";
+        PrintHelp(argv[0]);
+        return -1;
+    }
+    if (num_threads < 1) {
+        std::cout << "threads needs to be at least 1!\n\n";
+        PrintHelp(argv[0]);
+        return -1;
+    }
     if (ban_list_file.empty()) {
         std::cout << "Ban list file not set!\nThis should get set to load and save room ban "
                      "list.\nSet with --ban-list-file <file>\n\n";
@@ -306,56 +376,117 @@ int main(int argc, char** argv) {
 
     InitializeLogging(log_file);
 
-    // Load the ban list
-    Network::Room::BanList ban_list;
+    // Load the ban list, which all the rooms share
+    auto ban_list = std::make_shared<Network::Room::SharedBanList>();
     if (!ban_list_file.empty()) {
-        ban_list = LoadBanList(ban_list_file);
+        ban_list->ban_list = LoadBanList(ban_list_file);
     }
 
-    std::unique_ptr<Network::VerifyUser::Backend> verify_backend;
-    if (announce) {
+    const auto create_verify_backend =
+        [announce]() -> std::unique_ptr<Network::VerifyUser::Backend> {
+        if (announce) {
 #ifdef ENABLE_WEB_SERVICE
-        verify_backend =
-            std::make_unique<WebService::VerifyUserJWT>(NetSettings::values.web_api_url);
+            return std::make_unique<WebService::VerifyUserJWT>(NetSettings::values.web_api_url);
 #else
+            return std::make_unique<Network::VerifyUser::NullBackend>();
+#endif
+        }
+        return std::make_unique<Network::VerifyUser::NullBackend>();
+    };
+#ifndef ENABLE_WEB_SERVICE
+    if (announce) {
         std::cout
             << "Citra Web Services is not available with this build: validation is disabled.\n\n";
-        verify_backend = std::make_unique<Network::VerifyUser::NullBackend>();
-#endif
-    } else {
-        verify_backend = std::make_unique<Network::VerifyUser::NullBackend>();
     }
+#endif
 
     Network::Init();
-    if (std::shared_ptr<Network::Room> room = Network::GetRoom().lock()) {
-        if (!room->Create(room_name, room_description, "", port, password, max_members, username,
-                          preferred_game, preferred_game_id, std::move(verify_backend), ban_list,
-                          enable_citra_mods)) {
-            std::cout << "Failed to create room: \n\n";
-            return -1;
-        }
-        std::cout << "Room is open. Close with Q+Enter...\n\n";
-        auto announce_session = std::make_unique<Network::AnnounceMultiplayerSession>();
-        if (announce) {
-            announce_session->Start();
+    {
+        Network::RoomServer server{num_threads};
+        std::vector<std::unique_ptr<Network::AnnounceMultiplayerSession>> announce_sessions;
+        for (u32 i = 0; i < num_rooms; i++) {
+            Network::RoomServer::RoomSettings settings;
+            settings.name = num_rooms > 1 ? fmt::format("{} {}", room_name, i + 1) : room_name;
+            settings.description = room_description;
+            settings.port = static_cast<u16>(port + i);
+            settings.password = password;
+            settings.max_members = max_members;
+            settings.host_username = username;
+            settings.preferred_game = preferred_game;
+            settings.preferred_game_id = preferred_game_id;
+            settings.shared_ban_list = ban_list;
+            settings.enable_citra_mods = enable_citra_mods;
+            settings.rate_limit = rate_limit;
+            const auto room = server.CreateRoom(settings, create_verify_backend());
+            if (!room) {
+                std::cout << "Failed to create room: \n\n";
+                return -1;
+            }
+            if (announce) {
+                auto& session = announce_sessions.emplace_back(
+                    std::make_unique<Network::AnnounceMultiplayerSession>(room));
+                session->Start();
+            }
         }
-        while (room->GetState() == Network::Room::State::Open) {
-            std::string in;
-            std::cin >> in;
-            if (in.size() > 0) {
-                break;
+
+        // Quits on Q+Enter or on a drain request of the admin endpoint
+        auto quit_event = std::make_shared<Common::Event>();
+        std::thread([quit_event] {
+            while (true) {
+                std::string in;
+                if (std::cin >> in && in.size() > 0) {
+                    quit_event->Set();
+                    return;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }).detach();
+
+        httplib::Server admin_server;
+        std::thread admin_thread;
+        if (admin_port != 0) {
+            admin_server.Get("/metrics",
+                             [&server](const httplib::Request&, httplib::Response& res) {
+                                 res.set_content(FormatMetrics(server.GetRooms()),
+                                                 "text/plain; version=0.0.4");
+                             });
+            admin_server.Post("/drain",
+                              [quit_event](const httplib::Request&, httplib::Response& res) {
+                                  quit_event->Set();
+                                  res.status = 202;
+                              });
+            if (!admin_server.bind_to_port("127.0.0.1", admin_port)) {
+                std::cout << "Failed to open the admin endpoint on port " << admin_port << "\n\n";
+                return -1;
+            }
+            admin_thread = std::thread([&admin_server] { admin_server.listen_after_bind(); });
         }
-        if (announce) {
-            announce_session->Stop();
+
+        if (num_rooms > 1) {
+            std::cout << num_rooms << " rooms are open on ports " << port << " - "
+                      << port + num_rooms - 1 << ". Close with Q+Enter...\n\n";
+        } else {
+            std::cout << "Room is open. Close with Q+Enter...\n\n";
         }
-        announce_session.reset();
-        // Save the ban list
+        quit_event->Wait();
+
+        for (auto& session : announce_sessions) {
+            session->Stop();
+        }
+        announce_sessions.clear();
+        if (drain_timeout > 0) {
+            std::cout << "Waiting for members to leave...\n\n";
+            server.Drain(std::chrono::seconds(drain_timeout));
+        }
+        // Save the ban list, including the bans made while draining
         if (!ban_list_file.empty()) {
-            SaveBanList(room->GetBanList(), ban_list_file);
+            std::lock_guard lock(ban_list->mutex);
+            SaveBanList(ban_list->ban_list, ban_list_file);
+        }
+        if (admin_thread.joinable()) {
+            admin_server.stop();
+            admin_thread.join();
         }
-        room->Destroy();
     }
     Network::Shutdown();
     detached_tasks.WaitForAllTasks();
@@ -8,6 +8,7 @@
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <set>
 #include <thread>
 #include "common/announce_multiplayer_room.h"
@@ -27,6 +28,8 @@ class AnnounceMultiplayerSession : NonCopyable {
 public:
     using CallbackHandle = std::shared_ptr<std::function<void(const Common::WebResult&)>>;
     AnnounceMultiplayerSession();
+    /// Creates a session that announces the given room instead of the one of Network::GetRoom
+    explicit AnnounceMultiplayerSession(std::weak_ptr<Room> room);
     ~AnnounceMultiplayerSession();
 
     /**
@@ -87,6 +90,10 @@ private:
 
     std::atomic_bool registered = false; ///< Whether the room has been registered
 
+    /// Room announced by the session, the one of Network::GetRoom when it is empty
+    std::optional<std::weak_ptr<Room>> announced_room;
+
+    std::shared_ptr<Room> GetAnnouncedRoom() const;
     void UpdateBackendData(std::shared_ptr<Network::Room> room);
     void AnnounceMultiplayerLoop();
 };
@@ -4,17 +4,28 @@
 
 #include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <cstring>
 #include <mutex>
 #include <random>
 #include <regex>
+#include <shared_mutex>
 #include <sstream>
 #include <thread>
+#include <unordered_map>
+#include <vector>
 #include "common/logging/log.h"
 #include "enet/enet.h"
 #include "network/packet.h"
 #include "network/room.h"
 #include "network/verify_user.h"
 
+#ifdef _WIN32
+#include <winsock2.h>
+#else
+#include <poll.h>
+#endif
+
 namespace Network {
 
 class Room::RoomImpl {
@@ -43,13 +54,16 @@ public:
         ENetPeer* peer; ///< The remote peer.
     };
     using MemberList = std::vector<Member>;
-    MemberList members;              ///< Information about the members of this room
-    mutable std::mutex member_mutex; ///< Mutex for locking the members list
-    /// This should be a std::shared_mutex as soon as C++17 is supported
+    MemberList members; ///< Information about the members of this room
+    /// Peers of the members by MAC address, used to route WiFi packets
+    std::unordered_map<MacAddress, ENetPeer*, MacAddressHash> peers_by_mac;
+    /// Lock for members and peers_by_mac, shared by the threads that only read them
+    mutable std::shared_mutex member_mutex;
 
-    UsernameBanList username_ban_list; ///< List of banned usernames
-    IPBanList ip_ban_list;             ///< List of banned IP addresses
-    mutable std::mutex ban_list_mutex; ///< Mutex for the ban lists
+    /// Ban lists of the room, which other rooms may share
+    std::shared_ptr<SharedBanList> ban_lists = std::make_shared<SharedBanList>();
+    /// Whether ban_lists was set by SetSharedBanList, in which case Create leaves it as it is
+    bool shares_ban_lists = false;
 
     RoomImpl()
         : NintendoOUI{0x00, 0x1F, 0x32, 0x00, 0x00, 0x00}, random_gen(std::random_device()()) {}
@@ -60,10 +74,36 @@ public:
     /// Verification backend of the room
     std::unique_ptr<VerifyUser::Backend> verify_backend;
 
+    /// Whether Create starts room_thread, otherwise the owner of the room services it
+    bool threaded = true;
+
+    /// Whether join requests are accepted, they are answered as if the room was full otherwise
+    std::atomic<bool> accepting_members{true};
+
+    std::atomic<u64> packets_received{0};
+    std::atomic<u64> bytes_received{0};
+    std::atomic<u64> packets_forwarded{0};
+    std::atomic<u64> packets_dropped{0};
+
+    struct RateLimiter {
+        double tokens; ///< Packets the peer can still send
+        std::chrono::steady_clock::time_point last_update; ///< Last time tokens were added
+    };
+    /// WiFi and chat packets a member can send per second, 0 for no limit
+    std::atomic<u32> rate_limit{0};
+    /// Rate limiting state of the peers, only used by the thread that services the room
+    std::unordered_map<const ENetPeer*, RateLimiter> rate_limiters;
+
     /// Thread function that will receive and dispatch messages until the room is destroyed.
     void ServerLoop();
     void StartLoop();
 
+    /// Dispatches a network event to its handler.
+    void HandleEvent(ENetEvent& event);
+
+    /// Returns whether the packet of a receive event exceeds the rate limit of its sender.
+    bool IsRateLimited(const ENetEvent& event);
+
     /**
      * Parses and answers a room join request from a client.
      * Validates the uniqueness of the username and assigns the MAC address
@@ -251,58 +291,95 @@ void Room::RoomImpl::ServerLoop() {
     while (state != State::Closed) {
         ENetEvent event;
         if (enet_host_service(server, &event, 16) > 0) {
-            switch (event.type) {
-            case ENET_EVENT_TYPE_RECEIVE:
-                switch (event.packet->data[0]) {
-                case IdJoinRequest:
-                    HandleJoinRequest(&event);
-                    break;
-                case IdSetGameInfo:
-                    HandleGameNamePacket(&event);
-                    break;
-                case IdWifiPacket:
-                    HandleWifiPacket(&event);
-                    break;
-                case IdChatMessage:
-                    HandleChatPacket(&event);
-                    break;
-                // Moderation
-                case IdModKick:
-                    HandleModKickPacket(&event);
-                    break;
-                case IdModBan:
-                    HandleModBanPacket(&event);
-                    break;
-                case IdModUnban:
-                    HandleModUnbanPacket(&event);
-                    break;
-                case IdModGetBanList:
-                    HandleModGetBanListPacket(&event);
-                    break;
-                }
-                enet_packet_destroy(event.packet);
-                break;
-            case ENET_EVENT_TYPE_DISCONNECT:
-                HandleClientDisconnection(event.peer);
-                break;
-            case ENET_EVENT_TYPE_NONE:
-            case ENET_EVENT_TYPE_CONNECT:
-                break;
-            }
+            HandleEvent(event);
         }
     }
     // Close the connection to all members:
     SendCloseMessage();
 }
 
+void Room::RoomImpl::HandleEvent(ENetEvent& event) {
+    switch (event.type) {
+    case ENET_EVENT_TYPE_RECEIVE:
+        packets_received.fetch_add(1, std::memory_order_relaxed);
+        bytes_received.fetch_add(event.packet->dataLength, std::memory_order_relaxed);
+        if (IsRateLimited(event)) {
+            packets_dropped.fetch_add(1, std::memory_order_relaxed);
+            enet_packet_destroy(event.packet);
+            break;
+        }
+        switch (event.packet->data[0]) {
+        case IdJoinRequest:
+            HandleJoinRequest(&event);
+            break;
+        case IdSetGameInfo:
+            HandleGameNamePacket(&event);
+            break;
+        case IdWifiPacket:
+            HandleWifiPacket(&event);
+            break;
+        case IdChatMessage:
+            HandleChatPacket(&event);
+            break;
+        // Moderation
+        case IdModKick:
+            HandleModKickPacket(&event);
+            break;
+        case IdModBan:
+            HandleModBanPacket(&event);
+            break;
+        case IdModUnban:
+            HandleModUnbanPacket(&event);
+            break;
+        case IdModGetBanList:
+            HandleModGetBanListPacket(&event);
+            break;
+        }
+        // Forwarded packets are destroyed by ENet once they were sent to every peer
+        if (event.packet->referenceCount == 0) {
+            enet_packet_destroy(event.packet);
+        }
+        break;
+    case ENET_EVENT_TYPE_DISCONNECT:
+        rate_limiters.erase(event.peer);
+        HandleClientDisconnection(event.peer);
+        break;
+    case ENET_EVENT_TYPE_NONE:
+    case ENET_EVENT_TYPE_CONNECT:
+        break;
+    }
+}
+
+bool Room::RoomImpl::IsRateLimited(const ENetEvent& event) {
+    const u32 limit = rate_limit.load(std::memory_order_relaxed);
+    const u8 type = event.packet->data[0];
+    if (limit == 0 || (type != IdWifiPacket && type != IdChatMessage)) {
+        return false;
+    }
+
+    // Token bucket holding up to one second worth of packets
+    const auto now = std::chrono::steady_clock::now();
+    auto& limiter =
+        rate_limiters.try_emplace(event.peer, RateLimiter{static_cast<double>(limit), now})
+            .first->second;
+    const double elapsed = std::chrono::duration<double>(now - limiter.last_update).count();
+    limiter.tokens = std::min<double>(limit, limiter.tokens + elapsed * limit);
+    limiter.last_update = now;
+    if (limiter.tokens < 1.0) {
+        return true;
+    }
+    limiter.tokens -= 1.0;
+    return false;
+}
+
 void Room::RoomImpl::StartLoop() {
     room_thread = std::make_unique<std::thread>(&Room::RoomImpl::ServerLoop, this);
 }
 
 void Room::RoomImpl::HandleJoinRequest(const ENetEvent* event) {
     {
-        std::lock_guard lock(member_mutex);
-        if (members.size() >= room_information.member_slots) {
+        std::shared_lock lock(member_mutex);
+        if (!accepting_members || members.size() >= room_information.member_slots) {
             SendRoomIsFull(event->peer);
             return;
         }
@@ -375,7 +452,8 @@ void Room::RoomImpl::HandleJoinRequest(const ENetEvent* event) {
 
     std::string ip;
     {
-        std::lock_guard lock(ban_list_mutex);
+        std::lock_guard lock(ban_lists->mutex);
+        auto& [username_ban_list, ip_ban_list] = ban_lists->ban_list;
 
         // Check username ban
         if (!member.user_data.username.empty() &&
@@ -402,6 +480,7 @@ void Room::RoomImpl::HandleJoinRequest(const ENetEvent* event) {
 
     {
         std::lock_guard lock(member_mutex);
+        peers_by_mac.emplace(member.mac_address, member.peer);
         members.push_back(std::move(member));
     }
 
@@ -448,6 +527,7 @@ void Room::RoomImpl::HandleModKickPacket(const ENetEvent* event) {
         ip = ip_raw;
 
         enet_peer_disconnect(target_member->peer, 0);
+        peers_by_mac.erase(target_member->mac_address);
         members.erase(target_member);
     }
 
@@ -491,11 +571,13 @@ void Room::RoomImpl::HandleModBanPacket(const ENetEvent* event) {
         ip = ip_raw;
 
         enet_peer_disconnect(target_member->peer, 0);
+        peers_by_mac.erase(target_member->mac_address);
         members.erase(target_member);
     }
 
     {
-        std::lock_guard lock(ban_list_mutex);
+        std::lock_guard lock(ban_lists->mutex);
+        auto& [username_ban_list, ip_ban_list] = ban_lists->ban_list;
 
         if (!username.empty()) {
             // Ban the forum username
@@ -532,7 +614,8 @@ void Room::RoomImpl::HandleModUnbanPacket(const ENetEvent* event) {
 
     bool unbanned = false;
     {
-        std::lock_guard lock(ban_list_mutex);
+        std::lock_guard lock(ban_lists->mutex);
+        auto& [username_ban_list, ip_ban_list] = ban_lists->ban_list;
 
         auto it = std::find(username_ban_list.begin(), username_ban_list.end(), address);
         if (it != username_ban_list.end()) {
@@ -570,28 +653,27 @@ bool Room::RoomImpl::IsValidNickname(const std::string& nickname) const {
     if (!std::regex_match(nickname, nickname_regex))
         return false;
 
-    std::lock_guard lock(member_mutex);
+    std::shared_lock lock(member_mutex);
     return std::all_of(members.begin(), members.end(),
                        [&nickname](const auto& member) { return member.nickname != nickname; });
 }
 
 bool Room::RoomImpl::IsValidMacAddress(const MacAddress& address) const {
     // A MAC address is valid if it is not already taken by anybody else in the room.
-    std::lock_guard lock(member_mutex);
-    return std::all_of(members.begin(), members.end(),
-                       [&address](const auto& member) { return member.mac_address != address; });
+    std::shared_lock lock(member_mutex);
+    return !peers_by_mac.contains(address);
 }
 
 bool Room::RoomImpl::IsValidConsoleId(const std::string& console_id_hash) const {
     // A Console ID is valid if it is not already taken by anybody else in the room.
-    std::lock_guard lock(member_mutex);
+    std::shared_lock lock(member_mutex);
     return std::all_of(members.begin(), members.end(), [&console_id_hash](const auto& member) {
         return member.console_id_hash != console_id_hash;
     });
 }
 
 bool Room::RoomImpl::HasModPermission(const ENetPeer* client) const {
-    std::lock_guard lock(member_mutex);
+    std::shared_lock lock(member_mutex);
     const auto sending_member =
         std::find_if(members.begin(), members.end(),
                      [client](const auto& member) { return member.peer == client; });
@@ -736,7 +818,8 @@ void Room::RoomImpl::SendModBanListResponse(ENetPeer* client) {
     Packet packet;
     packet << static_cast<u8>(IdModBanListResponse);
     {
-        std::lock_guard lock(ban_list_mutex);
+        std::lock_guard lock(ban_lists->mutex);
+        auto& [username_ban_list, ip_ban_list] = ban_lists->ban_list;
         packet << username_ban_list;
         packet << ip_ban_list;
     }
@@ -750,7 +833,7 @@ void Room::RoomImpl::SendModBanListResponse(ENetPeer* client) {
 void Room::RoomImpl::SendCloseMessage() {
     Packet packet;
     packet << static_cast<u8>(IdCloseRoom);
-    std::lock_guard lock(member_mutex);
+    std::shared_lock lock(member_mutex);
     if (!members.empty()) {
         ENetPacket* enet_packet =
             enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
@@ -771,7 +854,7 @@ void Room::RoomImpl::SendStatusMessage(StatusMessageTypes type, const std::strin
     packet << static_cast<u8>(type);
     packet << nickname;
     packet << username;
-    std::lock_guard lock(member_mutex);
+    std::shared_lock lock(member_mutex);
     if (!members.empty()) {
         ENetPacket* enet_packet =
             enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
@@ -815,7 +898,7 @@ void Room::RoomImpl::BroadcastRoomInformation() {
 
     packet << static_cast<u32>(members.size());
     {
-        std::lock_guard lock(member_mutex);
+        std::shared_lock lock(member_mutex);
         for (const auto& member : members) {
             packet << member.nickname;
             packet << member.mac_address;
@@ -846,48 +929,40 @@ MacAddress Room::RoomImpl::GenerateMacAddress() {
 }
 
 void Room::RoomImpl::HandleWifiPacket(const ENetEvent* event) {
-    Packet in_packet;
-    in_packet.Append(event->packet->data, event->packet->dataLength);
-    in_packet.IgnoreBytes(sizeof(u8));         // Message type
-    in_packet.IgnoreBytes(sizeof(u8));         // WifiPacket Type
-    in_packet.IgnoreBytes(sizeof(u8));         // WifiPacket Channel
-    in_packet.IgnoreBytes(sizeof(MacAddress)); // WifiPacket Transmitter Address
+    // Message type, WifiPacket type, channel and transmitter address precede the destination
+    constexpr std::size_t DestinationOffset = 3 * sizeof(u8) + sizeof(MacAddress);
+    ENetPacket* enet_packet = event->packet;
+    if (enet_packet->dataLength < DestinationOffset + sizeof(MacAddress)) {
+        LOG_ERROR(Network, "Received a truncated WifiPacket");
+        return;
+    }
     MacAddress destination_address;
-    in_packet >> destination_address;
+    std::memcpy(destination_address.data(), enet_packet->data + DestinationOffset,
+                sizeof(MacAddress));
 
-    Packet out_packet;
-    out_packet.Append(event->packet->data, event->packet->dataLength);
-    ENetPacket* enet_packet = enet_packet_create(out_packet.GetData(), out_packet.GetDataSize(),
-                                                 ENET_PACKET_FLAG_RELIABLE);
+    // The received packet is forwarded as is, ENet keeps it alive until every peer sent it
+    enet_packet->flags = ENET_PACKET_FLAG_RELIABLE;
 
     if (destination_address == BroadcastMac) { // Send the data to everyone except the sender
-        std::lock_guard lock(member_mutex);
-        bool sent_packet = false;
+        std::shared_lock lock(member_mutex);
         for (const auto& member : members) {
-            if (member.peer != event->peer) {
-                sent_packet = true;
-                enet_peer_send(member.peer, 0, enet_packet);
+            if (member.peer != event->peer && enet_peer_send(member.peer, 0, enet_packet) == 0) {
+                packets_forwarded.fetch_add(1, std::memory_order_relaxed);
             }
         }
-
-        if (!sent_packet) {
-            enet_packet_destroy(enet_packet);
-        }
     } else { // Send the data only to the destination client
-        std::lock_guard lock(member_mutex);
-        auto member = std::find_if(members.begin(), members.end(),
-                                   [destination_address](const Member& member) -> bool {
-                                       return member.mac_address == destination_address;
-                                   });
-        if (member != members.end()) {
-            enet_peer_send(member->peer, 0, enet_packet);
+        std::shared_lock lock(member_mutex);
+        const auto peer = peers_by_mac.find(destination_address);
+        if (peer != peers_by_mac.end()) {
+            if (enet_peer_send(peer->second, 0, enet_packet) == 0) {
+                packets_forwarded.fetch_add(1, std::memory_order_relaxed);
+            }
         } else {
             LOG_ERROR(Network,
                       "Attempting to send to unknown MAC address: "
                       "{:02X}:{:02X}:{:02X}:{:02X}:{:02X}:{:02X}",
                       destination_address[0], destination_address[1], destination_address[2],
                       destination_address[3], destination_address[4], destination_address[5]);
-            enet_packet_destroy(enet_packet);
         }
     }
     enet_host_flush(server);
@@ -904,7 +979,7 @@ void Room::RoomImpl::HandleChatPacket(const ENetEvent* event) {
         return member.peer == event->peer;
     };
 
-    std::lock_guard lock(member_mutex);
+    std::shared_lock lock(member_mutex);
     const auto sending_member = std::find_if(members.begin(), members.end(), CompareNetworkAddress);
     if (sending_member == members.end()) {
         return; // Received a chat message from a unknown sender
@@ -992,6 +1067,7 @@ void Room::RoomImpl::HandleClientDisconnection(ENetPeer* client) {
             enet_address_get_host_ip(&member->peer->address, ip_raw, sizeof(ip_raw) - 1);
             ip = ip_raw;
 
+            peers_by_mac.erase(member->mac_address);
             members.erase(member);
         }
     }
@@ -1028,6 +1104,10 @@ bool Room::Create(const std::string& name, const std::string& description,
         return false;
     }
     room_impl->state = State::Open;
+    room_impl->packets_received = 0;
+    room_impl->bytes_received = 0;
+    room_impl->packets_forwarded = 0;
+    room_impl->packets_dropped = 0;
 
     room_impl->room_information.name = name;
     room_impl->room_information.description = description;
@@ -1039,10 +1119,14 @@ bool Room::Create(const std::string& name, const std::string& description,
     room_impl->room_information.enable_citra_mods = enable_citra_mods;
     room_impl->password = password;
     room_impl->verify_backend = std::move(verify_backend);
-    room_impl->username_ban_list = ban_list.first;
-    room_impl->ip_ban_list = ban_list.second;
+    if (!room_impl->shares_ban_lists) {
+        std::lock_guard lock(room_impl->ban_lists->mutex);
+        room_impl->ban_lists->ban_list = ban_list;
+    }
 
-    room_impl->StartLoop();
+    if (room_impl->threaded) {
+        room_impl->StartLoop();
+    }
     return true;
 }
 
@@ -1054,19 +1138,28 @@ const RoomInformation& Room::GetRoomInformation() const {
     return room_impl->room_information;
 }
 
+Room::Stats Room::GetStats() const {
+    Stats stats;
+    stats.packets_received = room_impl->packets_received.load(std::memory_order_relaxed);
+    stats.bytes_received = room_impl->bytes_received.load(std::memory_order_relaxed);
+    stats.packets_forwarded = room_impl->packets_forwarded.load(std::memory_order_relaxed);
+    stats.packets_dropped = room_impl->packets_dropped.load(std::memory_order_relaxed);
+    return stats;
+}
+
 std::string Room::GetVerifyUID() const {
     std::lock_guard lock(room_impl->verify_UID_mutex);
     return room_impl->verify_UID;
 }
 
 Room::BanList Room::GetBanList() const {
-    std::lock_guard lock(room_impl->ban_list_mutex);
-    return {room_impl->username_ban_list, room_impl->ip_ban_list};
+    std::lock_guard lock(room_impl->ban_lists->mutex);
+    return room_impl->ban_lists->ban_list;
 }
 
 std::vector<Room::Member> Room::GetRoomMemberList() const {
     std::vector<Room::Member> member_list;
-    std::lock_guard lock(room_impl->member_mutex);
+    std::shared_lock lock(room_impl->member_mutex);
     for (const auto& member_impl : room_impl->members) {
         Member member;
         member.nickname = member_impl.nickname;
@@ -1089,10 +1182,70 @@ void Room::SetVerifyUID(const std::string& uid) {
     room_impl->verify_UID = uid;
 }
 
+void Room::SetSharedBanList(std::shared_ptr<SharedBanList> ban_lists) {
+    room_impl->ban_lists = std::move(ban_lists);
+    room_impl->shares_ban_lists = true;
+}
+
+void Room::SetThreaded(bool threaded) {
+    room_impl->threaded = threaded;
+}
+
+void Room::SetRateLimit(u32 packets_per_second) {
+    room_impl->rate_limit = packets_per_second;
+}
+
+void Room::SetAcceptingMembers(bool accepting) {
+    room_impl->accepting_members = accepting;
+}
+
+bool Room::ServiceEvents(std::size_t max_events) {
+    if (room_impl->state == State::Closed) {
+        return false;
+    }
+    ENetEvent event;
+    for (std::size_t i = 0; i < max_events; i++) {
+        if (enet_host_service(room_impl->server, &event, 0) <= 0) {
+            return false;
+        }
+        room_impl->HandleEvent(event);
+    }
+    return true;
+}
+
+void Room::WaitForEvents(std::span<Room* const> rooms, std::chrono::milliseconds timeout) {
+    // ENet's socket sets are fd_sets, which cannot hold sockets numbered FD_SETSIZE or above.
+    std::vector<pollfd> sockets;
+    sockets.reserve(rooms.size());
+    for (const Room* room : rooms) {
+        if (room->room_impl->server) {
+            pollfd socket{};
+            socket.fd = room->room_impl->server->socket;
+            socket.events = POLLIN;
+            sockets.push_back(socket);
+        }
+    }
+    if (sockets.empty()) {
+        std::this_thread::sleep_for(timeout);
+        return;
+    }
+#ifdef _WIN32
+    WSAPoll(sockets.data(), static_cast<ULONG>(sockets.size()), static_cast<INT>(timeout.count()));
+#else
+    poll(sockets.data(), static_cast<nfds_t>(sockets.size()), static_cast<int>(timeout.count()));
+#endif
+}
+
 void Room::Destroy() {
     room_impl->state = State::Closed;
-    room_impl->room_thread->join();
-    room_impl->room_thread.reset();
+    if (room_impl->room_thread) {
+        room_impl->room_thread->join();
+        room_impl->room_thread.reset();
+    } else if (room_impl->server) {
+        room_impl->SendCloseMessage();
+    }
+    room_impl->rate_limiters.clear();
+    room_impl->accepting_members = true;
 
     if (room_impl->server) {
         enet_host_destroy(room_impl->server);
@@ -1102,6 +1255,7 @@ void Room::Destroy() {
     {
         std::lock_guard lock(room_impl->member_mutex);
         room_impl->members.clear();
+        room_impl->peers_by_mac.clear();
     }
     room_impl->room_information.member_slots = 0;
     room_impl->room_information.name.clear();
@@ -5,7 +5,12 @@
 #pragma once
 
 #include <array>
+#include <chrono>
+#include <cstring>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <span>
 #include <string>
 #include <vector>
 #include "common/common_types.h"
@@ -41,6 +46,15 @@ struct GameInfo {
 };
 
 using MacAddress = std::array<u8, 6>;
+
+/// Hash of a MAC address, for use as a key of unordered containers
+struct MacAddressHash {
+    std::size_t operator()(const MacAddress& address) const noexcept {
+        u64 value = 0;
+        std::memcpy(&value, address.data(), address.size());
+        return std::hash<u64>{}(value);
+    }
+};
 /// A special MAC address that tells the room we're joining to assign us a MAC address
 /// automatically.
 constexpr MacAddress NoPreferredMac = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
@@ -104,6 +118,14 @@ public:
         MacAddress mac_address;   ///< The assigned mac address of the member.
     };
 
+    /// Traffic of the room since it was created
+    struct Stats {
+        u64 packets_received;  ///< Packets received from members
+        u64 bytes_received;    ///< Bytes received from members
+        u64 packets_forwarded; ///< WiFi packets forwarded to other members
+        u64 packets_dropped;   ///< Packets dropped because a member exceeded the rate limit
+    };
+
     Room();
     ~Room();
 
@@ -117,6 +139,11 @@ public:
      */
     const RoomInformation& GetRoomInformation() const;
 
+    /**
+     * Gets the traffic statistics of the room.
+     */
+    Stats GetStats() const;
+
     /**
      * Gets the verify UID of this room.
      */
@@ -137,6 +164,12 @@ public:
 
     using BanList = std::pair<UsernameBanList, IPBanList>;
 
+    /// Ban list shared by several rooms, so that bans and unbans made in one apply to all of them
+    struct SharedBanList {
+        BanList ban_list;
+        std::mutex mutex;
+    };
+
     /**
      * Creates the socket for this room. Will bind to default address if
      * server is empty string.
@@ -160,6 +193,46 @@ public:
      */
     BanList GetBanList() const;
 
+    /**
+     * Makes the room use a ban list shared with other rooms instead of its own. Create then leaves
+     * the shared list as it is. Must be called before Create.
+     */
+    void SetSharedBanList(std::shared_ptr<SharedBanList> ban_lists);
+
+    /**
+     * Sets whether Create starts a thread that services the room, which is the default. Rooms
+     * without a thread have to be serviced by their owner with WaitForEvents and ServiceEvents,
+     * and destroyed from the thread that services them. Must be called before Create.
+     */
+    void SetThreaded(bool threaded);
+
+    /**
+     * Limits the WiFi and chat packets each member can send, packets above the limit are dropped.
+     * @param packets_per_second Packets a member can send per second on average, 0 for no limit.
+     * Members can send up to one second worth of packets at once.
+     */
+    void SetRateLimit(u32 packets_per_second);
+
+    /**
+     * Sets whether new members can join. Join requests are answered as if the room was full while
+     * it does not accept members, which lets a room be drained before it is closed.
+     */
+    void SetAcceptingMembers(bool accepting);
+
+    /**
+     * Handles the pending network events of a room without a thread, without blocking. At most
+     * max_events are handled, so that a busy room does not delay the others serviced by the same
+     * thread.
+     * @returns Whether events may still be pending
+     */
+    bool ServiceEvents(std::size_t max_events);
+
+    /**
+     * Waits until one of the rooms received data or the timeout expired. Used to service many
+     * rooms without a thread from a single thread.
+     */
+    static void WaitForEvents(std::span<Room* const> rooms, std::chrono::milliseconds timeout);
+
     /**
      * Destroys the socket
      */
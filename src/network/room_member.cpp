@@ -3,12 +3,16 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <array>
 #include <atomic>
-#include <list>
+#include <chrono>
+#include <deque>
 #include <mutex>
 #include <set>
 #include <thread>
 #include "common/assert.h"
+#include "common/bounded_threadsafe_queue.h"
+#include "common/logging/log.h"
 #include "enet/enet.h"
 #include "network/packet.h"
 #include "network/room_member.h"
@@ -17,6 +21,16 @@ namespace Network {
 
 constexpr u32 ConnectionTimeoutMs = 5000;
 
+/// Longest time the member loop waits for events, ENet has to be serviced regularly to resend
+/// packets and keep the connection alive
+constexpr u32 ServiceIntervalMs = 16;
+
+/// Number of packets that can wait to be sent by the member loop
+constexpr std::size_t SendQueueCapacity = 1024;
+
+/// Minimum time between two warnings about dropped WiFi packets
+constexpr std::chrono::seconds DroppedPacketsLogInterval{1};
+
 class RoomMember::RoomMemberImpl {
 public:
     ENetHost* client = nullptr; ///< ENet network interface.
@@ -45,8 +59,28 @@ public:
     std::mutex network_mutex; ///< Mutex that controls access to the `client` variable.
     /// Thread that receives and dispatches network packets
     std::unique_ptr<std::thread> loop_thread;
-    std::mutex send_list_mutex;  ///< Mutex that controls access to the `send_list` variable.
-    std::list<Packet> send_list; ///< A list that stores all packets to send the async
+    /// Packets waiting to be sent by the loop thread
+    Common::MPSCQueue<Packet, SendQueueCapacity> send_queue;
+    /// Packets other than WiFi packets that did not fit in send_queue, which are never dropped.
+    /// They are sent after the packets of send_queue.
+    std::deque<Packet> overflow_queue;
+    std::mutex overflow_mutex; ///< Mutex for overflow_queue
+    /// Whether overflow_queue holds packets, WiFi packets are dropped until it is sent so that
+    /// they do not overtake them
+    std::atomic<bool> overflowed{false};
+    /// WiFi packets dropped since the last warning about them
+    std::atomic<u64> dropped_packets{0};
+    /// Time of that warning, only used by the loop thread
+    std::chrono::steady_clock::time_point last_drop_log{};
+
+    /// Loopback socket that Send writes to, to wake up the loop thread while it waits for packets
+    ENetSocket wake_socket = ENET_SOCKET_NULL;
+    ENetAddress wake_address{}; ///< Address wake_socket is bound to
+    /// Whether a wake up is pending, so that only one is sent for a burst of packets
+    std::atomic<bool> wake_pending{false};
+
+    RoomMemberImpl();
+    ~RoomMemberImpl();
 
     template <typename T>
     using CallbackSet = std::set<CallbackHandle<T>>;
@@ -72,11 +106,27 @@ public:
 
     void StartLoop();
 
+    /// Waits until the server sent data, a packet was queued, or the service interval passed.
+    void WaitForEvents();
+
+    /// Wakes up the loop thread if it is waiting for events.
+    void WakeUp();
+
+    /// Discards the wake ups received by wake_socket.
+    void ClearWakeUps();
+
+    /// Dispatches a network event to its handler.
+    void HandleEvent(const ENetEvent& event);
+
     /**
      * Sends data to the room. It will be send on channel 0 with flag RELIABLE
      * @param packet The data to send
+     * @param droppable Whether the packet is dropped when the send queue is full, which is only
+     * the case for WiFi packets. Other packets are queued in overflow_queue instead, and WiFi
+     * packets are dropped until it is sent.
+     * @returns false if the packet was dropped
      */
-    void Send(Packet&& packet);
+    bool Send(Packet&& packet, bool droppable = false);
 
     /**
      * Sends a request to the server, asking for permission to join a room with the specified
@@ -155,126 +205,224 @@ bool RoomMember::RoomMemberImpl::IsConnected() const {
     return state == State::Joining || state == State::Joined || state == State::Moderator;
 }
 
+RoomMember::RoomMemberImpl::RoomMemberImpl() {
+    wake_socket = enet_socket_create(ENET_SOCKET_TYPE_DATAGRAM);
+    if (wake_socket == ENET_SOCKET_NULL) {
+        LOG_WARNING(Network, "Could not create the wake up socket, polling for packets to send");
+        return;
+    }
+    enet_address_set_host(&wake_address, "127.0.0.1");
+    wake_address.port = 0;
+    if (enet_socket_bind(wake_socket, &wake_address) != 0 ||
+        enet_socket_get_address(wake_socket, &wake_address) != 0 ||
+        enet_socket_set_option(wake_socket, ENET_SOCKOPT_NONBLOCK, 1) != 0) {
+        LOG_WARNING(Network, "Could not bind the wake up socket, polling for packets to send");
+        enet_socket_destroy(wake_socket);
+        wake_socket = ENET_SOCKET_NULL;
+    }
+}
+
+RoomMember::RoomMemberImpl::~RoomMemberImpl() {
+    if (wake_socket != ENET_SOCKET_NULL) {
+        enet_socket_destroy(wake_socket);
+    }
+}
+
 void RoomMember::RoomMemberImpl::MemberLoop() {
     // Receive packets while the connection is open
     while (IsConnected()) {
+        WaitForEvents();
+
         std::lock_guard network_lock(network_mutex);
+        // Wake ups sent from now on are for packets that are not popped below
+        wake_pending = false;
+        ClearWakeUps();
+
         ENetEvent event;
-        if (enet_host_service(client, &event, 16) > 0) {
-            switch (event.type) {
-            case ENET_EVENT_TYPE_RECEIVE:
-                switch (event.packet->data[0]) {
-                case IdWifiPacket:
-                    HandleWifiPackets(&event);
-                    break;
-                case IdChatMessage:
-                    HandleChatPacket(&event);
-                    break;
-                case IdStatusMessage:
-                    HandleStatusMessagePacket(&event);
-                    break;
-                case IdRoomInformation:
-                    HandleRoomInformationPacket(&event);
-                    break;
-                case IdJoinSuccess:
-                case IdJoinSuccessAsMod:
-                    // The join request was successful, we are now in the room.
-                    // If we joined successfully, there must be at least one client in the room: us.
-                    ASSERT_MSG(member_information.size() > 0,
-                               "We have not yet received member information.");
-                    HandleJoinPacket(&event); // Get the MAC Address for the client
-                    if (event.packet->data[0] == IdJoinSuccessAsMod) {
-                        SetState(State::Moderator);
-                    } else {
-                        SetState(State::Joined);
-                    }
-                    break;
-                case IdModBanListResponse:
-                    HandleModBanListResponsePacket(&event);
-                    break;
-                case IdRoomIsFull:
-                    SetState(State::Idle);
-                    SetError(Error::RoomIsFull);
-                    break;
-                case IdNameCollision:
-                    SetState(State::Idle);
-                    SetError(Error::NameCollision);
-                    break;
-                case IdMacCollision:
-                    SetState(State::Idle);
-                    SetError(Error::MacCollision);
-                    break;
-                case IdConsoleIdCollision:
-                    SetState(State::Idle);
-                    SetError(Error::ConsoleIdCollision);
-                    break;
-                case IdVersionMismatch:
-                    SetState(State::Idle);
-                    SetError(Error::WrongVersion);
-                    break;
-                case IdWrongPassword:
-                    SetState(State::Idle);
-                    SetError(Error::WrongPassword);
-                    break;
-                case IdCloseRoom:
-                    SetState(State::Idle);
-                    SetError(Error::LostConnection);
-                    break;
-                case IdHostKicked:
-                    SetState(State::Idle);
-                    SetError(Error::HostKicked);
-                    break;
-                case IdHostBanned:
-                    SetState(State::Idle);
-                    SetError(Error::HostBanned);
-                    break;
-                case IdModPermissionDenied:
-                    SetError(Error::PermissionDenied);
-                    break;
-                case IdModNoSuchUser:
-                    SetError(Error::NoSuchUser);
-                    break;
-                }
-                enet_packet_destroy(event.packet);
-                break;
-            case ENET_EVENT_TYPE_DISCONNECT:
-                if (state == State::Joined || state == State::Moderator) {
-                    SetState(State::Idle);
-                    SetError(Error::LostConnection);
-                }
-                break;
-            case ENET_EVENT_TYPE_NONE:
-                break;
-            case ENET_EVENT_TYPE_CONNECT:
-                // The ENET_EVENT_TYPE_CONNECT event can not possibly happen here because we're
-                // already connected
-                ASSERT_MSG(false, "Received unexpected connect event while already connected");
-                break;
-            }
+        while (IsConnected() && enet_host_service(client, &event, 0) > 0) {
+            HandleEvent(event);
         }
 
-        std::list<Packet> packets;
-        {
-            std::lock_guard send_list_lock(send_list_mutex);
-            packets.swap(send_list);
-        }
-        for (const auto& packet : packets) {
+        // All queued packets are flushed at once, ENet bundles them into as few datagrams as
+        // possible
+        Packet packet;
+        while (send_queue.TryPop(packet)) {
             ENetPacket* enetPacket = enet_packet_create(packet.GetData(), packet.GetDataSize(),
                                                         ENET_PACKET_FLAG_RELIABLE);
             enet_peer_send(server, 0, enetPacket);
         }
+        {
+            std::scoped_lock lock{overflow_mutex};
+            for (const auto& overflow_packet : overflow_queue) {
+                ENetPacket* enetPacket =
+                    enet_packet_create(overflow_packet.GetData(), overflow_packet.GetDataSize(),
+                                       ENET_PACKET_FLAG_RELIABLE);
+                enet_peer_send(server, 0, enetPacket);
+            }
+            overflow_queue.clear();
+            overflowed = false;
+        }
         enet_host_flush(client);
+
+        // A game keeps sending while the queue is full, the drops are reported once per interval
+        const auto now = std::chrono::steady_clock::now();
+        if (dropped_packets != 0 && now - last_drop_log >= DroppedPacketsLogInterval) {
+            LOG_WARNING(Network, "Send queue is full, dropped {} WiFi packets",
+                        dropped_packets.exchange(0));
+            last_drop_log = now;
+        }
     }
     Disconnect();
 };
 
+void RoomMember::RoomMemberImpl::WaitForEvents() {
+    ENetSocketSet set;
+    ENET_SOCKETSET_EMPTY(set);
+    ENET_SOCKETSET_ADD(set, client->socket);
+    ENetSocket max_socket = client->socket;
+    if (wake_socket != ENET_SOCKET_NULL) {
+        ENET_SOCKETSET_ADD(set, wake_socket);
+        max_socket = std::max(max_socket, wake_socket);
+    }
+    enet_socketset_select(max_socket, &set, nullptr, ServiceIntervalMs);
+}
+
+void RoomMember::RoomMemberImpl::WakeUp() {
+    if (wake_socket == ENET_SOCKET_NULL || wake_pending.exchange(true)) {
+        return;
+    }
+    u8 data = 0;
+    ENetBuffer buffer{};
+    buffer.data = &data;
+    buffer.dataLength = sizeof(data);
+    enet_socket_send(wake_socket, &wake_address, &buffer, 1);
+}
+
+void RoomMember::RoomMemberImpl::ClearWakeUps() {
+    if (wake_socket == ENET_SOCKET_NULL) {
+        return;
+    }
+    std::array<u8, 16> data;
+    ENetBuffer buffer{};
+    buffer.data = data.data();
+    buffer.dataLength = data.size();
+    while (enet_socket_receive(wake_socket, nullptr, &buffer, 1) > 0) {
+    }
+}
+
+void RoomMember::RoomMemberImpl::HandleEvent(const ENetEvent& event) {
+    switch (event.type) {
+    case ENET_EVENT_TYPE_RECEIVE:
+        switch (event.packet->data[0]) {
+        case IdWifiPacket:
+            HandleWifiPackets(&event);
+            break;
+        case IdChatMessage:
+            HandleChatPacket(&event);
+            break;
+        case IdStatusMessage:
+            HandleStatusMessagePacket(&event);
+            break;
+        case IdRoomInformation:
+            HandleRoomInformationPacket(&event);
+            break;
+        case IdJoinSuccess:
+        case IdJoinSuccessAsMod:
+            // The join request was successful, we are now in the room.
+            // If we joined successfully, there must be at least one client in the room: us.
+            ASSERT_MSG(member_information.size() > 0,
+                       "We have not yet received member information.");
+            HandleJoinPacket(&event); // Get the MAC Address for the client
+            if (event.packet->data[0] == IdJoinSuccessAsMod) {
+                SetState(State::Moderator);
+            } else {
+                SetState(State::Joined);
+            }
+            break;
+        case IdModBanListResponse:
+            HandleModBanListResponsePacket(&event);
+            break;
+        case IdRoomIsFull:
+            SetState(State::Idle);
+            SetError(Error::RoomIsFull);
+            break;
+        case IdNameCollision:
+            SetState(State::Idle);
+            SetError(Error::NameCollision);
+            break;
+        case IdMacCollision:
+            SetState(State::Idle);
+            SetError(Error::MacCollision);
+            break;
+        case IdConsoleIdCollision:
+            SetState(State::Idle);
+            SetError(Error::ConsoleIdCollision);
+            break;
+        case IdVersionMismatch:
+            SetState(State::Idle);
+            SetError(Error::WrongVersion);
+            break;
+        case IdWrongPassword:
+            SetState(State::Idle);
+            SetError(Error::WrongPassword);
+            break;
+        case IdCloseRoom:
+            SetState(State::Idle);
+            SetError(Error::LostConnection);
+            break;
+        case IdHostKicked:
+            SetState(State::Idle);
+            SetError(Error::HostKicked);
+            break;
+        case IdHostBanned:
+            SetState(State::Idle);
+            SetError(Error::HostBanned);
+            break;
+        case IdModPermissionDenied:
+            SetError(Error::PermissionDenied);
+            break;
+        case IdModNoSuchUser:
+            SetError(Error::NoSuchUser);
+            break;
+        }
+        enet_packet_destroy(event.packet);
+        break;
+    case ENET_EVENT_TYPE_DISCONNECT:
+        if (state == State::Joined || state == State::Moderator) {
+            SetState(State::Idle);
+            SetError(Error::LostConnection);
+        }
+        break;
+    case ENET_EVENT_TYPE_NONE:
+        break;
+    case ENET_EVENT_TYPE_CONNECT:
+        // The ENET_EVENT_TYPE_CONNECT event can not possibly happen here because we're
+        // already connected
+        ASSERT_MSG(false, "Received unexpected connect event while already connected");
+        break;
+    }
+}
+
 void RoomMember::RoomMemberImpl::StartLoop() {
     loop_thread = std::make_unique<std::thread>(&RoomMember::RoomMemberImpl::MemberLoop, this);
 }
 
-void RoomMember::RoomMemberImpl::Send(Packet&& packet) {
-    std::lock_guard lock(send_list_mutex);
-    send_list.push_back(std::move(packet));
+bool RoomMember::RoomMemberImpl::Send(Packet&& packet, bool droppable) {
+    if (droppable) {
+        if (overflowed || !send_queue.TryEmplace(std::move(packet))) {
+            dropped_packets++;
+            return false;
+        }
+    } else {
+        std::scoped_lock lock{overflow_mutex};
+        // Once a packet overflowed, the following ones go after it to keep their order
+        if (!overflow_queue.empty() || !send_queue.TryEmplace(std::move(packet))) {
+            overflow_queue.push_back(std::move(packet));
+            overflowed = true;
+        }
+    }
+    WakeUp();
+    return true;
 }
 
 void RoomMember::RoomMemberImpl::SendJoinRequest(const std::string& nickname,
@@ -586,7 +734,7 @@ bool RoomMember::IsConnected() const {
     return room_member_impl->IsConnected();
 }
 
-void RoomMember::SendWifiPacket(const WifiPacket& wifi_packet) {
+bool RoomMember::SendWifiPacket(const WifiPacket& wifi_packet) {
     Packet packet;
     packet << static_cast<u8>(IdWifiPacket);
     packet << static_cast<u8>(wifi_packet.type);
@@ -594,7 +742,7 @@ void RoomMember::SendWifiPacket(const WifiPacket& wifi_packet) {
     packet << wifi_packet.transmitter_address;
     packet << wifi_packet.destination_address;
     packet << wifi_packet.data;
-    room_member_impl->Send(std::move(packet));
+    return room_member_impl->Send(std::move(packet), true);
 }
 
 void RoomMember::SendChatMessage(const std::string& message) {
@@ -680,9 +828,19 @@ void RoomMember::Unbind(CallbackHandle<T> handle) {
 
 void RoomMember::Leave() {
     room_member_impl->SetState(State::Idle);
+    room_member_impl->WakeUp();
     room_member_impl->loop_thread->join();
     room_member_impl->loop_thread.reset();
 
+    // Packets that were not sent before leaving must not be sent to the next room
+    Packet packet;
+    while (room_member_impl->send_queue.TryPop(packet)) {
+    }
+    {
+        std::scoped_lock lock{room_member_impl->overflow_mutex};
+        room_member_impl->overflow_queue.clear();
+    }
+
     enet_host_destroy(room_member_impl->client);
     room_member_impl->client = nullptr;
 }
@@ -167,10 +167,12 @@ public:
               const std::string& password = "", const std::string& token = "");
 
     /**
-     * Sends a WiFi packet to the room.
+     * Sends a WiFi packet to the room. WiFi packets are dropped when too many are waiting to be
+     * sent, like they would be over the air. Other packets are never dropped.
      * @param packet The WiFi packet to send.
+     * @returns false if the packet was dropped
      */
-    void SendWifiPacket(const WifiPacket& packet);
+    bool SendWifiPacket(const WifiPacket& packet);
 
     /**
      * Sends a chat message to the room.
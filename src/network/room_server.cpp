@@ -0,0 +1,176 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "common/logging/log.h"
+#include "common/thread.h"
+#include "network/room_server.h"
+
+namespace Network {
+
+/// Longest time a shard waits for packets, ENet has to be serviced regularly to resend packets
+constexpr std::chrono::milliseconds ServiceInterval{16};
+
+/// Events handled per room before moving on to the next room of the shard
+constexpr std::size_t EventsPerPass = 64;
+
+struct RoomServer::Shard {
+    std::mutex mutex;
+    std::condition_variable rooms_closed;
+    std::vector<std::shared_ptr<Room>> rooms;
+    /// Rooms to close from the thread of the shard, which is the only one that may destroy them
+    std::vector<std::shared_ptr<Room>> closing_rooms;
+    bool rooms_changed = false;
+    std::jthread thread;
+};
+
+RoomServer::RoomServer(std::size_t num_threads) {
+    for (std::size_t i = 0; i < std::max<std::size_t>(num_threads, 1); i++) {
+        auto& shard = *shards.emplace_back(std::make_unique<Shard>());
+        shard.thread = std::jthread(
+            [this, &shard](std::stop_token stop_token) { ShardLoop(shard, stop_token); });
+    }
+}
+
+RoomServer::~RoomServer() {
+    // The threads close their remaining rooms when they stop
+    shards.clear();
+}
+
+std::shared_ptr<Room> RoomServer::CreateRoom(const RoomSettings& settings,
+                                             std::unique_ptr<VerifyUser::Backend> verify_backend) {
+    auto room = std::make_shared<Room>();
+    room->SetThreaded(false);
+    room->SetRateLimit(settings.rate_limit);
+    if (settings.shared_ban_list) {
+        room->SetSharedBanList(settings.shared_ban_list);
+    }
+    if (!room->Create(settings.name, settings.description, settings.server_address, settings.port,
+                      settings.password, settings.max_members, settings.host_username,
+                      settings.preferred_game, settings.preferred_game_id,
+                      std::move(verify_backend), settings.ban_list, settings.enable_citra_mods)) {
+        LOG_ERROR(Network, "Failed to create room {} on port {}", settings.name, settings.port);
+        return nullptr;
+    }
+
+    Shard* least_loaded = nullptr;
+    std::size_t least_rooms = 0;
+    for (auto& shard : shards) {
+        std::scoped_lock lock{shard->mutex};
+        if (!least_loaded || shard->rooms.size() < least_rooms) {
+            least_loaded = shard.get();
+            least_rooms = shard->rooms.size();
+        }
+    }
+    std::scoped_lock lock{least_loaded->mutex};
+    least_loaded->rooms.push_back(room);
+    least_loaded->rooms_changed = true;
+    return room;
+}
+
+void RoomServer::CloseRoom(const std::shared_ptr<Room>& room) {
+    for (auto& shard : shards) {
+        std::unique_lock lock{shard->mutex};
+        const auto it = std::find(shard->rooms.begin(), shard->rooms.end(), room);
+        if (it == shard->rooms.end()) {
+            continue;
+        }
+        shard->rooms.erase(it);
+        shard->closing_rooms.push_back(room);
+        shard->rooms_changed = true;
+        shard->rooms_closed.wait(lock, [&shard] { return shard->closing_rooms.empty(); });
+        return;
+    }
+}
+
+std::vector<std::shared_ptr<Room>> RoomServer::GetRooms() const {
+    std::vector<std::shared_ptr<Room>> rooms;
+    for (const auto& shard : shards) {
+        std::scoped_lock lock{shard->mutex};
+        rooms.insert(rooms.end(), shard->rooms.begin(), shard->rooms.end());
+    }
+    return rooms;
+}
+
+bool RoomServer::Drain(std::chrono::milliseconds timeout) {
+    const auto rooms = GetRooms();
+    for (const auto& room : rooms) {
+        room->SetAcceptingMembers(false);
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    bool drained = false;
+    while (true) {
+        drained = std::all_of(rooms.begin(), rooms.end(),
+                              [](const auto& room) { return room->GetRoomMemberList().empty(); });
+        if (drained || std::chrono::steady_clock::now() >= deadline) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    if (!drained) {
+        LOG_WARNING(Network, "Closing rooms that still have members after the drain timeout");
+    }
+
+    for (const auto& room : rooms) {
+        CloseRoom(room);
+    }
+    return drained;
+}
+
+void RoomServer::ShardLoop(Shard& shard, std::stop_token stop_token) {
+    Common::SetCurrentThreadName("RoomServer");
+    std::vector<std::shared_ptr<Room>> rooms;
+    std::vector<Room*> room_pointers;
+    bool events_pending = false;
+    while (!stop_token.stop_requested()) {
+        {
+            std::scoped_lock lock{shard.mutex};
+            if (!shard.closing_rooms.empty()) {
+                for (const auto& room : shard.closing_rooms) {
+                    room->Destroy();
+                }
+                shard.closing_rooms.clear();
+                shard.rooms_closed.notify_all();
+            }
+            if (shard.rooms_changed) {
+                rooms = shard.rooms;
+                room_pointers.clear();
+                for (const auto& room : rooms) {
+                    room_pointers.push_back(room.get());
+                }
+                shard.rooms_changed = false;
+            }
+        }
+
+        if (rooms.empty()) {
+            std::this_thread::sleep_for(ServiceInterval);
+            continue;
+        }
+        // Rooms that had more events than a pass handles are serviced again without waiting
+        if (!events_pending) {
+            Room::WaitForEvents(room_pointers, ServiceInterval);
+        }
+        events_pending = false;
+        for (const auto& room : rooms) {
+            events_pending |= room->ServiceEvents(EventsPerPass);
+        }
+    }
+
+    std::scoped_lock lock{shard.mutex};
+    for (const auto& room : shard.rooms) {
+        room->Destroy();
+    }
+    shard.rooms.clear();
+    for (const auto& room : shard.closing_rooms) {
+        room->Destroy();
+    }
+    shard.closing_rooms.clear();
+    shard.rooms_closed.notify_all();
+}
+
+} // namespace Network
@@ -0,0 +1,76 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common_types.h"
+#include "common/polyfill_thread.h"
+#include "network/room.h"
+
+namespace Network {
+
+/**
+ * Hosts many rooms in one process. Every room has its own ENet host and port, and the rooms are
+ * spread over a fixed number of threads, each of which waits for the packets of all its rooms at
+ * once instead of running a thread per room.
+ */
+class RoomServer final {
+public:
+    /// Parameters of a hosted room, see Room::Create
+    struct RoomSettings {
+        std::string name;
+        std::string description;
+        std::string server_address;
+        u16 port = DefaultRoomPort;
+        std::string password;
+        u32 max_members = 16;
+        std::string host_username;
+        std::string preferred_game;
+        u64 preferred_game_id = 0;
+        Room::BanList ban_list;
+        /// Ban list shared with other rooms, used instead of ban_list when set
+        std::shared_ptr<Room::SharedBanList> shared_ban_list;
+        bool enable_citra_mods = false;
+        u32 rate_limit = 0; ///< See Room::SetRateLimit
+    };
+
+    /// Creates a server servicing its rooms on the given number of threads.
+    explicit RoomServer(std::size_t num_threads);
+
+    /// Closes all rooms.
+    ~RoomServer();
+
+    /**
+     * Creates a room and hosts it on the thread with the fewest rooms.
+     * @returns The room, or nullptr if its socket could not be created
+     */
+    std::shared_ptr<Room> CreateRoom(const RoomSettings& settings,
+                                     std::unique_ptr<VerifyUser::Backend> verify_backend);
+
+    /// Closes a room, its members are disconnected. Returns once the room is closed.
+    void CloseRoom(const std::shared_ptr<Room>& room);
+
+    /// Returns the rooms that are open.
+    std::vector<std::shared_ptr<Room>> GetRooms() const;
+
+    /**
+     * Stops accepting members in all rooms and waits until they left or the timeout expired, then
+     * closes the rooms.
+     * @returns Whether all the members left before the timeout
+     */
+    bool Drain(std::chrono::milliseconds timeout);
+
+private:
+    struct Shard;
+
+    void ShardLoop(Shard& shard, std::stop_token stop_token);
+
+    std::vector<std::unique_ptr<Shard>> shards;
+};
+
+} // namespace Network
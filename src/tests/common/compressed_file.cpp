@@ -0,0 +1,92 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/compressed_file.h"
+#include "common/file_util.h"
+
+TEST_CASE("CompressedFile round trip", "[common]") {
+    const auto temp_dir = std::filesystem::temp_directory_path();
+    const std::string source_path = (temp_dir / "citra_compressed_test.cci").string();
+    const std::string dest_path = (temp_dir / "citra_compressed_test.zcci").string();
+
+    // Partially compressible data spanning a partial last block
+    std::mt19937 rng(1234);
+    std::vector<u8> data(100 * 1024 + 123);
+    for (std::size_t i = 0; i < data.size(); i++) {
+        data[i] = (i / 1024) % 2 ? static_cast<u8>(rng()) : static_cast<u8>(i);
+    }
+    {
+        FileUtil::IOFile source(source_path, "wb");
+        REQUIRE(source.WriteBytes(data.data(), data.size()) == data.size());
+    }
+
+    REQUIRE(FileUtil::CompressFile(source_path, dest_path, 3, 4096));
+
+    FileUtil::IOFile file(dest_path, "rb");
+    REQUIRE(file.IsCompressed());
+    REQUIRE(file.GetSize() == data.size());
+
+    // Random reads, including some crossing block boundaries and the end of the file
+    for (int i = 0; i < 200; i++) {
+        const std::size_t offset = rng() % data.size();
+        const std::size_t length = rng() % (3 * 4096);
+        const std::size_t expected_length = std::min(length, data.size() - offset);
+        std::vector<u8> buffer(length);
+        REQUIRE(file.ReadAtBytes(buffer.data(), length, offset) == expected_length);
+        REQUIRE(std::equal(buffer.begin(), buffer.begin() + expected_length,
+                           data.begin() + offset));
+    }
+
+    // Sequential reads
+    file.Clear();
+    std::vector<u8> buffer(data.size());
+    REQUIRE(file.Seek(10, SEEK_SET));
+    REQUIRE(file.ReadBytes(buffer.data(), 5000) == 5000);
+    REQUIRE(file.Tell() == 5010);
+    REQUIRE(std::equal(buffer.begin(), buffer.begin() + 5000, data.begin() + 10));
+
+    file.Close();
+    FileUtil::Delete(source_path);
+    FileUtil::Delete(dest_path);
+}
+
+TEST_CASE("CompressedFile is only detected for image extensions", "[common]") {
+    const auto temp_dir = std::filesystem::temp_directory_path();
+    const std::string source_path = (temp_dir / "citra_compressed_detect.cci").string();
+    const std::string dest_path = (temp_dir / "citra_compressed_detect.zcci").string();
+    const std::string other_path = (temp_dir / "citra_compressed_detect.bin").string();
+
+    const std::vector<u8> data(10000, 0x42);
+    {
+        FileUtil::IOFile source(source_path, "wb");
+        REQUIRE(source.WriteBytes(data.data(), data.size()) == data.size());
+    }
+    REQUIRE(FileUtil::CompressFile(source_path, dest_path, 3, 4096));
+    REQUIRE(FileUtil::Copy(dest_path, other_path));
+
+    // Other files starting with the magic are read as they are, from their start
+    FileUtil::IOFile file(other_path, "rb");
+    REQUIRE_FALSE(file.IsCompressed());
+    REQUIRE(file.GetSize() == FileUtil::GetSize(dest_path));
+    FileUtil::CompressedFileHeader header;
+    REQUIRE(file.ReadBytes(&header, sizeof(header)) == sizeof(header));
+    REQUIRE(header.magic == FileUtil::CompressedFileHeader::MAGIC);
+    file.Close();
+
+    // Failed compressions do not leave a partial image behind
+    FileUtil::Delete(dest_path);
+    REQUIRE_FALSE(FileUtil::CompressFile(other_path, dest_path, 3, 0));
+    REQUIRE_FALSE(FileUtil::Exists(dest_path));
+
+    FileUtil::Delete(source_path);
+    FileUtil::Delete(other_path);
+}
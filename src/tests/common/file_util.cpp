@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <array>
+#include <filesystem>
 #include <string>
 
 #include <catch2/catch_test_macros.hpp>
@@ -24,3 +25,26 @@ TEST_CASE("SplitFilename83 Sanity", "[common]") {
     REQUIRE(std::memcmp(short_name.data(), expected_short_name.data(), short_name.size()) == 0);
     REQUIRE(std::memcmp(extension.data(), expected_extension.data(), extension.size()) == 0);
 }
+
+TEST_CASE("RenameReplace replaces the destination", "[common]") {
+    const auto temp_dir = std::filesystem::temp_directory_path();
+    const std::string src_path = (temp_dir / "citra_rename_replace_src.bin").string();
+    const std::string dest_path = (temp_dir / "citra_rename_replace_dest.bin").string();
+
+    REQUIRE(FileUtil::WriteStringToFile(true, dest_path, "old"));
+    REQUIRE(FileUtil::WriteStringToFile(true, src_path, "new"));
+    REQUIRE(FileUtil::RenameReplace(src_path, dest_path));
+    REQUIRE_FALSE(FileUtil::Exists(src_path));
+
+    std::string contents;
+    FileUtil::ReadFileToString(true, dest_path, contents);
+    REQUIRE(contents == "new");
+
+    // Also works when there is nothing to replace
+    FileUtil::Delete(dest_path);
+    REQUIRE(FileUtil::WriteStringToFile(true, src_path, "new"));
+    REQUIRE(FileUtil::RenameReplace(src_path, dest_path));
+    REQUIRE(FileUtil::Exists(dest_path));
+
+    FileUtil::Delete(dest_path);
+}
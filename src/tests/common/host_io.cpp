@@ -0,0 +1,87 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <atomic>
+#include <cerrno>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/file_util.h"
+#include "common/host_io.h"
+
+namespace {
+
+void CheckEngine(Common::HostIOEngine& engine, int fd, const std::vector<u8>& expected) {
+    // Reads past the end of the file are short
+    std::vector<u8> data(expected.size() + 1000);
+    std::vector<Common::HostIOEngine::ReadRequest> reads;
+    for (std::size_t offset = 0; offset < data.size(); offset += 64 * 1024) {
+        const std::size_t length = std::min<std::size_t>(64 * 1024, data.size() - offset);
+        reads.push_back({fd, offset, std::span<u8>(data.data() + offset, length)});
+    }
+    std::promise<s64> result;
+    engine.SubmitReads(1, reads, [&result](s64 read) { result.set_value(read); });
+    REQUIRE(result.get_future().get() == static_cast<s64>(expected.size()));
+    data.resize(expected.size());
+    REQUIRE(data == expected);
+
+    // A short read ends the batch, the reads after it are not counted
+    std::vector<u8> tail(100);
+    std::vector<u8> head(100);
+    const std::vector<Common::HostIOEngine::ReadRequest> short_reads{
+        {fd, expected.size() - 10, tail},
+        {fd, 0, head},
+    };
+    std::promise<s64> short_result;
+    engine.SubmitReads(1, short_reads, [&short_result](s64 read) { short_result.set_value(read); });
+    REQUIRE(short_result.get_future().get() == 10);
+
+    // Every operation completes exactly once, even when cancelled
+    std::atomic<int> completed{0};
+    for (int i = 0; i < 64; i++) {
+        engine.SubmitTask(
+            2, [] { return s64{1}; },
+            [&completed](s64 ret) {
+                REQUIRE((ret == 1 || ret == -ECANCELED));
+                completed++;
+            });
+    }
+    engine.SubmitReads(2, reads, [&completed](s64) { completed++; });
+    engine.Cancel(2);
+    REQUIRE(completed == 65);
+}
+
+} // Anonymous namespace
+
+TEST_CASE("HostIOEngine reads and cancels", "[common]") {
+    const std::string path =
+        (std::filesystem::temp_directory_path() / "citra_host_io_test.bin").string();
+    std::vector<u8> expected(1024 * 1024 + 123);
+    for (std::size_t i = 0; i < expected.size(); i++) {
+        expected[i] = static_cast<u8>(i * 13);
+    }
+    {
+        FileUtil::IOFile file(path, "wb");
+        REQUIRE(file.WriteBytes(expected.data(), expected.size()) == expected.size());
+    }
+
+    FileUtil::IOFile file(path, "rb");
+    const int fd = file.GetFd();
+
+    auto pool = Common::CreateThreadPoolIOEngine(3);
+    CheckEngine(*pool, fd, expected);
+
+    // io_uring may not be available on this host
+    if (auto uring = Common::CreateIoUringEngine(8)) {
+        CheckEngine(*uring, fd, expected);
+    }
+
+    file.Close();
+    FileUtil::Delete(path);
+}
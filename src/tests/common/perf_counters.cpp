@@ -0,0 +1,39 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstring>
+#include <thread>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/perf_counters.h"
+
+using Common::PerfCounters::Counter;
+
+TEST_CASE("PerfCounters sums the counters of every thread", "[common]") {
+    const auto before = Common::PerfCounters::GetTotals();
+
+    Common::PerfCounters::Add(Counter::DrawCalls);
+    Common::PerfCounters::Add(Counter::FSBytesRead, 100);
+    // The counts of a thread are kept after it exits
+    std::thread thread([] {
+        Common::PerfCounters::Add(Counter::DrawCalls, 2);
+        Common::PerfCounters::Add(Counter::FSBytesRead, 1000);
+    });
+    thread.join();
+
+    const auto after = Common::PerfCounters::GetTotals();
+    const auto delta = [&](Counter counter) {
+        const auto index = static_cast<std::size_t>(counter);
+        return after[index] - before[index];
+    };
+    REQUIRE(delta(Counter::DrawCalls) == 3);
+    REQUIRE(delta(Counter::FSBytesRead) == 1100);
+    REQUIRE(delta(Counter::SVCCalls) == 0);
+}
+
+TEST_CASE("PerfCounters names every counter", "[common]") {
+    REQUIRE(std::strcmp(Common::PerfCounters::GetName(Counter::DrawCalls), "draw_calls") == 0);
+    REQUIRE(std::strcmp(Common::PerfCounters::GetName(Counter::FSBytesRead), "fs_bytes_read") == 0);
+}
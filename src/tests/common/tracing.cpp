@@ -0,0 +1,110 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/file_util.h"
+#include "common/thread.h"
+#include "common/tracing.h"
+
+namespace {
+
+const Common::Tracing::ThreadEvents* FindThread(
+    const std::vector<Common::Tracing::ThreadEvents>& threads, const std::string& name) {
+    const auto it = std::find_if(threads.begin(), threads.end(), [&name](const auto& thread) {
+        return thread.thread_name == name;
+    });
+    return it == threads.end() ? nullptr : &*it;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("Tracing records scopes per thread", "[common]") {
+    Common::Tracing::Clear();
+    Common::Tracing::SetEnabled(true);
+
+    std::thread thread([] {
+        Common::SetCurrentThreadName("TracingTest");
+        Common::Tracing::Scope outer{"Test", "Outer"};
+        { Common::Tracing::Scope inner{"Test", "Inner"}; }
+    });
+    thread.join();
+    Common::Tracing::SetEnabled(false);
+    { Common::Tracing::Scope ignored{"Test", "Disabled"}; }
+
+    // The buffer of the thread outlives it
+    const auto threads = Common::Tracing::CollectEvents();
+    const auto* events = FindThread(threads, "TracingTest");
+    REQUIRE(events != nullptr);
+    REQUIRE(events->events.size() == 2);
+    const auto& inner = events->events[0];
+    const auto& outer = events->events[1];
+    REQUIRE(std::strcmp(inner.name, "Inner") == 0);
+    REQUIRE(std::strcmp(outer.name, "Outer") == 0);
+    REQUIRE(outer.begin_ns <= inner.begin_ns);
+    REQUIRE(inner.end_ns <= outer.end_ns);
+    for (const auto& thread_events : threads) {
+        for (const auto& event : thread_events.events) {
+            REQUIRE(std::strcmp(event.name, "Disabled") != 0);
+        }
+    }
+
+    const std::string chrome_path =
+        (std::filesystem::temp_directory_path() / "citra_tracing_test.json").string();
+    const std::string perfetto_path =
+        (std::filesystem::temp_directory_path() / "citra_tracing_test.perfetto-trace").string();
+    REQUIRE(Common::Tracing::Export(chrome_path));
+    REQUIRE(Common::Tracing::Export(perfetto_path));
+
+    std::string chrome;
+    FileUtil::ReadFileToString(true, chrome_path, chrome);
+    REQUIRE(chrome.find("\"name\":\"Outer\",\"cat\":\"Test\",\"ph\":\"X\"") != std::string::npos);
+    REQUIRE(chrome.find("\"args\":{\"name\":\"TracingTest\"}") != std::string::npos);
+
+    // A Trace message made of TracePacket fields
+    std::string perfetto;
+    FileUtil::ReadFileToString(false, perfetto_path, perfetto);
+    REQUIRE(!perfetto.empty());
+    REQUIRE(perfetto[0] == 0x0a);
+    REQUIRE(perfetto.find("Inner") != std::string::npos);
+
+    FileUtil::Delete(chrome_path);
+    FileUtil::Delete(perfetto_path);
+
+    Common::Tracing::Clear();
+    REQUIRE(FindThread(Common::Tracing::CollectEvents(), "TracingTest")->events.empty());
+}
+
+TEST_CASE("Tracing keeps the newest events of a thread", "[common]") {
+    Common::Tracing::Clear();
+    Common::Tracing::SetEnabled(true);
+
+    constexpr std::size_t NumEvents = Common::Tracing::EventsPerThread + 100;
+    std::thread thread([] {
+        Common::SetCurrentThreadName("TracingWrap");
+        for (std::size_t i = 0; i < NumEvents; i++) {
+            Common::Tracing::Record("Test", "Event", i, i + 1);
+        }
+    });
+    thread.join();
+    Common::Tracing::SetEnabled(false);
+
+    const auto threads = Common::Tracing::CollectEvents();
+    const auto* events = FindThread(threads, "TracingWrap");
+    REQUIRE(events != nullptr);
+    // The oldest slot may be dropped as it is the next one the thread would write
+    REQUIRE(events->events.size() >= Common::Tracing::EventsPerThread - 1);
+    REQUIRE(events->events.size() <= Common::Tracing::EventsPerThread);
+    for (std::size_t i = 0; i < events->events.size(); i++) {
+        REQUIRE(events->events[i].begin_ns == NumEvents - events->events.size() + i);
+    }
+    Common::Tracing::Clear();
+}
@@ -0,0 +1,47 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <atomic>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/worker_pool.h"
+
+TEST_CASE("ParallelFor runs every index once", "[common]") {
+    std::vector<std::atomic<int>> runs(1000);
+    Common::ParallelFor(runs.size(), [&](std::size_t i) { ++runs[i]; });
+    for (const auto& count : runs) {
+        REQUIRE(count == 1);
+    }
+}
+
+TEST_CASE("TaskGroup waits only for its own tasks", "[common]") {
+    std::atomic<bool> release{false};
+    Common::TaskGroup blocked;
+    blocked.Run([&] {
+        while (!release) {
+        }
+    });
+
+    std::atomic<int> done{0};
+    {
+        Common::TaskGroup group;
+        for (int i = 0; i < 64; i++) {
+            group.Run([&] { ++done; });
+        }
+        group.Wait();
+        REQUIRE(done == 64);
+    }
+    release = true;
+}
+
+TEST_CASE("TaskGroup can be nested in the tasks of another group", "[common]") {
+    const std::size_t outer = Common::TaskGroup::NumWorkers() * 2 + 1;
+    std::atomic<std::size_t> done{0};
+    Common::ParallelFor(outer, [&](std::size_t) {
+        Common::ParallelFor(16, [&](std::size_t) { ++done; });
+    });
+    REQUIRE(done == outer * 16);
+}
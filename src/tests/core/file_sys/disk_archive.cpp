@@ -0,0 +1,114 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/file_util.h"
+#include "core/file_sys/disk_archive.h"
+
+TEST_CASE("DiskFile write back", "[core][file_sys]") {
+    const std::string path =
+        (std::filesystem::temp_directory_path() / "citra_disk_file_test.bin").string();
+    FileUtil::IOFile(path, "wb");
+
+    FileSys::Mode mode{};
+    mode.read_flag.Assign(1);
+    mode.write_flag.Assign(1);
+    FileSys::DiskFile file(FileUtil::IOFile(path, "r+b"), mode, nullptr);
+
+    // Many small sequential writes, one overwrite of earlier data and one write after a gap
+    std::vector<u8> expected(64 * 1024 + 0x100);
+    for (std::size_t offset = 0; offset < 64 * 1024; offset += 16) {
+        std::vector<u8> chunk(16);
+        for (std::size_t i = 0; i < chunk.size(); i++) {
+            chunk[i] = static_cast<u8>(offset / 16 + i);
+        }
+        REQUIRE(file.Write(offset, chunk.size(), false, chunk.data()).Unwrap() == chunk.size());
+        std::copy(chunk.begin(), chunk.end(), expected.begin() + offset);
+    }
+    const std::vector<u8> overwrite(100, 0xAA);
+    REQUIRE(file.Write(1000, overwrite.size(), true, overwrite.data()).Unwrap() == 100);
+    std::copy(overwrite.begin(), overwrite.end(), expected.begin() + 1000);
+    const std::vector<u8> tail(0x80, 0x55);
+    REQUIRE(file.Write(64 * 1024 + 0x80, tail.size(), false, tail.data()).Unwrap() == 0x80);
+    std::copy(tail.begin(), tail.end(), expected.begin() + 64 * 1024 + 0x80);
+
+    // Reads and size queries see the queued writes
+    REQUIRE(file.GetSize() == expected.size());
+    std::vector<u8> data(expected.size());
+    REQUIRE(file.Read(0, data.size(), data.data()).Unwrap() == data.size());
+    REQUIRE(data == expected);
+
+    // After closing, the data is on the host file system
+    REQUIRE(file.Write(0, overwrite.size(), false, overwrite.data()).Unwrap() == 100);
+    std::copy(overwrite.begin(), overwrite.end(), expected.begin());
+    REQUIRE(file.Close());
+
+    FileUtil::IOFile host_file(path, "rb");
+    REQUIRE(host_file.ReadBytes(data.data(), data.size()) == data.size());
+    REQUIRE(data == expected);
+    host_file.Close();
+
+    FileUtil::Delete(path);
+}
+
+TEST_CASE("DiskFile writes are visible to other handles of the file", "[core][file_sys]") {
+    const std::string path =
+        (std::filesystem::temp_directory_path() / "citra_disk_file_shared_test.bin").string();
+    FileUtil::IOFile(path, "wb");
+
+    FileSys::Mode mode{};
+    mode.read_flag.Assign(1);
+    mode.write_flag.Assign(1);
+    FileSys::DiskFile writer(FileUtil::IOFile(path, "r+b"), mode, nullptr);
+    FileSys::DiskFile reader(FileUtil::IOFile(path, "rb"), mode, nullptr);
+
+    const std::vector<u8> expected(256 * 1024, 0x5A);
+    for (std::size_t offset = 0; offset < expected.size(); offset += 0x1000) {
+        REQUIRE(writer.Write(offset, 0x1000, false, expected.data() + offset).Succeeded());
+    }
+
+    // The reader waits for the writes queued through the other handle
+    REQUIRE(reader.GetSize() == expected.size());
+    std::vector<u8> data(expected.size());
+    REQUIRE(reader.Read(0, data.size(), data.data()).Unwrap() == data.size());
+    REQUIRE(data == expected);
+
+    writer.Close();
+    reader.Close();
+    FileUtil::Delete(path);
+}
+
+TEST_CASE("DiskFile reports failed write backs", "[core][file_sys]") {
+    const std::string path =
+        (std::filesystem::temp_directory_path() / "citra_disk_file_error_test.bin").string();
+    FileUtil::IOFile(path, "wb");
+
+    // The host file is read only, so every write back fails
+    FileSys::Mode mode{};
+    mode.read_flag.Assign(1);
+    mode.write_flag.Assign(1);
+    FileSys::DiskFile file(FileUtil::IOFile(path, "rb"), mode, nullptr);
+    const std::vector<u8> data(0x100, 0xAA);
+
+    // Without the flush flag, the failure is reported by the next operation
+    REQUIRE(file.Write(0, data.size(), false, data.data()).Succeeded());
+    REQUIRE(file.TakeWriteResult().IsError());
+    REQUIRE(file.TakeWriteResult().IsSuccess());
+
+    REQUIRE(file.Write(0, data.size(), false, data.data()).Succeeded());
+    file.Flush();
+    REQUIRE(file.Write(0, data.size(), false, data.data()).Failed());
+
+    // With the flush flag, the write itself fails
+    REQUIRE(file.Write(0, data.size(), true, data.data()).Failed());
+
+    file.Close();
+    FileUtil::Delete(path);
+}
@@ -0,0 +1,123 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/file_util.h"
+#include "core/file_sys/layered_fs.h"
+
+namespace {
+
+class MemoryRomFSReader : public FileSys::RomFSReader {
+public:
+    explicit MemoryRomFSReader(std::vector<u8> data_) : data(std::move(data_)) {}
+
+    std::size_t GetSize() const override {
+        return data.size();
+    }
+
+    std::size_t ReadFile(std::size_t offset, std::size_t length, u8* buffer) override {
+        std::memcpy(buffer, data.data() + offset, length);
+        return length;
+    }
+
+    bool AllowsCachedReads() const override {
+        return false;
+    }
+
+    bool CacheReady(std::size_t file_offset, std::size_t length) override {
+        return false;
+    }
+
+private:
+    std::vector<u8> data;
+};
+
+// RomFS with only a root directory
+std::vector<u8> MakeEmptyRomFS() {
+    FileSys::RomFSHeader header{};
+    header.header_length = sizeof(header);
+    header.directory_hash_table = {0x28, 3 * 4};
+    header.directory_metadata_table = {0x34, 0x18};
+    header.file_hash_table = {0x4C, 3 * 4};
+    header.file_metadata_table = {0x58, 0};
+    header.file_data_offset = 0x60;
+
+    std::vector<u8> image(header.file_data_offset, 0xFF);
+    std::memcpy(image.data(), &header, sizeof(header));
+    const u32 directory_hash_table[3] = {0, 0xFFFFFFFF, 0xFFFFFFFF};
+    std::memcpy(image.data() + 0x28, directory_hash_table, sizeof(directory_hash_table));
+    const u32 root[6] = {0, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0};
+    std::memcpy(image.data() + 0x34, root, sizeof(root));
+    return image;
+}
+
+std::vector<u8> ReadAll(FileSys::RomFSReader& reader) {
+    std::vector<u8> data(reader.GetSize());
+    REQUIRE(reader.ReadFile(0, data.size(), data.data()) == data.size());
+    return data;
+}
+
+void WriteFile(const std::string& path, const std::vector<u8>& data) {
+    FileUtil::IOFile file(path, "wb");
+    REQUIRE(file.WriteBytes(data.data(), data.size()) == data.size());
+}
+
+std::vector<u8> ReadHostFile(const std::string& path) {
+    FileUtil::IOFile file(path, "rb");
+    std::vector<u8> data(file.GetSize());
+    REQUIRE(file.ReadBytes(data.data(), data.size()) == data.size());
+    return data;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("LayeredFS builds RomFS from replacement files", "[core][file_sys]") {
+    const auto temp_dir = std::filesystem::temp_directory_path() / "citra_layered_fs_test";
+    std::filesystem::remove_all(temp_dir);
+    const std::string patch_path = (temp_dir / "romfs").string() + "/";
+    const std::string dump_path = (temp_dir / "dump").string();
+    REQUIRE(FileUtil::CreateFullPath(patch_path + "sub/"));
+
+    std::vector<u8> a(100), b(5000);
+    for (std::size_t i = 0; i < b.size(); i++) {
+        b[i] = static_cast<u8>(i * 7);
+        if (i < a.size()) {
+            a[i] = static_cast<u8>(i);
+        }
+    }
+    WriteFile(patch_path + "a.bin", a);
+    WriteFile(patch_path + "sub/b.bin", b);
+
+    auto base = std::make_shared<MemoryRomFSReader>(MakeEmptyRomFS());
+    FileSys::LayeredFS layered(base, patch_path, "");
+    const auto image = ReadAll(layered);
+    REQUIRE(image.size() > MakeEmptyRomFS().size());
+
+    // Reading in small pieces must match reading at once
+    std::vector<u8> pieces(image.size());
+    for (std::size_t offset = 0; offset < pieces.size(); offset += 37) {
+        const auto length = std::min<std::size_t>(37, pieces.size() - offset);
+        REQUIRE(layered.ReadFile(offset, length, pieces.data() + offset) == length);
+    }
+    REQUIRE(pieces == image);
+
+    // Without relocations the image is passed through as is
+    auto built = std::make_shared<MemoryRomFSReader>(image);
+    FileSys::LayeredFS passthrough(built, "", "", false);
+    REQUIRE(ReadAll(passthrough) == image);
+
+    // The built metadata must describe the replacement files
+    REQUIRE(passthrough.DumpRomFS(dump_path));
+    REQUIRE(ReadHostFile(dump_path + "/a.bin") == a);
+    REQUIRE(ReadHostFile(dump_path + "/sub/b.bin") == b);
+
+    std::filesystem::remove_all(temp_dir);
+}
@@ -0,0 +1,211 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <span>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "core/file_sys/lzss.h"
+
+namespace {
+
+// Byte-at-a-time decoder the optimized one must stay equivalent to.
+bool ReferenceDecompress(std::span<const u8> compressed, std::span<u8> decompressed) {
+    const u8* footer = compressed.data() + compressed.size() - 8;
+
+    u32 buffer_top_and_bottom;
+    std::memcpy(&buffer_top_and_bottom, footer, sizeof(u32));
+
+    std::size_t out = decompressed.size();
+    std::size_t index = compressed.size() - ((buffer_top_and_bottom >> 24) & 0xFF);
+    std::size_t stop_index = compressed.size() - (buffer_top_and_bottom & 0xFFFFFF);
+
+    std::memset(decompressed.data(), 0, decompressed.size());
+    std::memcpy(decompressed.data(), compressed.data(), compressed.size());
+
+    while (index > stop_index) {
+        u8 control = compressed[--index];
+
+        for (unsigned i = 0; i < 8; i++) {
+            if (index <= stop_index || index == 0 || out == 0)
+                break;
+
+            if (control & 0x80) {
+                if (index < 2)
+                    return false;
+                index -= 2;
+
+                u32 segment_offset = compressed[index] | (compressed[index + 1] << 8);
+                u32 segment_size = ((segment_offset >> 12) & 15) + 3;
+                segment_offset &= 0x0FFF;
+                segment_offset += 2;
+
+                if (out < segment_size)
+                    return false;
+
+                for (unsigned j = 0; j < segment_size; j++) {
+                    if (out + segment_offset >= decompressed.size())
+                        return false;
+
+                    u8 data = decompressed[out + segment_offset];
+                    decompressed[--out] = data;
+                }
+            } else {
+                if (out < 1)
+                    return false;
+                decompressed[--out] = compressed[--index];
+            }
+            control <<= 1;
+        }
+    }
+    return true;
+}
+
+/**
+ * Builds a random stream that decodes successfully, mixing literals with back-references of
+ * random distances, including short ones so that overlapping copies are exercised.
+ */
+std::vector<u8> MakeStream(std::mt19937& rng, std::size_t body_size, u32 extra) {
+    const std::size_t decompressed_size = body_size + 8 + extra;
+    std::size_t out = decompressed_size;
+
+    // Bytes in the order the decoder consumes them, which is from the end of the body.
+    std::vector<u8> consumed;
+    while (consumed.size() + 17 <= body_size) {
+        const bool all_literals = rng() % 4 == 0;
+        u8 control = 0;
+        std::vector<u8> items;
+        for (int i = 0; i < 8; i++) {
+            const std::size_t available = decompressed_size - out;
+            if (!all_literals && available >= 3 && out >= 18 && rng() % 2) {
+                const std::size_t max_offset = std::min<std::size_t>(available - 3, 0xFFF);
+                const u32 offset = static_cast<u32>(
+                    rng() % 2 ? rng() % std::min<std::size_t>(max_offset + 1, 16)
+                              : rng() % (max_offset + 1));
+                const u32 size_bits = static_cast<u32>(rng() % 16);
+                const u16 segment = static_cast<u16>((size_bits << 12) | offset);
+                items.push_back(static_cast<u8>(segment >> 8));
+                items.push_back(static_cast<u8>(segment));
+                control |= 0x80 >> i;
+                out -= size_bits + 3;
+            } else if (out > 0) {
+                items.push_back(static_cast<u8>(rng()));
+                out--;
+            }
+        }
+        consumed.push_back(control);
+        consumed.insert(consumed.end(), items.begin(), items.end());
+    }
+
+    std::vector<u8> stream(consumed.rbegin(), consumed.rend());
+    stream.resize(stream.size() + 8);
+    const u32 top_and_bottom = (8u << 24) | static_cast<u32>(stream.size());
+    const u32 total_extra = static_cast<u32>(decompressed_size - stream.size());
+    std::memcpy(stream.data() + stream.size() - 8, &top_and_bottom, sizeof(u32));
+    std::memcpy(stream.data() + stream.size() - 4, &total_extra, sizeof(u32));
+    return stream;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("LZSS matches the reference decoder", "[core][file_sys]") {
+    std::mt19937 rng(0x4c5a5353);
+    std::size_t successes = 0;
+
+    for (int iteration = 0; iteration < 2000; iteration++) {
+        const std::size_t body_size = 16 + rng() % 2048;
+        const u32 extra = static_cast<u32>(rng() % (body_size * 4 + 1));
+        auto stream = MakeStream(rng, body_size, extra);
+
+        // Corrupt some streams so the error paths are compared too.
+        if (iteration % 4 == 0) {
+            for (int i = 0; i < 4; i++) {
+                stream[rng() % (stream.size() - 8)] = static_cast<u8>(rng());
+            }
+        }
+
+        const std::size_t decompressed_size = FileSys::LZSS::GetDecompressedSize(stream);
+
+        std::vector<u8> expected(decompressed_size);
+        std::vector<u8> actual(decompressed_size);
+        const bool expected_result = ReferenceDecompress(stream, expected);
+        const bool actual_result = FileSys::LZSS::Decompress(stream, actual);
+
+        REQUIRE(actual_result == expected_result);
+        if (expected_result) {
+            REQUIRE(actual == expected);
+            successes++;
+        }
+    }
+
+    // Make sure the fuzzing actually covers successful decodes.
+    REQUIRE(successes > 1000);
+}
+
+TEST_CASE("LZSS rejects malformed footers", "[core][file_sys]") {
+    std::vector<u8> too_small(4);
+    std::vector<u8> out(16);
+    REQUIRE(FileSys::LZSS::GetDecompressedSize(too_small) == 0);
+    REQUIRE_FALSE(FileSys::LZSS::Decompress(too_small, out));
+
+    // Compressed region larger than the buffer
+    std::vector<u8> stream(16);
+    const u32 top_and_bottom = (8u << 24) | 0x100;
+    std::memcpy(stream.data() + 8, &top_and_bottom, sizeof(u32));
+    REQUIRE_FALSE(FileSys::LZSS::Decompress(stream, out));
+}
+
+TEST_CASE("LZSS decode throughput", "[.][benchmark]") {
+    // Synthetic code-like stream: alternating literal groups and back-references.
+    std::mt19937 rng(42);
+    constexpr std::size_t body_size = 4 * 1024 * 1024;
+    std::vector<u8> stream;
+    stream.reserve(body_size + 8);
+    std::size_t produced = 0;
+    const auto push_literals = [&] {
+        for (int i = 0; i < 8; i++) {
+            stream.push_back(static_cast<u8>(rng()));
+        }
+        stream.push_back(0x00);
+        produced += 8;
+    };
+    while (stream.size() < body_size) {
+        if (rng() % 2) {
+            push_literals();
+        } else {
+            for (int i = 0; i < 8; i++) {
+                const u16 segment = static_cast<u16>(((rng() % 16) << 12) | (rng() % 64));
+                stream.push_back(static_cast<u8>(segment));
+                stream.push_back(static_cast<u8>(segment >> 8));
+                produced += ((segment >> 12) & 15) + 3;
+            }
+            stream.push_back(0xFF);
+        }
+    }
+    // Decoding starts here, back-references need something to point at.
+    for (int i = 0; i < 16; i++) {
+        push_literals();
+    }
+    const u32 body = static_cast<u32>(stream.size());
+    const u32 top_and_bottom = (8u << 24) | (body + 8);
+    const u32 extra = static_cast<u32>(produced + 128 - body);
+    stream.resize(body + 8);
+    std::memcpy(stream.data() + body, &top_and_bottom, sizeof(u32));
+    std::memcpy(stream.data() + body + 4, &extra, sizeof(u32));
+
+    std::vector<u8> out(FileSys::LZSS::GetDecompressedSize(stream));
+    REQUIRE(FileSys::LZSS::Decompress(stream, out));
+
+    BENCHMARK("reference") {
+        return ReferenceDecompress(stream, out);
+    };
+    BENCHMARK("optimized") {
+        return FileSys::LZSS::Decompress(stream, out);
+    };
+}
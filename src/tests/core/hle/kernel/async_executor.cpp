@@ -0,0 +1,94 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "core/hle/kernel/async_executor.h"
+
+TEST_CASE("AsyncExecutor runs tasks of a session in order", "[kernel]") {
+    Kernel::AsyncExecutor executor{1};
+    int session;
+    std::mutex mutex;
+    std::vector<int> order;
+    std::vector<std::future<void>> futures;
+    for (int i = 0; i < 32; i++) {
+        futures.push_back(executor.Submit("test", &session, [&, i] {
+            std::scoped_lock lock{mutex};
+            order.push_back(i);
+        }));
+    }
+    for (auto& future : futures) {
+        future.get();
+    }
+    REQUIRE(order.size() == 32);
+    for (int i = 0; i < 32; i++) {
+        REQUIRE(order[i] == i);
+    }
+}
+
+TEST_CASE("AsyncExecutor limits the tasks of a service", "[kernel]") {
+    Kernel::AsyncExecutor executor{8};
+    executor.SetServiceLimit("limited", 2);
+
+    std::atomic<int> running{0};
+    std::atomic<int> max_running{0};
+    std::vector<int> sessions(16);
+    std::vector<std::future<void>> futures;
+    for (auto& session : sessions) {
+        futures.push_back(executor.Submit("limited", &session, [&] {
+            const int now = ++running;
+            int max = max_running.load();
+            while (now > max && !max_running.compare_exchange_weak(max, now)) {
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            running--;
+        }));
+    }
+
+    // Other services still get threads
+    std::promise<void> other;
+    executor.Submit("other", &other, [&other] { other.set_value(); }).get();
+
+    for (auto& future : futures) {
+        future.get();
+    }
+    REQUIRE(max_running <= 2);
+}
+
+TEST_CASE("AsyncExecutor forwards exceptions", "[kernel]") {
+    Kernel::AsyncExecutor executor{1};
+    int session;
+    auto future = executor.Submit("test", &session, [] { throw std::runtime_error("failed"); });
+    REQUIRE_THROWS_AS(future.get(), std::runtime_error);
+}
+
+TEST_CASE("AsyncExecutor does not hold back tasks unblocking blocked tasks", "[kernel]") {
+    Kernel::AsyncExecutor executor{2};
+    executor.SetServiceLimit("soc", 2);
+
+    // Blocked tasks fill more than the limit and the threads of the executor, like accept calls
+    // waiting for a connect from the same service
+    std::promise<void> connected;
+    std::shared_future<void> wait_connect = connected.get_future().share();
+    std::vector<int> sessions(4);
+    std::vector<std::future<void>> futures;
+    for (auto& session : sessions) {
+        futures.push_back(
+            executor.Submit("soc", &session, [wait_connect] { wait_connect.wait(); }, true));
+    }
+
+    int connect_session;
+    executor.Submit("soc", &connect_session, [&connected] { connected.set_value(); }).get();
+    for (auto& future : futures) {
+        future.get();
+    }
+}
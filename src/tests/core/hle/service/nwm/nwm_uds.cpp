@@ -0,0 +1,45 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "core/hle/service/nwm/nwm_uds.h"
+
+using Service::NWM::DataFrameQueue;
+
+TEST_CASE("DataFrameQueue returns frames in order", "[hle][nwm]") {
+    DataFrameQueue queue;
+    REQUIRE(queue.Empty());
+
+    // Keep the queue half full while wrapping around the ring a few times
+    constexpr u16 Live = DataFrameQueue::Capacity / 2;
+    for (u16 i = 0; i < DataFrameQueue::Capacity * 3; i++) {
+        const std::vector<u8> data(i % 16 + 1, static_cast<u8>(i));
+        REQUIRE(queue.Push(i, data));
+        if (i >= Live) {
+            const u16 expected = i - Live;
+            const auto& frame = queue.Front();
+            REQUIRE(frame.src_node_id == expected);
+            REQUIRE(frame.size == expected % 16 + 1);
+            REQUIRE(frame.data[0] == static_cast<u8>(expected));
+            queue.Pop();
+        }
+    }
+    REQUIRE(queue.Size() == Live);
+}
+
+TEST_CASE("DataFrameQueue drops frames when full", "[hle][nwm]") {
+    DataFrameQueue queue;
+    const std::vector<u8> data(Service::NWM::UDSMaxDataSize);
+    for (std::size_t i = 0; i < DataFrameQueue::Capacity; i++) {
+        REQUIRE(queue.Push(0, data));
+    }
+    REQUIRE_FALSE(queue.Push(0, data));
+    queue.Pop();
+    REQUIRE(queue.Push(0, data));
+
+    const std::vector<u8> too_large(Service::NWM::UDSMaxDataSize + 1);
+    queue.Pop();
+    REQUIRE_FALSE(queue.Push(0, too_large));
+}
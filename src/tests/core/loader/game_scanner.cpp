@@ -0,0 +1,76 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <atomic>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/file_util.h"
+#include "core/loader/game_scanner.h"
+
+namespace {
+
+void WriteFile(const std::string& path, std::size_t size) {
+    FileUtil::IOFile file(path, "wb");
+    const std::vector<u8> data(size, 0x5A);
+    REQUIRE(file.WriteBytes(data.data(), data.size()) == data.size());
+}
+
+Loader::GameScanner::Stats Scan(const std::string& index_path, const std::string& dir,
+                                std::vector<std::string>& watch_list) {
+    Loader::GameScanner scanner(index_path, 4);
+    std::atomic_bool stop{false};
+    std::size_t games = 0;
+    scanner.Scan(
+        dir, 1, [](const std::string& path) { return path.ends_with(".3dsx"); },
+        [&games](const Loader::GameEntry&) { games++; }, stop, &watch_list);
+    // None of the files are valid executables
+    REQUIRE(games == 0);
+    REQUIRE(scanner.SaveIndex());
+    return scanner.GetStats();
+}
+
+} // Anonymous namespace
+
+TEST_CASE("GameScanner only reopens changed files", "[core][loader]") {
+    const auto temp_dir = std::filesystem::temp_directory_path() / "citra_game_scanner_test";
+    std::filesystem::remove_all(temp_dir);
+    const std::string dir = (temp_dir / "games").string();
+    const std::string index_path = (temp_dir / "index.bin").string();
+    REQUIRE(FileUtil::CreateFullPath(dir + "/sub/"));
+
+    for (int i = 0; i < 20; i++) {
+        WriteFile(dir + "/game" + std::to_string(i) + ".3dsx", 0x100 + i);
+    }
+    WriteFile(dir + "/sub/nested.3dsx", 0x80);
+    WriteFile(dir + "/ignored.txt", 0x80);
+
+    std::vector<std::string> watch_list;
+    auto stats = Scan(index_path, dir, watch_list);
+    REQUIRE(stats.files == 21);
+    REQUIRE(stats.opened == 21);
+    REQUIRE(watch_list.size() == 1);
+
+    // Everything comes from the index now
+    stats = Scan(index_path, dir, watch_list);
+    REQUIRE(stats.files == 21);
+    REQUIRE(stats.opened == 0);
+
+    // A file whose size changed and a new file are opened again
+    WriteFile(dir + "/game3.3dsx", 0x1000);
+    WriteFile(dir + "/new.3dsx", 0x80);
+    stats = Scan(index_path, dir, watch_list);
+    REQUIRE(stats.files == 22);
+    REQUIRE(stats.opened == 2);
+
+    // A corrupted index is ignored
+    WriteFile(index_path, 0x20);
+    stats = Scan(index_path, dir, watch_list);
+    REQUIRE(stats.opened == 22);
+
+    std::filesystem::remove_all(temp_dir);
+}
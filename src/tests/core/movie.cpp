@@ -0,0 +1,284 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstring>
+#include <filesystem>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/archives.h"
+#include "common/file_util.h"
+#include "core/core.h"
+#include "core/hle/service/hid/hid.h"
+#include "core/movie.h"
+
+namespace {
+
+constexpr std::size_t HeaderSize = 256;
+constexpr std::size_t StateSize = 7;
+// Offsets of the CTMHeader fields
+constexpr std::size_t InputCountOffset = 84;
+constexpr std::size_t FormatVersionOffset = 100;
+
+enum class BlockType : u32 {
+    Input = 0,
+    Keyframe = 1,
+};
+
+struct Block {
+    BlockType type;
+    u32 size;
+};
+
+std::string GetTestPath(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+std::vector<u8> ReadMovieFile(const std::string& path) {
+    FileUtil::IOFile file(path, "rb");
+    std::vector<u8> data(file.GetSize());
+    file.ReadBytes(data.data(), data.size());
+    return data;
+}
+
+template <typename T>
+T Read(const std::vector<u8>& data, std::size_t offset) {
+    T value{};
+    std::memcpy(&value, data.data() + offset, sizeof(T));
+    return value;
+}
+
+std::vector<Block> ReadBlocks(const std::vector<u8>& data) {
+    std::vector<Block> blocks;
+    for (std::size_t offset = HeaderSize; offset + 8 <= data.size();) {
+        const Block block{Read<BlockType>(data, offset), Read<u32>(data, offset + 4)};
+        blocks.push_back(block);
+        offset += 8 + block.size;
+    }
+    return blocks;
+}
+
+void AppendBlock(std::vector<u8>& data, BlockType type, u32 size, const void* contents,
+                 std::size_t contents_size) {
+    const auto append = [&](const void* bytes, std::size_t count) {
+        const auto begin = static_cast<const u8*>(bytes);
+        data.insert(data.end(), begin, begin + count);
+    };
+    append(&type, sizeof(type));
+    append(&size, sizeof(size));
+    append(contents, contents_size);
+}
+
+/// Records pad states whose circle pad X position is the index of the input
+void RecordInputs(Core::Movie& movie, s16 first, s16 count) {
+    for (s16 i = first; i < first + count; i++) {
+        Service::HID::PadState pad_state{};
+        pad_state.a.Assign(i & 1);
+        s16 circle_pad_x = i;
+        s16 circle_pad_y = 0;
+        movie.HandlePadAndCircleStatus(pad_state, circle_pad_x, circle_pad_y);
+    }
+}
+
+s16 PlayInput(Core::Movie& movie) {
+    Service::HID::PadState pad_state{};
+    s16 circle_pad_x = -1;
+    s16 circle_pad_y = -1;
+    movie.HandlePadAndCircleStatus(pad_state, circle_pad_x, circle_pad_y);
+    return circle_pad_x;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("Movie records input in blocks", "[core][movie]") {
+    const std::string path = GetTestPath("citra_movie_blocks_test.ctm");
+    Core::System system;
+    Core::Movie movie{system};
+
+    movie.StartRecording(path, "tester");
+    RecordInputs(movie, 0, 1500);
+    movie.SaveMovie();
+
+    auto data = ReadMovieFile(path);
+    REQUIRE(Read<u32>(data, FormatVersionOffset) == 1);
+    REQUIRE(Read<u64>(data, InputCountOffset) == 1500);
+    auto blocks = ReadBlocks(data);
+    REQUIRE(blocks.size() == 2);
+    REQUIRE(blocks[0].type == BlockType::Input);
+    REQUIRE(blocks[0].size == 1024 * StateSize);
+    REQUIRE(blocks[1].type == BlockType::Input);
+    REQUIRE(blocks[1].size == 476 * StateSize);
+
+    // Recording after a save appends to the movie
+    RecordInputs(movie, 1500, 10);
+    movie.Shutdown();
+
+    data = ReadMovieFile(path);
+    REQUIRE(Read<u64>(data, InputCountOffset) == 1510);
+    blocks = ReadBlocks(data);
+    REQUIRE(blocks.size() == 3);
+    REQUIRE(blocks[2].type == BlockType::Input);
+    REQUIRE(blocks[2].size == 10 * StateSize);
+
+    movie.StartPlayback(path);
+    REQUIRE(movie.GetPlayMode() == Core::Movie::PlayMode::Playing);
+    for (s16 i = 0; i < 1510; i++) {
+        REQUIRE(PlayInput(movie) == i);
+    }
+    REQUIRE(movie.GetPlayMode() == Core::Movie::PlayMode::MovieFinished);
+
+    movie.Shutdown();
+    FileUtil::Delete(path);
+}
+
+TEST_CASE("Movie plays movies cut short and finds their keyframes", "[core][movie]") {
+    const std::string path = GetTestPath("citra_movie_keyframes_test.ctm");
+    Core::System system;
+    Core::Movie movie{system};
+
+    movie.StartRecording(path, "tester");
+    RecordInputs(movie, 0, 10);
+    movie.Shutdown();
+    const auto recorded = ReadMovieFile(path);
+    const u8* input = recorded.data() + HeaderSize + 8;
+
+    // Header of a movie that was never saved, then 5 inputs, a keyframe, 2.5 more inputs and a
+    // keyframe past them
+    std::vector<u8> data(recorded.begin(), recorded.begin() + HeaderSize);
+    std::memset(data.data() + InputCountOffset, 0, sizeof(u64));
+    AppendBlock(data, BlockType::Input, 5 * StateSize, input, 5 * StateSize);
+    const auto append_keyframe = [&](u64 input_count, const std::string& file_name) {
+        std::vector<u8> contents(16);
+        const u64 input_byte = input_count * StateSize;
+        std::memcpy(contents.data(), &input_byte, sizeof(input_byte));
+        std::memcpy(contents.data() + 8, &input_count, sizeof(input_count));
+        contents.insert(contents.end(), file_name.begin(), file_name.end());
+        AppendBlock(data, BlockType::Keyframe, static_cast<u32>(contents.size()), contents.data(),
+                    contents.size());
+    };
+    append_keyframe(5, "first.cst");
+    append_keyframe(9, "second.cst");
+    AppendBlock(data, BlockType::Input, 5 * StateSize, input + 5 * StateSize, StateSize * 5 / 2);
+    {
+        FileUtil::IOFile file(path, "wb");
+        REQUIRE(file.WriteBytes(data.data(), data.size()) == data.size());
+    }
+
+    REQUIRE(movie.ValidateMovie(path) != Core::Movie::ValidationResult::Invalid);
+    movie.StartPlayback(path);
+    REQUIRE(movie.GetPlayMode() == Core::Movie::PlayMode::Playing);
+
+    // Frame 1 is input 3 and frame 2 is input 7, keyframe states are next to the movie
+    const auto directory = std::filesystem::path{path}.parent_path();
+    REQUIRE(movie.GetKeyframeState(1).empty());
+    REQUIRE(std::filesystem::path{movie.GetKeyframeState(2)} == directory / "first.cst");
+    // The second keyframe is past the complete inputs
+    REQUIRE(std::filesystem::path{movie.GetKeyframeState(100)} == directory / "first.cst");
+
+    for (s16 i = 0; i < 7; i++) {
+        REQUIRE(PlayInput(movie) == i);
+    }
+    REQUIRE(movie.GetPlayMode() == Core::Movie::PlayMode::MovieFinished);
+
+    movie.Shutdown();
+    FileUtil::Delete(path);
+}
+
+TEST_CASE("Movie loads states made while recording", "[core][movie]") {
+    const std::string path = GetTestPath("citra_movie_state_test.ctm");
+    Core::System system;
+    Core::Movie movie{system};
+
+    movie.StartRecording(path, "tester");
+    RecordInputs(movie, 0, 100);
+    std::stringstream state;
+    {
+        oarchive oa{state};
+        oa& movie;
+    }
+    RecordInputs(movie, 100, 50);
+
+    SECTION("Read-only loads play the recording from the state") {
+        movie.SetReadOnly(true);
+        {
+            iarchive ia{state};
+            ia& movie;
+        }
+        REQUIRE(movie.GetPlayMode() == Core::Movie::PlayMode::Playing);
+        // The recording was saved with all of its input
+        REQUIRE(movie.GetMovieMetadata(path).input_count == 150);
+        REQUIRE(PlayInput(movie) == 100);
+    }
+
+    SECTION("Read-write loads rerecord from the state") {
+        movie.SetReadOnly(false);
+        {
+            iarchive ia{state};
+            ia& movie;
+        }
+        REQUIRE(movie.GetPlayMode() == Core::Movie::PlayMode::Recording);
+        RecordInputs(movie, 1000, 20);
+        movie.Shutdown();
+
+        REQUIRE(movie.GetMovieMetadata(path).input_count == 120);
+        movie.StartPlayback(path);
+        for (s16 i = 0; i < 100; i++) {
+            REQUIRE(PlayInput(movie) == i);
+        }
+        for (s16 i = 1000; i < 1020; i++) {
+            REQUIRE(PlayInput(movie) == i);
+        }
+    }
+
+    movie.Shutdown();
+    FileUtil::Delete(path);
+}
+
+TEST_CASE("Movie rejects states from another timeline", "[core][movie]") {
+    const std::string path = GetTestPath("citra_movie_timeline_test.ctm");
+    Core::System system;
+    Core::Movie movie{system};
+
+    const auto save_state = [&](std::stringstream& state) {
+        oarchive oa{state};
+        oa& movie;
+    };
+    const auto load_state = [&](std::stringstream& state) {
+        state.seekg(0);
+        iarchive ia{state};
+        ia& movie;
+    };
+
+    movie.StartRecording(path, "tester");
+    RecordInputs(movie, 0, 50);
+    std::stringstream first_state;
+    save_state(first_state);
+    RecordInputs(movie, 50, 50);
+    std::stringstream second_state;
+    save_state(second_state);
+
+    // Rerecording from the first state replaces the input the second one was made on
+    movie.SetReadOnly(false);
+    load_state(first_state);
+    RecordInputs(movie, 1000, 50);
+
+    movie.SetReadOnly(true);
+    REQUIRE_THROWS_AS(load_state(second_state), std::runtime_error);
+    REQUIRE(movie.GetPlayMode() == Core::Movie::PlayMode::Recording);
+    movie.SetReadOnly(false);
+    REQUIRE_THROWS_AS(load_state(second_state), std::runtime_error);
+    REQUIRE(movie.GetPlayMode() == Core::Movie::PlayMode::Recording);
+
+    movie.SetReadOnly(true);
+    load_state(first_state);
+    REQUIRE(movie.GetPlayMode() == Core::Movie::PlayMode::Playing);
+    REQUIRE(PlayInput(movie) == 1000);
+
+    movie.Shutdown();
+    FileUtil::Delete(path);
+}
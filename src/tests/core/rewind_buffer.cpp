@@ -0,0 +1,118 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "core/memory.h"
+#include "core/rewind_buffer.h"
+
+namespace {
+
+constexpr std::size_t PageSize = Memory::CITRA_PAGE_SIZE;
+
+// Two regions, with enough pages to span several worker ranges
+struct TestMemory {
+    std::vector<u8> first = std::vector<u8>(3000 * PageSize);
+    std::vector<u8> second = std::vector<u8>(16 * PageSize);
+
+    std::array<std::span<u8>, 2> Regions() {
+        return {std::span{first}, std::span{second}};
+    }
+
+    void Fill(u8 value) {
+        first[5 * PageSize + 3] = value;
+        first[2500 * PageSize] = value;
+        second[15 * PageSize + PageSize - 1] = value;
+    }
+};
+
+} // Anonymous namespace
+
+TEST_CASE("MemorySnapshots restores snapshots", "[core][rewind]") {
+    Core::MemorySnapshots snapshots;
+    TestMemory memory;
+
+    memory.Fill(1);
+    REQUIRE_FALSE(snapshots.Take(memory.Regions()));
+    // The first snapshot only keeps the pages that are not zero
+    REQUIRE(snapshots.GetNumPages(0) == 3);
+
+    memory.Fill(2);
+    memory.first[100 * PageSize] = 9;
+    REQUIRE_FALSE(snapshots.Take(memory.Regions()));
+    REQUIRE(snapshots.GetNumPages(1) == 4);
+
+    memory.Fill(3);
+    std::fill(memory.first.begin(), memory.first.end(), u8{0x55});
+    const auto newest_first = memory.first;
+    const auto newest_second = memory.second;
+    REQUIRE_FALSE(snapshots.Take(memory.Regions()));
+    REQUIRE(snapshots.Size() == 3);
+
+    memory.Fill(4);
+    snapshots.Restore(1, memory.Regions());
+    REQUIRE(snapshots.Size() == 2);
+    REQUIRE(memory.first[5 * PageSize + 3] == 2);
+    REQUIRE(memory.first[2500 * PageSize] == 2);
+    REQUIRE(memory.first[100 * PageSize] == 9);
+    REQUIRE(memory.second[15 * PageSize + PageSize - 1] == 2);
+    REQUIRE(std::count(memory.first.begin(), memory.first.end(), u8{0}) ==
+            static_cast<std::ptrdiff_t>(memory.first.size() - 3));
+
+    // Pages hashes follow the restored snapshot, so only the pages changed since are taken
+    memory.first[7 * PageSize] = 1;
+    snapshots.Take(memory.Regions());
+    REQUIRE(snapshots.GetNumPages(2) == 1);
+
+    snapshots.Restore(0, memory.Regions());
+    REQUIRE(memory.first[5 * PageSize + 3] == 1);
+    REQUIRE(memory.first[100 * PageSize] == 0);
+    REQUIRE(memory.first[7 * PageSize] == 0);
+    REQUIRE(memory.first != newest_first);
+    REQUIRE(memory.second != newest_second);
+
+    REQUIRE_THROWS_AS(snapshots.Restore(1, memory.Regions()), std::runtime_error);
+}
+
+TEST_CASE("MemorySnapshots merges dropped snapshots", "[core][rewind]") {
+    Core::MemorySnapshots snapshots;
+    TestMemory memory;
+
+    memory.Fill(1);
+    memory.first[10 * PageSize] = 1;
+    snapshots.Take(memory.Regions());
+    memory.first[10 * PageSize] = 0;
+    memory.second[0] = 2;
+    snapshots.Take(memory.Regions());
+    memory.second[0] = 3;
+    snapshots.Take(memory.Regions());
+
+    // The next snapshot becomes the oldest, with every page that is not zero
+    snapshots.DropOldest();
+    REQUIRE(snapshots.Size() == 2);
+    REQUIRE(snapshots.GetNumPages(0) == 4);
+
+    memory.Fill(5);
+    snapshots.Restore(0, memory.Regions());
+    REQUIRE(memory.first[5 * PageSize + 3] == 1);
+    REQUIRE(memory.first[10 * PageSize] == 0);
+    REQUIRE(memory.second[0] == 2);
+    REQUIRE(snapshots.GetMemoryUsage() == 4 * PageSize);
+
+    // Older snapshots are dropped when the layout of the regions changes
+    TestMemory other;
+    const std::array<std::span<u8>, 1> smaller{std::span{other.first}};
+    REQUIRE(snapshots.Take(smaller));
+    REQUIRE(snapshots.Size() == 1);
+
+    snapshots.Clear();
+    REQUIRE(snapshots.Size() == 0);
+    REQUIRE(snapshots.GetMemoryUsage() == 0);
+}
@@ -0,0 +1,91 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/file_util.h"
+#include "core/core.h"
+#include "core/memory.h"
+#include "core/savestate.h"
+
+TEST_CASE("Savestate memory round trip", "[core][savestate]") {
+    constexpr u64 ProgramId = 0x0004000000123400;
+    const std::string path =
+        (std::filesystem::temp_directory_path() / "citra_savestate_memory_test.cst").string();
+
+    Core::System system;
+    Memory::MemorySystem memory{system};
+    u8* const fcram = memory.GetFCRAMPointer(0);
+    u8* const vram = memory.GetPhysicalPointer(Memory::VRAM_PADDR);
+    for (std::size_t i = 0; i < 3 * Memory::CITRA_PAGE_SIZE; i++) {
+        fcram[0x100000 + i] = static_cast<u8>(i * 7);
+    }
+    std::memset(fcram + Memory::FCRAM_SIZE - 16, 0xAB, 16);
+    std::memset(vram + 0x1234, 0xCD, 0x100);
+
+    Core::SaveStateWriter writer;
+    const Core::SaveStateChunks chunks{std::vector<u8>(1000, 1), std::vector<u8>(10, 2)};
+    writer.Write(path, ProgramId, chunks, Core::CollectSaveStateMemory(memory));
+    writer.Wait();
+
+    // The memory is restored into another memory system, as loading a state replaces it
+    const auto contents = writer.Read(path, ProgramId);
+    std::vector<u8> expected_state(chunks[0]);
+    expected_state.insert(expected_state.end(), chunks[1].begin(), chunks[1].end());
+    REQUIRE(contents.state == expected_state);
+
+    Memory::MemorySystem restored{system};
+    std::memset(restored.GetFCRAMPointer(0x200000), 0xFF, 0x1000);
+    Core::RestoreSaveStateMemory(restored, contents.memory);
+    REQUIRE(std::memcmp(restored.GetFCRAMPointer(0), fcram, Memory::FCRAM_SIZE) == 0);
+    REQUIRE(std::memcmp(restored.GetPhysicalPointer(Memory::VRAM_PADDR), vram,
+                        Memory::VRAM_SIZE) == 0);
+
+    // States of other programs are rejected
+    REQUIRE_THROWS_AS(writer.Read(path, ProgramId + 1), std::runtime_error);
+
+    FileUtil::Delete(path);
+}
+
+TEST_CASE("Savestate writer replaces slots and reports errors", "[core][savestate]") {
+    constexpr u64 ProgramId = 0x0004000000123400;
+    const auto temp_dir = std::filesystem::temp_directory_path();
+    const std::string path = (temp_dir / "citra_savestate_slot_test.cst").string();
+    Core::SaveStateWriter writer;
+
+    // A previous state of the slot is replaced
+    REQUIRE(FileUtil::WriteStringToFile(false, path, "previous state"));
+    Core::SaveStateChunks chunks;
+    for (u8 i = 0; i < 5; i++) {
+        chunks.emplace_back(0x10000 + i, i);
+    }
+    writer.Write(path, ProgramId, chunks, {});
+    writer.Wait();
+    REQUIRE_FALSE(writer.TakeError());
+    REQUIRE_FALSE(FileUtil::Exists(path + ".tmp"));
+    const auto contents = writer.Read(path, ProgramId);
+    std::size_t offset = 0;
+    for (const auto& chunk : chunks) {
+        REQUIRE(std::equal(chunk.begin(), chunk.end(), contents.state.begin() + offset));
+        offset += chunk.size();
+    }
+    REQUIRE(contents.state.size() == offset);
+    REQUIRE(contents.memory.empty());
+
+    // Failures are reported once
+    const std::string invalid_path = (temp_dir / "citra_missing_dir" / "state.cst").string();
+    writer.Write(invalid_path, ProgramId, chunks, {});
+    writer.Wait();
+    REQUIRE(writer.TakeError());
+    REQUIRE_FALSE(writer.TakeError());
+
+    FileUtil::Delete(path);
+}
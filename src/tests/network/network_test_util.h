@@ -0,0 +1,32 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <chrono>
+#include <thread>
+
+/// Tags of the network load tests. They are hidden by default as they take a while, run them
+/// with `tests "[network]"`.
+#define NETWORK_TEST_TAGS "[.][network]"
+
+/// Tags of the network tests that finish quickly, which run by default.
+#define FAST_NETWORK_TEST_TAGS "[network]"
+
+namespace NetworkTest {
+
+/// Waits until the condition is true or the timeout expired, returns the condition.
+template <typename Condition>
+bool WaitFor(Condition condition, std::chrono::seconds timeout = std::chrono::seconds(5)) {
+    const auto end = std::chrono::steady_clock::now() + timeout;
+    while (!condition()) {
+        if (std::chrono::steady_clock::now() > end) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+} // namespace NetworkTest
@@ -0,0 +1,223 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <catch2/catch_message.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+#include "network/network.h"
+#include "tests/network/network_test_util.h"
+
+using NetworkTest::WaitFor;
+
+namespace {
+
+constexpr u16 TestPort = 24899;
+
+} // Anonymous namespace
+
+// Measures the rate at which a room forwards WiFi packets between members over loopback.
+TEST_CASE("Room forwards WiFi packets", NETWORK_TEST_TAGS) {
+    constexpr std::size_t NumMembers = 8;
+    constexpr std::size_t PacketsPerMember = 2000;
+
+    REQUIRE(Network::Init());
+
+    Network::Room room;
+    REQUIRE(room.Create("Load test", "", "127.0.0.1", TestPort, "", NumMembers, "", "", 0,
+                        std::make_unique<Network::VerifyUser::NullBackend>()));
+
+    std::vector<std::unique_ptr<Network::RoomMember>> members;
+    std::atomic<std::size_t> received{0};
+    std::vector<Network::RoomMember::CallbackHandle<Network::WifiPacket>> handles;
+    for (std::size_t i = 0; i < NumMembers; i++) {
+        auto& member = members.emplace_back(std::make_unique<Network::RoomMember>());
+        handles.push_back(member->BindOnWifiPacketReceived(
+            [&received](const Network::WifiPacket&) { received++; }));
+        member->Join(fmt::format("member{}", i), fmt::format("console{}", i), "127.0.0.1",
+                     TestPort);
+    }
+    REQUIRE(WaitFor([&] {
+        return std::all_of(members.begin(), members.end(),
+                           [](const auto& member) { return member->IsConnected(); });
+    }));
+    const auto room_members = room.GetRoomMemberList();
+
+    // Every member sends to the next one, and one in eight packets is a broadcast
+    Network::WifiPacket packet{};
+    packet.type = Network::WifiPacket::PacketType::Data;
+    packet.data.resize(512);
+    std::size_t expected = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < PacketsPerMember; i++) {
+        for (std::size_t m = 0; m < NumMembers; m++) {
+            const bool broadcast = i % 8 == 0;
+            packet.destination_address = broadcast
+                                             ? Network::BroadcastMac
+                                             : room_members[(m + 1) % NumMembers].mac_address;
+            members[m]->SendWifiPacket(packet);
+            expected += broadcast ? NumMembers - 1 : 1;
+        }
+    }
+    REQUIRE(WaitFor([&] { return received == expected; }, std::chrono::seconds(60)));
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    WARN(fmt::format("Forwarded {} packets in {:.3f} s, {:.0f} packets/s", expected, seconds,
+                     static_cast<double>(expected) / seconds));
+
+    for (std::size_t i = 0; i < NumMembers; i++) {
+        members[i]->Unbind(handles[i]);
+        members[i]->Leave();
+    }
+    members.clear();
+    room.Destroy();
+    Network::Shutdown();
+}
+
+// Measures the round trip time of WiFi packets between two members of a room over loopback.
+TEST_CASE("RoomMember sends WiFi packets without delay", NETWORK_TEST_TAGS) {
+    constexpr std::size_t NumRoundTrips = 200;
+
+    REQUIRE(Network::Init());
+
+    Network::Room room;
+    REQUIRE(room.Create("Latency test", "", "127.0.0.1", TestPort, "", 2, "", "", 0,
+                        std::make_unique<Network::VerifyUser::NullBackend>()));
+
+    Network::RoomMember sender;
+    Network::RoomMember echoer;
+    sender.Join("sender", "console0", "127.0.0.1", TestPort);
+    echoer.Join("echoer", "console1", "127.0.0.1", TestPort);
+    REQUIRE(WaitFor([&] { return sender.IsConnected() && echoer.IsConnected(); }));
+
+    Network::WifiPacket packet{};
+    packet.type = Network::WifiPacket::PacketType::Data;
+    packet.data.resize(64);
+    packet.transmitter_address = sender.GetMacAddress();
+    packet.destination_address = echoer.GetMacAddress();
+
+    // The echoer sends every packet back to the sender
+    const auto echo_handle =
+        echoer.BindOnWifiPacketReceived([&echoer](const Network::WifiPacket& received) {
+            Network::WifiPacket reply = received;
+            std::swap(reply.transmitter_address, reply.destination_address);
+            echoer.SendWifiPacket(reply);
+        });
+    std::atomic<std::size_t> replies{0};
+    const auto reply_handle =
+        sender.BindOnWifiPacketReceived([&replies](const Network::WifiPacket&) { replies++; });
+
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < NumRoundTrips; i++) {
+        sender.SendWifiPacket(packet);
+        REQUIRE(WaitFor([&] { return replies == i + 1; }));
+    }
+    const double round_trip_ms =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+            .count() /
+        NumRoundTrips;
+    WARN(fmt::format("Average round trip time: {:.3f} ms", round_trip_ms));
+
+    echoer.Unbind(echo_handle);
+    sender.Unbind(reply_handle);
+    sender.Leave();
+    echoer.Leave();
+    room.Destroy();
+    Network::Shutdown();
+}
+
+// Control packets are never dropped, and WiFi packets sent after them never arrive before them.
+TEST_CASE("RoomMember drops WiFi packets without reordering", FAST_NETWORK_TEST_TAGS) {
+    constexpr u32 NumPackets = 20000;
+    constexpr u32 ChatInterval = 100;
+
+    REQUIRE(Network::Init());
+
+    Network::Room room;
+    REQUIRE(room.Create("Order test", "", "127.0.0.1", TestPort, "", 2, "", "", 0,
+                        std::make_unique<Network::VerifyUser::NullBackend>()));
+
+    Network::RoomMember sender;
+    Network::RoomMember receiver;
+    sender.Join("sender", "console0", "127.0.0.1", TestPort);
+    receiver.Join("receiver", "console1", "127.0.0.1", TestPort);
+    REQUIRE(WaitFor([&] {
+        return sender.GetState() == Network::RoomMember::State::Joined &&
+               receiver.GetState() == Network::RoomMember::State::Joined;
+    }));
+
+    // Index of every received packet, chat messages holding the index of the next WiFi packet
+    struct Received {
+        bool chat;
+        u32 index;
+    };
+    std::mutex received_mutex;
+    std::vector<Received> received;
+    const auto wifi_handle =
+        receiver.BindOnWifiPacketReceived([&](const Network::WifiPacket& packet) {
+            u32 index;
+            std::memcpy(&index, packet.data.data(), sizeof(index));
+            std::scoped_lock lock{received_mutex};
+            received.push_back({false, index});
+        });
+    const auto chat_handle =
+        receiver.BindOnChatMessageRecieved([&](const Network::ChatEntry& entry) {
+            std::scoped_lock lock{received_mutex};
+            received.push_back({true, static_cast<u32>(std::stoul(entry.message))});
+        });
+
+    // Packets are queued much faster than the member loop sends them, so the queue overflows
+    Network::WifiPacket packet{};
+    packet.type = Network::WifiPacket::PacketType::Data;
+    packet.destination_address = receiver.GetMacAddress();
+    packet.data.resize(512);
+    u32 sent = 0;
+    for (u32 i = 0; i < NumPackets; i++) {
+        if (i % ChatInterval == 0) {
+            sender.SendChatMessage(std::to_string(i));
+        }
+        std::memcpy(packet.data.data(), &i, sizeof(i));
+        sent += sender.SendWifiPacket(packet) ? 1 : 0;
+    }
+    const u32 num_chats = NumPackets / ChatInterval;
+    REQUIRE(WaitFor(
+        [&] {
+            std::scoped_lock lock{received_mutex};
+            return received.size() == sent + num_chats;
+        },
+        std::chrono::seconds(30)));
+
+    u32 next_chat = 0;
+    u32 last_chat = 0;
+    u32 next_wifi = 0;
+    for (const auto& [chat, index] : received) {
+        if (chat) {
+            REQUIRE(index == next_chat);
+            last_chat = index;
+            next_chat += ChatInterval;
+        } else {
+            REQUIRE(index >= next_wifi);
+            // Neither sent before the last message nor after the next one
+            REQUIRE(index >= last_chat);
+            REQUIRE(index < next_chat);
+            next_wifi = index + 1;
+        }
+    }
+    REQUIRE(next_chat == NumPackets);
+
+    receiver.Unbind(wifi_handle);
+    receiver.Unbind(chat_handle);
+    sender.Leave();
+    receiver.Leave();
+    room.Destroy();
+    Network::Shutdown();
+}
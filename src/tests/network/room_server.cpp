@@ -0,0 +1,227 @@
+// Copyright 2026 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <catch2/catch_message.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+#include "network/network.h"
+#include "network/room_server.h"
+#include "tests/network/network_test_util.h"
+
+using NetworkTest::WaitFor;
+
+namespace {
+
+constexpr u16 FirstPort = 24900;
+// Ports of the fast tests, after the ones of the load test
+constexpr u16 FirstFastTestPort = 24930;
+
+Network::RoomServer::RoomSettings MakeSettings(u16 port) {
+    Network::RoomServer::RoomSettings settings;
+    settings.name = fmt::format("Room {}", port);
+    settings.server_address = "127.0.0.1";
+    settings.port = port;
+    settings.max_members = 4;
+    return settings;
+}
+
+std::shared_ptr<Network::Room> CreateRoom(Network::RoomServer& server,
+                                          const Network::RoomServer::RoomSettings& settings) {
+    return server.CreateRoom(settings, std::make_unique<Network::VerifyUser::NullBackend>());
+}
+
+bool IsJoined(const Network::RoomMember& member) {
+    return member.GetState() == Network::RoomMember::State::Joined;
+}
+
+} // Anonymous namespace
+
+// Synthetic clients generating traffic in many rooms of a server over loopback.
+TEST_CASE("RoomServer hosts many rooms", NETWORK_TEST_TAGS) {
+    constexpr std::size_t NumRooms = 16;
+    constexpr std::size_t MembersPerRoom = 4;
+    constexpr std::size_t PacketsPerMember = 500;
+
+    REQUIRE(Network::Init());
+    {
+        Network::RoomServer server{4};
+        for (std::size_t i = 0; i < NumRooms; i++) {
+            Network::RoomServer::RoomSettings settings;
+            settings.name = fmt::format("Room {}", i);
+            settings.server_address = "127.0.0.1";
+            settings.port = static_cast<u16>(FirstPort + i);
+            settings.max_members = MembersPerRoom;
+            REQUIRE(
+                server.CreateRoom(settings, std::make_unique<Network::VerifyUser::NullBackend>()));
+        }
+        REQUIRE(server.GetRooms().size() == NumRooms);
+
+        std::vector<std::unique_ptr<Network::RoomMember>> members;
+        std::atomic<std::size_t> received{0};
+        std::vector<Network::RoomMember::CallbackHandle<Network::WifiPacket>> handles;
+        for (std::size_t i = 0; i < NumRooms * MembersPerRoom; i++) {
+            auto& member = members.emplace_back(std::make_unique<Network::RoomMember>());
+            handles.push_back(member->BindOnWifiPacketReceived(
+                [&received](const Network::WifiPacket&) { received++; }));
+            member->Join(fmt::format("member{}", i), fmt::format("console{}", i), "127.0.0.1",
+                         static_cast<u16>(FirstPort + i / MembersPerRoom));
+        }
+        REQUIRE(WaitFor([&] {
+            return std::all_of(members.begin(), members.end(),
+                               [](const auto& member) { return member->IsConnected(); });
+        }));
+
+        // Every member broadcasts to the others of its room
+        Network::WifiPacket packet{};
+        packet.type = Network::WifiPacket::PacketType::Data;
+        packet.destination_address = Network::BroadcastMac;
+        packet.data.resize(512);
+        const std::size_t expected = members.size() * PacketsPerMember * (MembersPerRoom - 1);
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < PacketsPerMember; i++) {
+            for (auto& member : members) {
+                member->SendWifiPacket(packet);
+            }
+        }
+        REQUIRE(WaitFor([&] { return received == expected; }, std::chrono::seconds(60)));
+        const double seconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        WARN(fmt::format("Forwarded {} packets in {} rooms in {:.3f} s, {:.0f} packets/s",
+                         expected, NumRooms, seconds, static_cast<double>(expected) / seconds));
+
+        // Rooms are closed once their members left
+        for (std::size_t i = 0; i < members.size(); i++) {
+            members[i]->Unbind(handles[i]);
+            members[i]->Leave();
+        }
+        REQUIRE(server.Drain(std::chrono::seconds(5)));
+        REQUIRE(server.GetRooms().empty());
+        members.clear();
+    }
+    Network::Shutdown();
+}
+
+TEST_CASE("RoomServer rate limits the packets of members", FAST_NETWORK_TEST_TAGS) {
+    constexpr u32 RateLimit = 10;
+    constexpr std::size_t NumPackets = 100;
+
+    REQUIRE(Network::Init());
+    {
+        Network::RoomServer server{1};
+        auto settings = MakeSettings(FirstFastTestPort);
+        settings.rate_limit = RateLimit;
+        REQUIRE(CreateRoom(server, settings));
+
+        Network::RoomMember sender;
+        Network::RoomMember receiver;
+        std::atomic<std::size_t> received{0};
+        const auto handle = receiver.BindOnWifiPacketReceived(
+            [&received](const Network::WifiPacket&) { received++; });
+        sender.Join("sender", "console0", "127.0.0.1", FirstFastTestPort);
+        receiver.Join("receiver", "console1", "127.0.0.1", FirstFastTestPort);
+        REQUIRE(WaitFor([&] { return IsJoined(sender) && IsJoined(receiver); }));
+
+        Network::WifiPacket packet{};
+        packet.type = Network::WifiPacket::PacketType::Data;
+        packet.destination_address = Network::BroadcastMac;
+        packet.data.resize(64);
+        for (std::size_t i = 0; i < NumPackets; i++) {
+            sender.SendWifiPacket(packet);
+        }
+
+        // A burst of one second worth of packets goes through, most of the others are dropped
+        REQUIRE(WaitFor([&] { return received >= RateLimit; }));
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        REQUIRE(received < NumPackets / 2);
+
+        receiver.Unbind(handle);
+        sender.Leave();
+        receiver.Leave();
+    }
+    Network::Shutdown();
+}
+
+TEST_CASE("RoomServer drains its rooms", FAST_NETWORK_TEST_TAGS) {
+    const u16 port = FirstFastTestPort + 1;
+
+    REQUIRE(Network::Init());
+    {
+        Network::RoomServer server{1};
+        REQUIRE(CreateRoom(server, MakeSettings(port)));
+
+        Network::RoomMember member;
+        member.Join("member", "console0", "127.0.0.1", port);
+        REQUIRE(WaitFor([&] { return IsJoined(member); }));
+
+        SECTION("Rooms close once their members left") {
+            auto drained = std::async(std::launch::async,
+                                      [&server] { return server.Drain(std::chrono::seconds(5)); });
+            // Drain stops accepting members before it starts waiting
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+            Network::RoomMember late;
+            std::atomic<bool> rejected{false};
+            const auto error_handle = late.BindOnError([&rejected](const auto& error) {
+                rejected = error == Network::RoomMember::Error::RoomIsFull;
+            });
+            late.Join("late", "console1", "127.0.0.1", port);
+            REQUIRE(WaitFor([&] { return rejected.load(); }));
+            late.Unbind(error_handle);
+
+            member.Leave();
+            REQUIRE(drained.get());
+        }
+
+        SECTION("Rooms close when the timeout expires") {
+            REQUIRE_FALSE(server.Drain(std::chrono::milliseconds(200)));
+            REQUIRE(WaitFor([&] { return !member.IsConnected(); }));
+        }
+        REQUIRE(server.GetRooms().empty());
+    }
+    Network::Shutdown();
+}
+
+TEST_CASE("RoomServer rooms share their ban list", FAST_NETWORK_TEST_TAGS) {
+    const u16 first_port = FirstFastTestPort + 2;
+
+    REQUIRE(Network::Init());
+    {
+        Network::RoomServer server{2};
+        const auto ban_list = std::make_shared<Network::Room::SharedBanList>();
+        for (u16 port = first_port; port < first_port + 2; port++) {
+            auto settings = MakeSettings(port);
+            settings.shared_ban_list = ban_list;
+            REQUIRE(CreateRoom(server, settings));
+        }
+
+        Network::RoomMember first;
+        first.Join("first", "console0", "127.0.0.1", first_port);
+        REQUIRE(WaitFor([&] { return IsJoined(first); }));
+
+        // A ban added to the shared list applies to every room
+        {
+            std::scoped_lock lock{ban_list->mutex};
+            ban_list->ban_list.second.push_back("127.0.0.1");
+        }
+        Network::RoomMember second;
+        std::atomic<bool> banned{false};
+        const auto error_handle = second.BindOnError([&banned](const auto& error) {
+            banned = error == Network::RoomMember::Error::HostBanned;
+        });
+        second.Join("second", "console1", "127.0.0.1", static_cast<u16>(first_port + 1));
+        REQUIRE(WaitFor([&] { return banned.load(); }));
+
+        second.Unbind(error_handle);
+        first.Leave();
+    }
+    Network::Shutdown();
+}
@@ -8,6 +8,7 @@
 #include "core/core_timing.h"
 #include "core/hle/service/gsp/gsp_gpu.h"
 #include "core/hle/service/plgldr/plgldr.h"
+#include "core/tracer/recorder.h"
 #include "video_core/debug_utils/debug_utils.h"
 #include "video_core/gpu.h"
 #include "video_core/gpu_debugger.h"
@@ -25,6 +26,28 @@ constexpr VAddr VADDR_GPU = 0x1EF00000;
 MICROPROFILE_DEFINE(GPU_DisplayTransfer, "GPU", "DisplayTransfer", MP_RGB(100, 100, 255));
 MICROPROFILE_DEFINE(GPU_CmdlistProcessing, "GPU", "Cmdlist Processing", MP_RGB(100, 255, 100));
 
+namespace {
+
+void RecordRegister(CiTrace::Recorder& recorder, u32 index, u32 value) {
+    recorder.RegisterWritten(CiTrace::GpuRegistersBase + index * sizeof(u32), value);
+}
+
+/// Records a block of GPU registers, the one that triggers the operation last.
+template <typename T>
+void RecordRegisterBlock(CiTrace::Recorder& recorder, u32 first, const T& block, u32 trigger) {
+    static_assert(sizeof(T) % sizeof(u32) == 0);
+    std::array<u32, sizeof(T) / sizeof(u32)> values;
+    std::memcpy(values.data(), &block, sizeof(T));
+    for (u32 i = 0; i < values.size(); i++) {
+        if (first + i != trigger) {
+            RecordRegister(recorder, first + i, values[i]);
+        }
+    }
+    RecordRegister(recorder, trigger, values[trigger - first]);
+}
+
+} // Anonymous namespace
+
 struct GPU::Impl {
     Core::Timing& timing;
     Core::System& system;
@@ -46,6 +69,10 @@ struct GPU::Impl {
           rasterizer{renderer->Rasterizer()}, sw_blitter{std::make_unique<SwRenderer::SwBlitter>(
                                                   memory, rasterizer)} {}
     ~Impl() = default;
+
+    CiTrace::Recorder* Recorder() const {
+        return debug_context ? debug_context->recorder.get() : nullptr;
+    }
 };
 
 GPU::GPU(Core::System& system, Frontend::EmuWindow& emu_window,
@@ -270,6 +297,9 @@ void GPU::WriteReg(VAddr addr, u32 data) {
         ASSERT(addr % sizeof(u32) == 0);
         ASSERT(index < Pica::RegsLcd::NumIds());
         impl->pica.regs_lcd[index] = data;
+        if (auto* recorder = impl->Recorder()) {
+            recorder->RegisterWritten(CiTrace::LcdRegistersBase + offset, data);
+        }
         break;
     }
     case VADDR_GPU:
@@ -299,6 +329,10 @@ void GPU::WriteReg(VAddr addr, u32 data) {
             SubmitCmdList(1);
             break;
         default:
+            // Writes that trigger operations are recorded along with the data they need.
+            if (auto* recorder = impl->Recorder()) {
+                RecordRegister(*recorder, index, data);
+            }
             break;
         }
         break;
@@ -344,7 +378,21 @@ void GPU::SubmitCmdList(u32 index) {
     // Forward command list processing to the PICA core.
     const PAddr addr = config.GetPhysicalAddress(index);
     const u32 size = config.GetSize(index);
+    const u32 size_reg = config.size[index];
+    const u32 addr_reg = config.addr[index];
     impl->pica.ProcessCmdList(addr, size);
+
+    // The PICA core records the memory read by the command list while processing it, so the
+    // registers that start it are recorded after it.
+    if (auto* recorder = impl->Recorder()) {
+        RecordRegister(*recorder, GPU_REG_INDEX(internal.pipeline.command_buffer.size[0]) + index,
+                       size_reg);
+        RecordRegister(*recorder, GPU_REG_INDEX(internal.pipeline.command_buffer.addr[0]) + index,
+                       addr_reg);
+        RecordRegister(*recorder,
+                       GPU_REG_INDEX(internal.pipeline.command_buffer.trigger[0]) + index,
+                       config.trigger[index]);
+    }
     config.trigger[index] = 0;
 }
 
@@ -355,6 +403,14 @@ void GPU::MemoryFill(u32 index) {
         return;
     }
 
+    if (auto* recorder = impl->Recorder()) {
+        const u32 first = GPU_REG_INDEX(memory_fill_config[0]) +
+                          index * static_cast<u32>(sizeof(config) / sizeof(u32));
+        const u32 trigger = first + static_cast<u32>(GPU_REG_INDEX(memory_fill_config[0].trigger) -
+                                                     GPU_REG_INDEX(memory_fill_config[0]));
+        RecordRegisterBlock(*recorder, first, config, trigger);
+    }
+
     // Perform memory fill.
     if (!impl->rasterizer->AccelerateFill(config)) {
         impl->sw_blitter->MemoryFill(config);
@@ -390,6 +446,26 @@ void GPU::MemoryTransfer() {
         impl->debug_context->OnEvent(Pica::DebugContext::Event::IncomingDisplayTransfer, nullptr);
     }
 
+    if (auto* recorder = impl->Recorder()) {
+        const PAddr input_address = config.GetPhysicalInputAddress();
+        u32 input_size;
+        if (config.is_texture_copy) {
+            const u32 size = config.texture_copy.size & ~0xF;
+            const u32 width = config.texture_copy.input_width * 16;
+            const u32 gap = config.texture_copy.input_gap * 16;
+            input_size = width == 0 ? size : (size + width - 1) / width * (width + gap);
+        } else {
+            input_size = config.input_width * config.input_height *
+                         Pica::BytesPerPixel(config.input_format);
+        }
+        impl->rasterizer->FlushRegion(input_address, input_size);
+        if (const u8* input = impl->memory.GetPhysicalPointer(input_address)) {
+            recorder->MemoryAccessed(input, input_size, input_address);
+        }
+        RecordRegisterBlock(*recorder, GPU_REG_INDEX(display_transfer_config), config,
+                            GPU_REG_INDEX(display_transfer_config.trigger));
+    }
+
     // Perform memory transfer
     if (config.is_texture_copy) {
         if (!impl->rasterizer->AccelerateTextureCopy(config)) {
@@ -410,6 +486,10 @@ void GPU::VBlankCallback(std::uintptr_t user_data, s64 cycles_late) {
     // Present renderered frame.
     impl->renderer->SwapBuffers();
 
+    if (auto* recorder = impl->Recorder()) {
+        recorder->FrameFinished();
+    }
+
     // Signal to GSP that GPU interrupt has occurred
     impl->signal_interrupt(Service::GSP::InterruptId::PDC0);
     impl->signal_interrupt(Service::GSP::InterruptId::PDC1);
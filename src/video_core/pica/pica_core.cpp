@@ -5,15 +5,18 @@
 #include "common/arch.h"
 #include "common/archives.h"
 #include "common/microprofile.h"
+#include "common/perf_counters.h"
 #include "common/scope_exit.h"
 #include "common/settings.h"
 #include "core/core.h"
 #include "core/memory.h"
+#include "core/tracer/recorder.h"
 #include "video_core/debug_utils/debug_utils.h"
 #include "video_core/pica/pica_core.h"
 #include "video_core/pica/vertex_loader.h"
 #include "video_core/rasterizer_interface.h"
 #include "video_core/shader/shader.h"
+#include "video_core/texture/texture_decode.h"
 
 namespace Pica {
 
@@ -96,6 +99,7 @@ void PicaCore::ProcessCmdList(PAddr list, u32 size) {
     // Initialize command list tracking.
     const u8* head = memory.GetPhysicalPointer(list);
     cmd_list.Reset(list, head, size);
+    RecordMemory(list, size);
 
     while (cmd_list.current_index < cmd_list.length) {
         // Align read pointer to 8 bytes
@@ -119,6 +123,83 @@ void PicaCore::ProcessCmdList(PAddr list, u32 size) {
     }
 }
 
+void PicaCore::ResetPipeline() {
+    primitive_assembler.Reconfigure(regs.internal.pipeline.triangle_topology);
+    immediate.Reset();
+}
+
+void PicaCore::RecordMemory(PAddr addr, u32 size) {
+    if (!debug_context || !debug_context->recorder || size == 0) {
+        return;
+    }
+
+    // Hardware renderers may hold newer data than emulated memory.
+    rasterizer->FlushRegion(addr, size);
+    const u8* data = memory.GetPhysicalPointer(addr);
+    if (data) {
+        debug_context->recorder->MemoryAccessed(data, size, addr);
+    }
+}
+
+void PicaCore::RecordDrawMemory(bool is_indexed) {
+    const auto& pipeline = regs.internal.pipeline;
+    if (pipeline.num_vertices == 0) {
+        return;
+    }
+
+    // Find the range of vertices the draw uses.
+    const PAddr base_address = pipeline.vertex_attributes.GetPhysicalBaseAddress();
+    u32 min_vertex = pipeline.vertex_offset;
+    u32 max_vertex = pipeline.vertex_offset + pipeline.num_vertices - 1;
+    if (is_indexed) {
+        const auto& index_info = pipeline.index_array;
+        const bool index_u16 = index_info.format != 0;
+        const PAddr index_address = base_address + index_info.offset;
+        RecordMemory(index_address, pipeline.num_vertices * (index_u16 ? 2 : 1));
+
+        const u8* index_address_8 = memory.GetPhysicalPointer(index_address);
+        if (!index_address_8) {
+            return;
+        }
+        min_vertex = 0xFFFF;
+        max_vertex = 0;
+        for (u32 index = 0; index < pipeline.num_vertices; ++index) {
+            u32 vertex = index_address_8[index];
+            if (index_u16) {
+                u16 vertex_16;
+                std::memcpy(&vertex_16, index_address_8 + index * sizeof(u16), sizeof(u16));
+                vertex = vertex_16;
+            }
+            min_vertex = std::min(min_vertex, vertex);
+            max_vertex = std::max(max_vertex, vertex);
+        }
+    }
+
+    for (const auto& loader : pipeline.vertex_attributes.attribute_loaders) {
+        if (loader.component_count == 0 || loader.byte_count == 0) {
+            continue;
+        }
+        RecordMemory(base_address + loader.data_offset + min_vertex * loader.byte_count,
+                     (max_vertex - min_vertex + 1) * loader.byte_count);
+    }
+
+    // Cube maps are left out as their faces are scattered over several addresses.
+    for (const auto& texture : regs.internal.texturing.GetTextures()) {
+        if (!texture.enabled ||
+            texture.config.type != TexturingRegs::TextureConfig::Texture2D) {
+            continue;
+        }
+        const u32 tile_size = static_cast<u32>(Texture::CalculateTileSize(texture.format));
+        u32 size = 0;
+        for (u32 level = 0; level <= texture.config.lod.max_level; level++) {
+            const u32 width = std::max(texture.config.width >> level, 8u);
+            const u32 height = std::max(texture.config.height >> level, 8u);
+            size += width * height / 64 * tile_size;
+        }
+        RecordMemory(texture.config.GetPhysicalAddress(), size);
+    }
+}
+
 void PicaCore::WriteInternalReg(u32 id, u32 value, u32 mask) {
     if (id >= RegsInternal::NUM_REGS) {
         LOG_ERROR(
@@ -185,6 +266,7 @@ void PicaCore::WriteInternalReg(u32 id, u32 value, u32 mask) {
         const u32 size = regs.internal.pipeline.command_buffer.GetSize(index);
         const u8* head = memory.GetPhysicalPointer(addr);
         cmd_list.Reset(addr, head, size);
+        RecordMemory(addr, size);
         break;
     }
 
@@ -467,6 +549,7 @@ void PicaCore::DrawImmediate() {
     // Invoke the vertex shader for the vertex.
     shader_unit.LoadInput(regs.internal.vs, immediate.input_vertex);
     shader_engine->Run(vs_setup, shader_unit);
+    Common::PerfCounters::Add(Common::PerfCounters::Counter::VerticesShaded);
     shader_unit.WriteOutput(regs.internal.vs, output);
 
     // Reconfigure geometry pipeline if needed.
@@ -487,6 +570,7 @@ void PicaCore::DrawImmediate() {
 
 void PicaCore::DrawArrays(bool is_indexed) {
     MICROPROFILE_SCOPE(GPU_Drawing);
+    Common::PerfCounters::Add(Common::PerfCounters::Counter::DrawCalls);
 
     // Track vertex in the debug recorder.
     if (debug_context) {
@@ -495,6 +579,10 @@ void PicaCore::DrawArrays(bool is_indexed) {
             { debug_context->OnEvent(DebugContext::Event::FinishedPrimitiveBatch, nullptr); });
     }
 
+    if (debug_context && debug_context->recorder) {
+        RecordDrawMemory(is_indexed);
+    }
+
     const bool accelerate_draw = [this] {
         // Geometry shaders cannot be accelerated due to register preservation.
         if (regs.internal.pipeline.use_gs == PipelineRegs::UseGS::Yes) {
@@ -519,6 +607,8 @@ void PicaCore::DrawArrays(bool is_indexed) {
 
     // Attempt to use hardware vertex shaders if possible.
     if (accelerate_draw && rasterizer->AccelerateDrawBatch(is_indexed)) {
+        Common::PerfCounters::Add(Common::PerfCounters::Counter::VerticesShaded,
+                                  regs.internal.pipeline.num_vertices);
         return;
     }
 
@@ -548,6 +638,7 @@ void PicaCore::LoadVertices(bool is_indexed) {
     std::array<u16, VERTEX_CACHE_SIZE> vertex_cache_ids;
     std::array<AttributeBuffer, VERTEX_CACHE_SIZE> vertex_cache;
     u32 vertex_cache_pos = 0;
+    u32 vertices_shaded = 0;
 
     // Compile the vertex shader for this batch.
     ShaderUnit shader_unit;
@@ -596,6 +687,7 @@ void PicaCore::LoadVertices(bool is_indexed) {
             shader_unit.LoadInput(regs.internal.vs, input);
             shader_engine->Run(vs_setup, shader_unit);
             shader_unit.WriteOutput(regs.internal.vs, vs_output);
+            vertices_shaded++;
 
             // Cache the vertex when doing indexed rendering.
             if (is_indexed) {
@@ -609,6 +701,7 @@ void PicaCore::LoadVertices(bool is_indexed) {
         // Send to geometry pipeline
         geometry_pipeline.SubmitVertex(vs_output);
     }
+    Common::PerfCounters::Add(Common::PerfCounters::Counter::VerticesShaded, vertices_shaded);
 }
 
 template <class Archive>
@@ -38,9 +38,18 @@ public:
 
     void ProcessCmdList(PAddr list, u32 size);
 
+    /// Discards the vertices buffered by the primitive assembler and immediate mode.
+    void ResetPipeline();
+
 private:
     void InitializeRegs();
 
+    /// Stores the contents of a memory region in the CiTrace being recorded, if any.
+    void RecordMemory(PAddr addr, u32 size);
+
+    /// Stores the vertex, index and texture data a draw reads in the CiTrace being recorded.
+    void RecordDrawMemory(bool is_indexed);
+
     void WriteInternalReg(u32 id, u32 value, u32 mask);
 
     void SubmitImmediate(u32 data);
@@ -14,5 +14,7 @@ MICROPROFILE_DEFINE(RasterizerCache_DownloadSurface, "RasterizerCache", "Downloa
                     MP_RGB(128, 192, 64));
 MICROPROFILE_DEFINE(RasterizerCache_Invalidation, "RasterizerCache", "Invalidation",
                     MP_RGB(128, 64, 192));
+MICROPROFILE_DEFINE(RasterizerCache_FlushRegion, "RasterizerCache", "FlushRegion",
+                    MP_RGB(192, 128, 64));
 
 } // namespace VideoCore
@@ -10,6 +10,7 @@
 #include "common/alignment.h"
 #include "common/logging/log.h"
 #include "common/microprofile.h"
+#include "common/perf_counters.h"
 #include "common/scope_exit.h"
 #include "common/settings.h"
 #include "core/memory.h"
@@ -27,6 +28,7 @@ MICROPROFILE_DECLARE(RasterizerCache_CopySurface);
 MICROPROFILE_DECLARE(RasterizerCache_UploadSurface);
 MICROPROFILE_DECLARE(RasterizerCache_DownloadSurface);
 MICROPROFILE_DECLARE(RasterizerCache_Invalidation);
+MICROPROFILE_DECLARE(RasterizerCache_FlushRegion);
 
 constexpr auto RangeFromInterval(const auto& map, const auto& interval) {
     return boost::make_iterator_range(map.equal_range(interval));
@@ -466,8 +468,11 @@ SurfaceId RasterizerCache<T>::GetSurface(const SurfaceParams& params, ScaleMatch
     SurfaceId surface_id = FindMatch<MatchFlags::Exact>(params, match_res_scale);
 
     if (!surface_id) {
+        Common::PerfCounters::Add(Common::PerfCounters::Counter::SurfaceCacheMisses);
         surface_id = CreateSurface(params);
         RegisterSurface(surface_id);
+    } else {
+        Common::PerfCounters::Add(Common::PerfCounters::Counter::SurfaceCacheHits);
     }
 
     if (load_if_create) {
@@ -486,6 +491,9 @@ typename RasterizerCache<T>::SurfaceRect_Tuple RasterizerCache<T>::GetSurfaceSub
 
     // Attempt to find encompassing surface
     SurfaceId surface_id = FindMatch<MatchFlags::SubRect>(params, match_res_scale);
+    if (surface_id) {
+        Common::PerfCounters::Add(Common::PerfCounters::Counter::SurfaceCacheHits);
+    }
 
     // Check if FindMatch failed because of res scaling. If that's the case create a new surface
     // with the dimensions of the lower res_scale surface to suggest it should not be used again.
@@ -495,6 +503,7 @@ typename RasterizerCache<T>::SurfaceRect_Tuple RasterizerCache<T>::GetSurfaceSub
             SurfaceParams new_params = slot_surfaces[surface_id];
             new_params.res_scale = params.res_scale;
 
+            Common::PerfCounters::Add(Common::PerfCounters::Counter::SurfaceCacheMisses);
             surface_id = CreateSurface(new_params);
             RegisterSurface(surface_id);
         }
@@ -1017,11 +1026,16 @@ void RasterizerCache<T>::UploadSurface(Surface& surface, SurfaceInterval interva
     }
 
     const auto upload_data = source_ptr.GetWriteBytes(load_info.end - load_info.addr);
+    Common::PerfCounters::Add(Common::PerfCounters::Counter::TextureUploads);
+    Common::PerfCounters::Add(Common::PerfCounters::Counter::TextureUploadBytes,
+                              upload_data.size());
     DecodeTexture(load_info, load_info.addr, load_info.end, upload_data, staging.mapped,
                   runtime.NeedsConversion(surface.pixel_format));
 
+    // Dumping is skipped in turbo mode, the texture is dumped when uploaded again later
     const bool should_dump = False(surface.flags & SurfaceFlagBits::Custom) &&
-                             False(surface.flags & SurfaceFlagBits::RenderTarget);
+                             False(surface.flags & SurfaceFlagBits::RenderTarget) &&
+                             !renderer.IsTurbo();
     if (dump_textures && should_dump) {
         const u64 hash = ComputeHash(load_info, upload_data);
         const u32 level = surface.LevelOf(load_info.addr);
@@ -1244,6 +1258,7 @@ void RasterizerCache<T>::FlushRegion(PAddr addr, u32 size, SurfaceId flush_surfa
         return;
     }
 
+    MICROPROFILE_SCOPE(RasterizerCache_FlushRegion);
     const SurfaceInterval flush_interval(addr, addr + size);
     SurfaceRegions flushed_intervals;
 
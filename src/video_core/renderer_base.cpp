@@ -4,6 +4,7 @@
 
 #include "common/settings.h"
 #include "core/core.h"
+#include "core/dumping/backend.h"
 #include "core/frontend/emu_window.h"
 #include "core/tracer/recorder.h"
 #include "video_core/debug_utils/debug_utils.h"
@@ -51,6 +52,32 @@ void RendererBase::EndFrame() {
     system.perf_stats->BeginSystemFrame();
 }
 
+bool RendererBase::ShouldPresent() {
+    // Screenshots and video dumps need every frame they capture to be rendered
+    const auto video_dumper = system.GetVideoDumper();
+    if (!IsTurbo() || settings.screenshot_requested ||
+        (video_dumper && video_dumper->IsDumping())) {
+        frames_since_present = 0;
+        return true;
+    }
+
+    // An interval of 0 presents at the refresh rate of a typical display
+    constexpr auto DisplayRefreshPeriod = std::chrono::microseconds{1000000 / 60};
+    const u32 interval = Settings::values.turbo_present_interval.GetValue();
+    const auto now = std::chrono::steady_clock::now();
+    const bool present = interval != 0 ? ++frames_since_present >= interval
+                                       : now - last_present_time >= DisplayRefreshPeriod;
+    if (present) {
+        frames_since_present = 0;
+        last_present_time = now;
+    }
+    return present;
+}
+
+bool RendererBase::IsTurbo() const {
+    return system.frame_limiter.IsTurbo();
+}
+
 bool RendererBase::IsScreenshotPending() const {
     return settings.screenshot_requested;
 }
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <chrono>
 #include "common/common_types.h"
 #include "core/frontend/framebuffer_layout.h"
 #include "video_core/rasterizer_interface.h"
@@ -75,6 +76,13 @@ public:
     /// Ends the current frame
     void EndFrame();
 
+    /// Returns whether the current frame should be presented. Only some frames are presented in
+    /// turbo mode, the others are skipped by SwapBuffers.
+    [[nodiscard]] bool ShouldPresent();
+
+    /// Returns true if the emulator runs in turbo mode
+    [[nodiscard]] bool IsTurbo() const;
+
     f32 GetCurrentFPS() const {
         return current_fps;
     }
@@ -113,6 +121,10 @@ protected:
     Frontend::EmuWindow* secondary_window; ///< Reference to the secondary render window handle.
     f32 current_fps = 0.0f;                ///< Current framerate, should be set by the renderer
     s32 current_frame = 0;                 ///< Current frame, should be set by the renderer
+
+private:
+    u32 frames_since_present = 0; ///< Frames skipped since the last presented one in turbo mode
+    std::chrono::steady_clock::time_point last_present_time{};
 };
 
 } // namespace VideoCore
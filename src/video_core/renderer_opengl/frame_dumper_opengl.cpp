@@ -4,6 +4,7 @@
 
 #include <glad/glad.h>
 
+#include <cstring>
 #include <utility>
 
 #include "core/core.h"
@@ -38,7 +39,11 @@ void FrameDumperOpenGL::StartDumping() {
 }
 
 void FrameDumperOpenGL::StopDumping() {
+    // Wait for the pending readbacks to reach the video dumper before it receives the end of data
     present_thread.request_stop();
+    if (present_thread.joinable()) {
+        present_thread.join();
+    }
 }
 
 void FrameDumperOpenGL::PresentLoop(std::stop_token stop_token) {
@@ -58,38 +63,58 @@ void FrameDumperOpenGL::PresentLoop(std::stop_token stop_token) {
         }
         glWaitSync(frame->render_fence, 0, GL_TIMEOUT_IGNORED);
 
+        // Reuse the oldest readback, whose copy had the most time to complete
+        auto& readback = readbacks[next_readback];
+        next_readback = (next_readback + 1) % NumReadbacks;
+        FinishReadback(readback, layout);
+
         glBindFramebuffer(GL_READ_FRAMEBUFFER, frame->present.handle);
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, pbos[current_pbo].handle);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pbo.handle);
         glReadPixels(0, 0, layout.width, layout.height, GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, 0);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        readback.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
 
         // Insert fence for the main thread to block on
         frame->present_fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
         glFlush();
+    }
 
-        auto video_dumper = system.GetVideoDumper();
-        if (video_dumper) {
-            // Bind the previous PBO and read the pixels
-            glBindBuffer(GL_PIXEL_PACK_BUFFER, pbos[next_pbo].handle);
-            GLubyte* pixels =
-                static_cast<GLubyte*>(glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY));
-            VideoDumper::VideoFrame frame_data{layout.width, layout.height, pixels};
-            video_dumper->AddVideoFrame(std::move(frame_data));
-            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
-            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
-        }
-
-        current_pbo = (current_pbo + 1) % 2;
-        next_pbo = (current_pbo + 1) % 2;
+    // Send the frames still being downloaded, oldest first
+    for (std::size_t i = 0; i < NumReadbacks; i++) {
+        FinishReadback(readbacks[(next_readback + i) % NumReadbacks], layout);
     }
 
     CleanupOpenGLObjects();
 }
 
+void FrameDumperOpenGL::FinishReadback(Readback& readback, const Layout::FramebufferLayout& layout) {
+    if (!readback.fence) {
+        return;
+    }
+    glClientWaitSync(readback.fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+    glDeleteSync(readback.fence);
+    readback.fence = nullptr;
+
+    auto video_dumper = system.GetVideoDumper();
+    if (!video_dumper) {
+        return;
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pbo.handle);
+    const auto* pixels = static_cast<const u8*>(glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY));
+    if (pixels) {
+        auto frame_data = video_dumper->AcquireVideoFrame(layout.width, layout.height);
+        std::memcpy(frame_data.data.data(), pixels, frame_data.data.size());
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        video_dumper->AddVideoFrame(std::move(frame_data));
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
 void FrameDumperOpenGL::InitializeOpenGLObjects() {
     const auto& layout = GetLayout();
-    for (auto& buffer : pbos) {
-        buffer.Create();
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer.handle);
+    for (auto& readback : readbacks) {
+        readback.pbo.Create();
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pbo.handle);
         glBufferData(GL_PIXEL_PACK_BUFFER, layout.width * layout.height * 4, nullptr,
                      GL_STREAM_READ);
         glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
@@ -97,8 +122,12 @@ void FrameDumperOpenGL::InitializeOpenGLObjects() {
 }
 
 void FrameDumperOpenGL::CleanupOpenGLObjects() {
-    for (auto& buffer : pbos) {
-        buffer.Release();
+    for (auto& readback : readbacks) {
+        if (readback.fence) {
+            glDeleteSync(readback.fence);
+            readback.fence = nullptr;
+        }
+        readback.pbo.Release();
     }
 }
 
@@ -28,7 +28,8 @@ class RendererOpenGL;
 /**
  * This is the 'presentation' part in frame dumping.
  * Processes frames/textures sent to its mailbox, downloads the pixels and sends the data
- * to the video encoding backend.
+ * to the video encoding backend. Downloads are asynchronous, a frame is only mapped once a few
+ * newer frames were queued after it so that the GPU finished copying it.
  */
 class FrameDumperOpenGL {
 public:
@@ -47,15 +48,25 @@ private:
     void CleanupOpenGLObjects();
     void PresentLoop(std::stop_token stop_token);
 
+    struct Readback {
+        OGLBuffer pbo;
+        GLsync fence{}; ///< Signaled when the pixels are in the PBO, null if no frame is pending
+    };
+
+    /// Sends the frame of a readback to the video dumper once the GPU copied it.
+    void FinishReadback(Readback& readback, const Layout::FramebufferLayout& layout);
+
 private:
+    /// Number of frames downloaded at the same time
+    static constexpr std::size_t NumReadbacks = 3;
+
     Core::System& system;
     std::unique_ptr<Frontend::GraphicsContext> context;
     std::jthread present_thread;
 
-    // PBOs used to dump frames faster
-    std::array<OGLBuffer, 2> pbos;
-    GLuint current_pbo = 1;
-    GLuint next_pbo = 0;
+    // PBOs used to dump frames asynchronously
+    std::array<Readback, NumReadbacks> readbacks;
+    std::size_t next_readback = 0;
 };
 
 } // namespace OpenGL
@@ -8,12 +8,17 @@
 #include <glad/glad.h>
 #include "common/assert.h"
 #include "common/logging/log.h"
+#include "common/microprofile.h"
 #include "video_core/renderer_opengl/gl_shader_util.h"
 #include "video_core/renderer_opengl/gl_vars.h"
 
 namespace OpenGL {
 
+MICROPROFILE_DEFINE(OpenGL_ShaderCompile, "OpenGL", "Shader Compile", MP_RGB(255, 64, 64));
+MICROPROFILE_DEFINE(OpenGL_ProgramLink, "OpenGL", "Program Link", MP_RGB(255, 96, 64));
+
 GLuint LoadShader(std::string_view source, GLenum type) {
+    MICROPROFILE_SCOPE(OpenGL_ShaderCompile);
     std::string preamble;
     if (GLES) {
         preamble = R"(#version 320 es
@@ -73,6 +78,7 @@ GLuint LoadShader(std::string_view source, GLenum type) {
 }
 
 GLuint LoadProgram(bool separable_program, std::span<const GLuint> shaders) {
+    MICROPROFILE_SCOPE(OpenGL_ProgramLink);
     // Link the program
     LOG_DEBUG(Render_OpenGL, "Linking program...");
 
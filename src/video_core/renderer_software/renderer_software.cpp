@@ -18,6 +18,11 @@ RendererSoftware::RendererSoftware(Core::System& system, Pica::PicaCore& pica_,
 RendererSoftware::~RendererSoftware() = default;
 
 void RendererSoftware::SwapBuffers() {
+    if (!ShouldPresent()) {
+        EndFrame();
+        return;
+    }
+
     PrepareRenderTarget();
     EndFrame();
 }
@@ -831,6 +831,14 @@ void RendererVulkan::DrawScreens(Frame* frame, const Layout::FramebufferLayout&
 }
 
 void RendererVulkan::SwapBuffers() {
+    if (!ShouldPresent()) {
+        // Submit the work of the frame that presenting would otherwise have submitted
+        scheduler.Flush();
+        rasterizer.TickFrame();
+        EndFrame();
+        return;
+    }
+
     const Layout::FramebufferLayout& layout = render_window.GetFramebufferLayout();
     PrepareRendertarget();
     RenderScreenshot();
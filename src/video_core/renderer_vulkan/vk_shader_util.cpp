@@ -8,12 +8,15 @@
 #include "common/assert.h"
 #include "common/literals.h"
 #include "common/logging/log.h"
+#include "common/microprofile.h"
 #include "video_core/renderer_vulkan/vk_shader_util.h"
 
 namespace Vulkan {
 
 using namespace Common::Literals;
 
+MICROPROFILE_DEFINE(Vulkan_ShaderCompile, "Vulkan", "Shader Compile", MP_RGB(192, 64, 64));
+
 namespace {
 constexpr TBuiltInResource DefaultTBuiltInResource = {
     .maxLights = 32,
@@ -159,6 +162,7 @@ bool InitializeCompiler() {
 } // Anonymous namespace
 
 vk::ShaderModule Compile(std::string_view code, vk::ShaderStageFlagBits stage, vk::Device device) {
+    MICROPROFILE_SCOPE(Vulkan_ShaderCompile);
     if (!InitializeCompiler()) {
         return {};
     }
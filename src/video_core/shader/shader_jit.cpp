@@ -8,6 +8,7 @@
 #include "common/assert.h"
 #include "common/hash.h"
 #include "common/microprofile.h"
+#include "common/perf_counters.h"
 #include "video_core/shader/shader.h"
 #include "video_core/shader/shader_jit.h"
 #if CITRA_ARCH(arm64)
@@ -19,6 +20,8 @@
 
 namespace Pica::Shader {
 
+MICROPROFILE_DEFINE(GPU_ShaderCompile, "GPU", "Shader Compile", MP_RGB(100, 100, 240));
+
 JitEngine::JitEngine() = default;
 JitEngine::~JitEngine() = default;
 
@@ -34,6 +37,8 @@ void JitEngine::SetupBatch(ShaderSetup& setup, u32 entry_point) {
     if (iter != cache.end()) {
         setup.cached_shader = iter->second.get();
     } else {
+        MICROPROFILE_SCOPE(GPU_ShaderCompile);
+        Common::PerfCounters::Add(Common::PerfCounters::Counter::ShaderCompiles);
         auto shader = std::make_unique<JitShader>();
         shader->Compile(&setup.program_code, &setup.swizzle_data);
         setup.cached_shader = shader.get();